@@ -0,0 +1,86 @@
+/**
+ * APIC Interrupt Controller Implementation
+ * NansOS Driver System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "apic.h"
+#include "../pic/pic.h"
+#include "../../kernel/acpi.h"
+#include "../../kernel/klog.h"
+#include "../../kernel/asm_utils.h"
+#include "../../kernel/irq.h"
+
+static int active = 0;
+
+static void apic_chip_mask(uint8_t irq) {
+    int gsi = ioapic_isa_to_gsi(irq);
+    if (gsi >= 0) {
+        ioapic_mask(gsi);
+    }
+}
+
+static void apic_chip_unmask(uint8_t irq) {
+    int gsi = ioapic_isa_to_gsi(irq);
+    if (gsi >= 0) {
+        ioapic_unmask(gsi);
+    }
+}
+
+/* The spurious vector is never put in service */
+static int apic_chip_spurious(uint64_t vector) {
+    return vector == LAPIC_SPURIOUS_VECTOR;
+}
+
+/*
+ * An EOI clears the highest in-service bit, whatever vector it is sent
+ * for. A software interrupt (int N) sets none, so acknowledging it would
+ * retire a hardware vector it preempted; only EOI what is in service.
+ */
+static void apic_chip_eoi(uint64_t vector) {
+    if (vector >= IRQ_BASE_VECTOR && lapic_in_service((uint8_t)vector)) {
+        lapic_eoi();
+    }
+}
+
+static const struct IRQChip apic_irq_chip = {
+    .name = "APIC",
+    .mask = apic_chip_mask,
+    .unmask = apic_chip_unmask,
+    .spurious = apic_chip_spurious,
+    .eoi = apic_chip_eoi,
+};
+
+int apic_init(void) {
+    const struct ACPIMADT* madt = (const struct ACPIMADT*)acpi_find_table("APIC");
+    if (!madt) {
+        klog_info("[APIC] No MADT; the 8259 PIC stays in charge");
+        return -1;
+    }
+
+    uint64_t flags = asm_irq_save();
+    if (lapic_init(madt) != 0) {
+        asm_irq_restore(flags);
+        klog_warn("[APIC] No local APIC; the 8259 PIC stays in charge");
+        return -1;
+    }
+
+    /* Without an I/O APIC the PIC keeps its virtual wire through LINT0 */
+    if (ioapic_init(madt, lapic_id()) != 0) {
+        lapic_write(LAPIC_REG_LVT_LINT0, LAPIC_LVT_EXTINT);
+        asm_irq_restore(flags);
+        klog_warn("[APIC] No I/O APIC; the 8259 PIC stays in charge");
+        return -1;
+    }
+
+    /* pic_init() left the 8259s remapped, so a stray one cannot alias an exception */
+    pic_disable();
+    irq_set_chip(&apic_irq_chip);
+    active = 1;
+    asm_irq_restore(flags);
+    return 0;
+}
+
+int apic_active(void) {
+    return active;
+}
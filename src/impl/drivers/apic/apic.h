@@ -0,0 +1,21 @@
+/**
+ * APIC Interrupt Controller
+ * NansOS Driver System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+#include "lapic.h"
+#include "ioapic.h"
+
+/*
+ * Bring up the local APIC and the I/O APICs described by the ACPI MADT,
+ * mask the 8259 pair and make the APIC the dispatcher's interrupt chip.
+ * Call after acpi_init() and pic_init(), with interrupts off. Returns -1
+ * without a MADT, local APIC or I/O APIC; the PIC stays in charge.
+ */
+int apic_init(void);
+
+/* The APIC delivers device interrupts instead of the PIC */
+int apic_active(void);
@@ -0,0 +1,203 @@
+/**
+ * I/O APIC Implementation
+ * NansOS Driver System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "ioapic.h"
+#include "../../kernel/mmu.h"
+#include "../../kernel/klog.h"
+#include "../../kernel/asm_utils.h"
+#include "../../kernel/irq.h"
+
+#define IOAPIC_MMIO_SIZE    0x20
+#define ISA_NO_GSI          0xFFFFFFFF
+
+struct IOAPIC {
+    volatile uint32_t* base;
+    uint32_t gsi_base;
+    uint32_t pins;
+    uint32_t low[IOAPIC_MAX_PINS];      /* Redirection entry low halves as written */
+};
+
+static struct IOAPIC ioapics[IOAPIC_MAX];
+static uint32_t ioapic_count = 0;
+static uint32_t destination = 0;
+
+/* ISA IRQ wiring after interrupt source overrides */
+static uint32_t isa_gsi[IRQ_LEGACY_COUNT];
+static uint32_t isa_flags[IRQ_LEGACY_COUNT];
+
+/* The select/window pair must not be split by an interrupt */
+static uint32_t ioapic_read(struct IOAPIC* io, uint32_t reg) {
+    uint64_t flags = asm_irq_save();
+    io->base[IOAPIC_REGSEL / 4] = reg;
+    uint32_t value = io->base[IOAPIC_WINDOW / 4];
+    asm_irq_restore(flags);
+    return value;
+}
+
+static void ioapic_write(struct IOAPIC* io, uint32_t reg, uint32_t value) {
+    uint64_t flags = asm_irq_save();
+    io->base[IOAPIC_REGSEL / 4] = reg;
+    io->base[IOAPIC_WINDOW / 4] = value;
+    asm_irq_restore(flags);
+}
+
+static struct IOAPIC* ioapic_for_gsi(uint32_t gsi, uint32_t* pin) {
+    for (uint32_t i = 0; i < ioapic_count; i++) {
+        struct IOAPIC* io = &ioapics[i];
+        if (gsi >= io->gsi_base && gsi < io->gsi_base + io->pins) {
+            *pin = gsi - io->gsi_base;
+            return io;
+        }
+    }
+    return NULL;
+}
+
+static void ioapic_add(const struct ACPIMADTIOAPIC* entry) {
+    if (ioapic_count == IOAPIC_MAX) {
+        klog_warn("[IOAPIC] Ignoring I/O APIC %u beyond the first %u", entry->id, IOAPIC_MAX);
+        return;
+    }
+
+    struct IOAPIC* io = &ioapics[ioapic_count];
+    io->base = mmu_map_mmio(entry->address, IOAPIC_MMIO_SIZE);
+    if (!io->base) {
+        klog_err("[IOAPIC] Cannot map registers at 0x%x", entry->address);
+        return;
+    }
+    io->gsi_base = entry->gsi_base;
+    io->pins = IOAPIC_VERSION_MAX_REDIR(ioapic_read(io, IOAPIC_REG_VERSION)) + 1;
+    if (io->pins > IOAPIC_MAX_PINS) {
+        klog_warn("[IOAPIC] Using %u of %u pins", IOAPIC_MAX_PINS, io->pins);
+        io->pins = IOAPIC_MAX_PINS;
+    }
+
+    for (uint32_t pin = 0; pin < io->pins; pin++) {
+        io->low[pin] = IOAPIC_REDIR_MASKED;
+        ioapic_write(io, IOAPIC_REG_REDIR(pin), io->low[pin]);
+    }
+    ioapic_count++;
+
+    klog_info("[IOAPIC] ID %u at 0x%x, GSIs %u-%u", entry->id, entry->address,
+              io->gsi_base, io->gsi_base + io->pins - 1);
+}
+
+/* Interrupt source override for an ISA IRQ */
+static void isa_override(const struct ACPIMADTOverride* entry) {
+    if (entry->bus != 0 || entry->source >= IRQ_LEGACY_COUNT) {
+        return;
+    }
+
+    /* An IRQ identity-mapped onto the target GSI loses it (IRQ2 to IRQ0's usually) */
+    for (uint8_t irq = 0; irq < IRQ_LEGACY_COUNT; irq++) {
+        if (irq != entry->source && isa_gsi[irq] == entry->gsi) {
+            isa_gsi[irq] = ISA_NO_GSI;
+        }
+    }
+
+    isa_gsi[entry->source] = entry->gsi;
+    isa_flags[entry->source] = 0;
+    if ((entry->flags & ACPI_MADT_TRIGGER_MASK) == ACPI_MADT_TRIGGER_LEVEL) {
+        isa_flags[entry->source] |= IOAPIC_TRIGGER_LEVEL;
+    }
+    if ((entry->flags & ACPI_MADT_POLARITY_MASK) == ACPI_MADT_POLARITY_LOW) {
+        isa_flags[entry->source] |= IOAPIC_ACTIVE_LOW;
+    }
+}
+
+int ioapic_init(const struct ACPIMADT* madt, uint32_t dest_apic_id) {
+    const struct ACPIMADTEntry* entry = NULL;
+
+    destination = dest_apic_id;
+    while ((entry = acpi_madt_next(madt, entry))) {
+        if (entry->type == ACPI_MADT_IOAPIC) {
+            ioapic_add((const struct ACPIMADTIOAPIC*)entry);
+        }
+    }
+    if (ioapic_count == 0) {
+        return -1;
+    }
+
+    /* ISA defaults are identity-mapped, edge-triggered and active high */
+    for (uint8_t irq = 0; irq < IRQ_LEGACY_COUNT; irq++) {
+        isa_gsi[irq] = irq;
+        isa_flags[irq] = 0;
+    }
+    entry = NULL;
+    while ((entry = acpi_madt_next(madt, entry))) {
+        if (entry->type == ACPI_MADT_OVERRIDE) {
+            isa_override((const struct ACPIMADTOverride*)entry);
+        }
+    }
+
+    for (uint8_t irq = 0; irq < IRQ_LEGACY_COUNT; irq++) {
+        if (isa_gsi[irq] != ISA_NO_GSI) {
+            ioapic_route(isa_gsi[irq], IRQ_VECTOR(irq), isa_flags[irq]);
+        }
+    }
+    return 0;
+}
+
+int ioapic_isa_to_gsi(uint8_t irq) {
+    if (irq >= IRQ_LEGACY_COUNT || ioapic_count == 0 || isa_gsi[irq] == ISA_NO_GSI) {
+        return -1;
+    }
+    return (int)isa_gsi[irq];
+}
+
+int ioapic_route(uint32_t gsi, uint8_t vector, uint32_t flags) {
+    uint32_t pin;
+    struct IOAPIC* io = ioapic_for_gsi(gsi, &pin);
+    if (!io) {
+        return -1;
+    }
+
+    uint32_t low = IOAPIC_REDIR_MASKED | vector;
+    if (flags & IOAPIC_TRIGGER_LEVEL) {
+        low |= IOAPIC_REDIR_LEVEL;
+    }
+    if (flags & IOAPIC_ACTIVE_LOW) {
+        low |= IOAPIC_REDIR_ACTIVE_LOW;
+    }
+
+    /* Masked while the halves disagree */
+    io->low[pin] = low;
+    ioapic_write(io, IOAPIC_REG_REDIR(pin), low);
+    ioapic_write(io, IOAPIC_REG_REDIR(pin) + 1, destination << (IOAPIC_REDIR_DEST_SHIFT - 32));
+    return 0;
+}
+
+static int ioapic_set_masked(uint32_t gsi, int masked) {
+    uint32_t pin;
+    struct IOAPIC* io = ioapic_for_gsi(gsi, &pin);
+    if (!io) {
+        return -1;
+    }
+
+    uint64_t flags = asm_irq_save();
+    io->low[pin] = masked ? (io->low[pin] | IOAPIC_REDIR_MASKED) : (io->low[pin] & ~IOAPIC_REDIR_MASKED);
+    ioapic_write(io, IOAPIC_REG_REDIR(pin), io->low[pin]);
+    asm_irq_restore(flags);
+    return 0;
+}
+
+int ioapic_mask(uint32_t gsi) {
+    return ioapic_set_masked(gsi, 1);
+}
+
+int ioapic_unmask(uint32_t gsi) {
+    return ioapic_set_masked(gsi, 0);
+}
+
+uint64_t ioapic_read_entry(uint32_t gsi) {
+    uint32_t pin;
+    struct IOAPIC* io = ioapic_for_gsi(gsi, &pin);
+    if (!io) {
+        return 0;
+    }
+
+    uint64_t high = ioapic_read(io, IOAPIC_REG_REDIR(pin) + 1);
+    return high << 32 | ioapic_read(io, IOAPIC_REG_REDIR(pin));
+}
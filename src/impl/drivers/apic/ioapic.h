@@ -0,0 +1,57 @@
+/**
+ * I/O APIC Driver
+ * NansOS Driver System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+#include "../../kernel/acpi.h"
+
+/* Indirect register window */
+#define IOAPIC_REGSEL           0x00
+#define IOAPIC_WINDOW           0x10
+
+#define IOAPIC_REG_ID           0x00
+#define IOAPIC_REG_VERSION      0x01
+#define IOAPIC_REG_REDIR(pin)   (0x10 + 2 * (pin))      /* Low half; high half follows */
+
+#define IOAPIC_VERSION_MAX_REDIR(v) (((v) >> 16) & 0xFF)
+
+/* Redirection entry, low half */
+#define IOAPIC_REDIR_VECTOR     0xFF
+#define IOAPIC_REDIR_ACTIVE_LOW (1 << 13)
+#define IOAPIC_REDIR_REMOTE_IRR (1 << 14)   /* Level interrupt accepted, awaiting EOI */
+#define IOAPIC_REDIR_LEVEL      (1 << 15)
+#define IOAPIC_REDIR_MASKED     (1 << 16)
+#define IOAPIC_REDIR_DEST_SHIFT 56          /* Physical destination APIC ID */
+
+/* ioapic_route() flags */
+#define IOAPIC_TRIGGER_LEVEL    0x01
+#define IOAPIC_ACTIVE_LOW       0x02
+
+#define IOAPIC_MAX              4
+#define IOAPIC_MAX_PINS         120
+
+/*
+ * Map every I/O APIC in the MADT, mask all pins and route the ISA IRQs,
+ * after interrupt source overrides, to IRQ_VECTOR(irq) on the local APIC
+ * `dest_apic_id`, still masked. Returns -1 if there is none.
+ */
+int ioapic_init(const struct ACPIMADT* madt, uint32_t dest_apic_id);
+
+/* GSI an ISA IRQ is wired to, or -1 if it has none */
+int ioapic_isa_to_gsi(uint8_t irq);
+
+/*
+ * Deliver `gsi` as `vector` to that local APIC with IOAPIC_* trigger and
+ * polarity `flags`. The pin is left masked. Returns -1 for an unknown GSI.
+ */
+int ioapic_route(uint32_t gsi, uint8_t vector, uint32_t flags);
+
+/* One register write each; the entry's low half is cached */
+int ioapic_mask(uint32_t gsi);
+int ioapic_unmask(uint32_t gsi);
+
+/* Whole redirection entry, or 0 for an unknown GSI */
+uint64_t ioapic_read_entry(uint32_t gsi);
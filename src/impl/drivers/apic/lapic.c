@@ -0,0 +1,153 @@
+/**
+ * Local APIC Implementation
+ * NansOS Driver System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "lapic.h"
+#include "../../kernel/mmu.h"
+#include "../../kernel/klog.h"
+#include "../../kernel/asm_utils.h"
+#include "../../kernel/sysinfo.h"
+#include "../../kernel/irq.h"
+
+#define LAPIC_MMIO_SIZE     4096
+
+static volatile uint8_t* lapic_base = NULL;
+static int x2apic = 0;
+static int enabled = 0;
+
+uint32_t lapic_read(uint32_t reg) {
+    if (x2apic) {
+        return (uint32_t)asm_rdmsr(MSR_X2APIC_BASE + (reg >> 4));
+    }
+    return *(volatile uint32_t*)(lapic_base + reg);
+}
+
+void lapic_write(uint32_t reg, uint32_t value) {
+    if (x2apic) {
+        asm_wrmsr(MSR_X2APIC_BASE + (reg >> 4), value);
+    } else {
+        *(volatile uint32_t*)(lapic_base + reg) = value;
+    }
+}
+
+static void lapic_error_irq(struct InterruptFrame* frame, void* ctx) {
+    (void)frame;
+    (void)ctx;
+
+    /* The register latches on a write */
+    lapic_write(LAPIC_REG_ESR, 0);
+    klog_warn_ratelimited("[LAPIC] Error status 0x%x", lapic_read(LAPIC_REG_ESR));
+}
+
+/* NMI wiring from the MADT; without an entry LINT1 is assumed */
+static void lapic_setup_nmi(const struct ACPIMADT* madt) {
+    const struct ACPIMADTEntry* entry = NULL;
+    int found = 0;
+
+    while ((entry = acpi_madt_next(madt, entry))) {
+        if (entry->type != ACPI_MADT_LAPIC_NMI) {
+            continue;
+        }
+
+        /* Processor IDs are not tracked yet; only the boot CPU runs */
+        const struct ACPIMADTLAPICNMI* nmi = (const struct ACPIMADTLAPICNMI*)entry;
+        uint32_t lvt = LAPIC_LVT_NMI;
+        if ((nmi->flags & ACPI_MADT_POLARITY_MASK) == ACPI_MADT_POLARITY_LOW) {
+            lvt |= LAPIC_LVT_ACTIVE_LOW;
+        }
+        lapic_write(nmi->lint ? LAPIC_REG_LVT_LINT1 : LAPIC_REG_LVT_LINT0, lvt);
+        found = 1;
+    }
+    if (!found) {
+        lapic_write(LAPIC_REG_LVT_LINT1, LAPIC_LVT_NMI);
+    }
+}
+
+int lapic_init(const struct ACPIMADT* madt) {
+    if (!sysinfo_has_feature(CPU_FEATURE_APIC)) {
+        return -1;
+    }
+
+    uint64_t base = asm_rdmsr(MSR_APIC_BASE);
+    uint64_t address = madt->lapic_address;
+    const struct ACPIMADTEntry* entry = NULL;
+
+    while ((entry = acpi_madt_next(madt, entry))) {
+        if (entry->type == ACPI_MADT_LAPIC_ADDRESS) {
+            address = ((const struct ACPIMADTLAPICAddress*)entry)->address;
+        }
+    }
+
+    /* x2APIC has to be entered from xAPIC mode: enable first, then extend */
+    base |= MSR_APIC_BASE_ENABLE;
+    asm_wrmsr(MSR_APIC_BASE, base);
+    if (sysinfo_has_feature(CPU_FEATURE_X2APIC)) {
+        asm_wrmsr(MSR_APIC_BASE, base | MSR_APIC_BASE_X2APIC);
+        x2apic = 1;
+    } else {
+        if (!address) {
+            address = base & MSR_APIC_BASE_ADDRESS;
+        }
+        lapic_base = mmu_map_mmio(address, LAPIC_MMIO_SIZE);
+        if (!lapic_base) {
+            klog_err("[LAPIC] Cannot map registers at 0x%llx", (unsigned long long)address);
+            return -1;
+        }
+    }
+
+    uint32_t version = lapic_read(LAPIC_REG_VERSION);
+    uint32_t max_lvt = LAPIC_VERSION_MAX_LVT(version);
+
+    /* Nothing local fires until a driver asks for it */
+    lapic_write(LAPIC_REG_LVT_TIMER, LAPIC_LVT_MASKED);
+    if (max_lvt >= 4) {
+        lapic_write(LAPIC_REG_LVT_PERF, LAPIC_LVT_MASKED);
+    }
+    if (max_lvt >= 5) {
+        lapic_write(LAPIC_REG_LVT_THERMAL, LAPIC_LVT_MASKED);
+    }
+    lapic_write(LAPIC_REG_LVT_LINT0, LAPIC_LVT_MASKED);
+    lapic_write(LAPIC_REG_LVT_LINT1, LAPIC_LVT_MASKED);
+    lapic_setup_nmi(madt);
+
+    irq_register(LAPIC_ERROR_VECTOR, lapic_error_irq, NULL);
+    lapic_write(LAPIC_REG_LVT_ERROR, LAPIC_ERROR_VECTOR);
+    lapic_write(LAPIC_REG_ESR, 0);
+    lapic_write(LAPIC_REG_ESR, 0);
+
+    lapic_set_task_priority(0);
+    lapic_write(LAPIC_REG_SVR, LAPIC_SVR_ENABLE | LAPIC_SPURIOUS_VECTOR);
+    lapic_eoi();
+    enabled = 1;
+
+    klog_info("[LAPIC] ID %u, version 0x%x, %u LVT entries, %s", lapic_id(), version & 0xFF,
+              max_lvt + 1, x2apic ? "x2APIC" : "xAPIC");
+    return 0;
+}
+
+int lapic_available(void) {
+    return enabled;
+}
+
+int lapic_is_x2apic(void) {
+    return x2apic;
+}
+
+uint32_t lapic_id(void) {
+    uint32_t id = lapic_read(LAPIC_REG_ID);
+    return x2apic ? id : id >> 24;
+}
+
+void lapic_eoi(void) {
+    lapic_write(LAPIC_REG_EOI, 0);
+}
+
+void lapic_set_task_priority(uint8_t class) {
+    lapic_write(LAPIC_REG_TPR, (uint32_t)class << 4);
+}
+
+int lapic_in_service(uint8_t vector) {
+    return (lapic_read(LAPIC_REG_ISR(vector >> 5)) >> (vector & 31)) & 1;
+}
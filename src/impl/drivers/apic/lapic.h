@@ -0,0 +1,66 @@
+/**
+ * Local APIC Driver
+ * NansOS Driver System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+#include "../../kernel/acpi.h"
+
+/* Register offsets from the xAPIC MMIO base; x2APIC MSRs are 0x800 + offset / 16 */
+#define LAPIC_REG_ID            0x020
+#define LAPIC_REG_VERSION       0x030
+#define LAPIC_REG_TPR           0x080   /* Task priority */
+#define LAPIC_REG_EOI           0x0B0
+#define LAPIC_REG_SVR           0x0F0   /* Spurious interrupt vector */
+#define LAPIC_REG_ISR(n)        (0x100 + 0x10 * (n))    /* In service, 32 vectors each */
+#define LAPIC_REG_ESR           0x280   /* Error status */
+#define LAPIC_REG_LVT_TIMER     0x320
+#define LAPIC_REG_LVT_THERMAL   0x330
+#define LAPIC_REG_LVT_PERF      0x340
+#define LAPIC_REG_LVT_LINT0     0x350
+#define LAPIC_REG_LVT_LINT1     0x360
+#define LAPIC_REG_LVT_ERROR     0x370
+
+#define LAPIC_VERSION_MAX_LVT(v) (((v) >> 16) & 0xFF)
+#define LAPIC_SVR_ENABLE        (1 << 8)
+
+/* Local vector table entries */
+#define LAPIC_LVT_NMI           (4 << 8)    /* Delivery modes */
+#define LAPIC_LVT_EXTINT        (7 << 8)
+#define LAPIC_LVT_ACTIVE_LOW    (1 << 13)
+#define LAPIC_LVT_LEVEL         (1 << 15)
+#define LAPIC_LVT_MASKED        (1 << 16)
+
+#define MSR_APIC_BASE           0x1B
+#define MSR_APIC_BASE_X2APIC    (1 << 10)
+#define MSR_APIC_BASE_ENABLE    (1 << 11)
+#define MSR_APIC_BASE_ADDRESS   0xFFFFFFFFFF000ull
+#define MSR_X2APIC_BASE         0x800
+
+/* Fixed local vectors, in the highest priority class */
+#define LAPIC_ERROR_VECTOR      0xFE
+#define LAPIC_SPURIOUS_VECTOR   0xFF    /* Never in service, so never acknowledged */
+
+/*
+ * Enable this CPU's local APIC, in x2APIC mode when the CPU supports it.
+ * LINT0 (the 8259's virtual wire) is masked and the MADT's NMI wiring is
+ * applied. Returns -1 if there is no local APIC.
+ */
+int lapic_init(const struct ACPIMADT* madt);
+
+int lapic_available(void);
+int lapic_is_x2apic(void);
+uint32_t lapic_id(void);
+
+uint32_t lapic_read(uint32_t reg);
+void lapic_write(uint32_t reg, uint32_t value);
+
+/* A single MSR or MMIO write */
+void lapic_eoi(void);
+
+/* Hold off vectors of priority class `class` and below; 0 accepts everything */
+void lapic_set_task_priority(uint8_t class);
+
+int lapic_in_service(uint8_t vector);
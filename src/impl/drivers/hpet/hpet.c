@@ -0,0 +1,215 @@
+/**
+ * High Precision Event Timer (HPET) Implementation
+ * NansOS Driver System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "hpet.h"
+#include "../../kernel/acpi.h"
+#include "../../kernel/mmu.h"
+#include "../../kernel/klog.h"
+#include "../../kernel/asm_utils.h"
+#include "../../kernel/clockevent.h"
+#include "../../kernel/irq.h"
+#include "../../kernel/ktime.h"
+#include "../apic/apic.h"
+
+#define HPET_MMIO_SIZE      1024
+#define FSEC_PER_SEC        1000000000000000ull
+
+/* Comparator writes closer than this to the counter may be missed */
+#define HPET_MIN_DELTA_NS   (5 * NSEC_PER_USEC)
+
+struct ACPIHPETTable {
+    struct ACPITableHeader header;
+    uint32_t event_timer_block_id;
+    struct ACPIGenericAddress address;
+    uint8_t hpet_number;
+    uint16_t min_tick;
+    uint8_t page_protection;
+} __attribute__((packed));
+
+static volatile uint8_t* hpet_base = NULL;
+static uint64_t period_fs = 0;
+static uint64_t frequency = 0;
+static uint32_t timer_count = 0;
+static int counter_64 = 0;
+static int legacy_routed = 0;
+
+static void hpet_ce_set_periodic(struct ClockEventDevice* dev, uint32_t hz);
+static void hpet_ce_set_next_event(struct ClockEventDevice* dev, uint64_t delta_ns);
+
+static struct ClockEventDevice hpet_clockevent = {
+    .name = "hpet",
+    .features = CLOCK_EVT_FEAT_ONESHOT,
+    .rating = 150,
+    .min_delta_ns = HPET_MIN_DELTA_NS,
+    .set_periodic = hpet_ce_set_periodic,
+    .set_next_event = hpet_ce_set_next_event,
+};
+
+static inline uint64_t hpet_read(uint32_t reg) {
+    return *(volatile uint64_t*)(hpet_base + reg);
+}
+
+static inline void hpet_write(uint32_t reg, uint64_t value) {
+    *(volatile uint64_t*)(hpet_base + reg) = value;
+}
+
+/* Counter ticks between two readings, allowing for a 32-bit wrap */
+static inline uint64_t counter_delta(uint64_t later, uint64_t earlier) {
+    uint64_t delta = later - earlier;
+    return counter_64 ? delta : (uint32_t)delta;
+}
+
+/* Split at whole seconds so neither product overflows */
+static uint64_t ns_to_ticks(uint64_t ns) {
+    return ns / NSEC_PER_SEC * frequency + ns % NSEC_PER_SEC * frequency / NSEC_PER_SEC;
+}
+
+static uint64_t ticks_to_ns(uint64_t ticks) {
+    return ticks / frequency * NSEC_PER_SEC + ticks % frequency * NSEC_PER_SEC / frequency;
+}
+
+static void hpet_ce_set_periodic(struct ClockEventDevice* dev, uint32_t hz) {
+    (void)dev;
+    uint64_t period = frequency / hz;
+    uint64_t config = hpet_read(HPET_REG_TIMER_CONFIG(0));
+
+    config &= ~HPET_TIMER_LEVEL;
+    config |= HPET_TIMER_ENABLE | HPET_TIMER_PERIODIC | HPET_TIMER_SET_VALUE;
+    hpet_write(HPET_REG_TIMER_CONFIG(0), config);
+
+    /* With SET_VALUE the first write is the next match, the second the period */
+    hpet_write(HPET_REG_TIMER_COMPARATOR(0), hpet_read(HPET_REG_COUNTER) + period);
+    hpet_write(HPET_REG_TIMER_COMPARATOR(0), period);
+}
+
+static void hpet_ce_set_next_event(struct ClockEventDevice* dev, uint64_t delta_ns) {
+    (void)dev;
+    uint64_t ticks = ns_to_ticks(delta_ns < HPET_MIN_DELTA_NS ? HPET_MIN_DELTA_NS : delta_ns);
+    uint64_t config = hpet_read(HPET_REG_TIMER_CONFIG(0));
+
+    config &= ~(HPET_TIMER_LEVEL | HPET_TIMER_PERIODIC);
+    config |= HPET_TIMER_ENABLE;
+    hpet_write(HPET_REG_TIMER_CONFIG(0), config);
+
+    /* The match is on equality; if the counter already passed it, try further out */
+    for (;;) {
+        uint64_t target = hpet_read(HPET_REG_COUNTER) + ticks;
+        hpet_write(HPET_REG_TIMER_COMPARATOR(0), target);
+        if (counter_delta(target, hpet_read(HPET_REG_COUNTER)) <= ticks) {
+            break;
+        }
+        ticks *= 2;
+    }
+}
+
+static void hpet_irq(struct InterruptFrame* frame, void* ctx) {
+    (void)frame;
+    (void)ctx;
+    clockevents_handle(&hpet_clockevent);
+}
+
+int hpet_init(void) {
+    const struct ACPIHPETTable* table = (const struct ACPIHPETTable*)acpi_find_table("HPET");
+    if (!table) {
+        klog_info("[HPET] Not present; the PIT stays the timer");
+        return -1;
+    }
+    if (table->address.space_id != ACPI_SPACE_MEMORY) {
+        klog_warn("[HPET] Registers not memory mapped");
+        return -1;
+    }
+
+    hpet_base = mmu_map_mmio(table->address.address, HPET_MMIO_SIZE);
+    uint64_t caps = hpet_read(HPET_REG_CAPABILITIES);
+    period_fs = caps >> 32;
+    if (period_fs == 0 || period_fs > HPET_MAX_PERIOD_FS) {
+        klog_err("[HPET] Invalid counter period %llu fs", (unsigned long long)period_fs);
+        hpet_base = NULL;
+        return -1;
+    }
+    frequency = FSEC_PER_SEC / period_fs;
+    timer_count = HPET_CAP_TIMER_COUNT(caps);
+    counter_64 = (caps & HPET_CAP_COUNTER_64) != 0;
+
+    /* Quiesce every comparator before the counter runs */
+    for (uint32_t i = 0; i < timer_count; i++) {
+        uint64_t config = hpet_read(HPET_REG_TIMER_CONFIG(i));
+        hpet_write(HPET_REG_TIMER_CONFIG(i), config & ~(HPET_TIMER_ENABLE | HPET_TIMER_PERIODIC));
+    }
+    hpet_write(HPET_REG_CONFIG, hpet_read(HPET_REG_CONFIG) | HPET_CONFIG_ENABLE);
+
+    klog_info("[HPET] %u comparators, %llu.%03llu MHz %d-bit counter at 0x%llx", timer_count,
+              (unsigned long long)(frequency / 1000000), (unsigned long long)(frequency / 1000 % 1000),
+              counter_64 ? 64 : 32, (unsigned long long)table->address.address);
+
+    /*
+     * Legacy replacement routing sends timer 0 to PIC IRQ0 and I/O APIC
+     * pin 2 (and timer 1 to the RTC's IRQ8). Under the I/O APIC that pin
+     * carries IRQ0's vector only when the MADT overrides IRQ0 onto GSI 2,
+     * as PC firmware does; otherwise the PIT keeps the tick.
+     */
+    if (!(caps & HPET_CAP_LEGACY_ROUTE) || !tick_get_hz()) {
+        return 0;
+    }
+    if (apic_active() && ioapic_isa_to_gsi(HPET_LEGACY_IRQ) != HPET_LEGACY_GSI) {
+        klog_info("[HPET] IRQ0 is not on I/O APIC pin %d; the PIT keeps the tick", HPET_LEGACY_GSI);
+        return 0;
+    }
+
+    uint64_t config0 = hpet_read(HPET_REG_TIMER_CONFIG(0));
+    if (config0 & HPET_TIMER_PERIODIC_CAP) {
+        hpet_clockevent.features |= CLOCK_EVT_FEAT_PERIODIC;
+    }
+    uint64_t max_ticks = (config0 & HPET_TIMER_64BIT_CAP) && counter_64 ? 1ull << 40 : 0x7FFFFFFF;
+    hpet_clockevent.max_delta_ns = ticks_to_ns(max_ticks);
+
+    uint64_t flags = asm_irq_save();
+    hpet_write(HPET_REG_CONFIG, hpet_read(HPET_REG_CONFIG) | HPET_CONFIG_LEGACY);
+    legacy_routed = 1;
+    irq_unregister(IRQ_VECTOR(HPET_LEGACY_IRQ));
+    irq_register(IRQ_VECTOR(HPET_LEGACY_IRQ), hpet_irq, NULL);
+    clockevents_register(&hpet_clockevent, tick_get_hz());
+    asm_irq_restore(flags);
+    return 0;
+}
+
+int hpet_available(void) {
+    return hpet_base != NULL;
+}
+
+uint64_t hpet_read_counter(void) {
+    return hpet_base ? hpet_read(HPET_REG_COUNTER) : 0;
+}
+
+int hpet_counter_is_64bit(void) {
+    return counter_64;
+}
+
+uint64_t hpet_get_frequency(void) {
+    return frequency;
+}
+
+uint64_t hpet_calibrate_tsc(uint32_t ms) {
+    if (!hpet_base || ms == 0) {
+        return 0;
+    }
+
+    uint64_t ticks = frequency * ms / 1000;
+    uint64_t start_tsc = asm_rdtsc();
+    uint64_t start = hpet_read(HPET_REG_COUNTER);
+    uint64_t now;
+
+    do {
+        now = hpet_read(HPET_REG_COUNTER);
+    } while (counter_delta(now, start) < ticks);
+    uint64_t end_tsc = asm_rdtsc();
+
+    return (end_tsc - start_tsc) * frequency / counter_delta(now, start);
+}
+
+int hpet_owns_irq0(void) {
+    return legacy_routed;
+}
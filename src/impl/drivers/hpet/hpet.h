@@ -0,0 +1,63 @@
+/**
+ * High Precision Event Timer (HPET) Driver
+ * NansOS Driver System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+
+/* Register offsets from the MMIO base */
+#define HPET_REG_CAPABILITIES       0x000
+#define HPET_REG_CONFIG             0x010
+#define HPET_REG_INT_STATUS         0x020
+#define HPET_REG_COUNTER            0x0F0
+#define HPET_REG_TIMER_CONFIG(n)    (0x100 + 0x20 * (n))
+#define HPET_REG_TIMER_COMPARATOR(n) (0x108 + 0x20 * (n))
+
+/* General capabilities; the counter period in femtoseconds is bits 32-63 */
+#define HPET_CAP_TIMER_COUNT(cap)   ((((cap) >> 8) & 0x1F) + 1)
+#define HPET_CAP_COUNTER_64         (1 << 13)
+#define HPET_CAP_LEGACY_ROUTE       (1 << 15)
+#define HPET_MAX_PERIOD_FS          100000000ull    /* 100 ns, the slowest allowed */
+
+/* General configuration */
+#define HPET_CONFIG_ENABLE          (1 << 0)    /* Main counter runs */
+#define HPET_CONFIG_LEGACY          (1 << 1)    /* Timer 0 drives IRQ0, timer 1 IRQ8 */
+
+/* Timer configuration and capabilities */
+#define HPET_TIMER_LEVEL            (1 << 1)
+#define HPET_TIMER_ENABLE           (1 << 2)
+#define HPET_TIMER_PERIODIC         (1 << 3)
+#define HPET_TIMER_PERIODIC_CAP     (1 << 4)
+#define HPET_TIMER_64BIT_CAP        (1 << 5)
+#define HPET_TIMER_SET_VALUE        (1 << 6)    /* Next comparator write sets the value, not the period */
+#define HPET_TIMER_32BIT_MODE       (1 << 8)
+
+#define HPET_LEGACY_IRQ             0
+#define HPET_LEGACY_GSI             2       /* I/O APIC pin legacy routing drives */
+
+/*
+ * Find the ACPI HPET table, map the registers and start the main counter.
+ * When the HPET can take over IRQ0, timer 0 is registered as a clock
+ * event device rated above the PIT. Call after acpi_init(), apic_init()
+ * and pit_init().
+ * Returns -1 if there is no usable HPET; the PIT stays in charge.
+ */
+int hpet_init(void);
+
+int hpet_available(void);
+
+/* Main counter; only the low 32 bits count on HPETs without a 64-bit counter */
+uint64_t hpet_read_counter(void);
+int hpet_counter_is_64bit(void);
+uint64_t hpet_get_frequency(void);      /* Counter rate in Hz */
+
+/*
+ * Spin for about `ms` milliseconds on the main counter and return the TSC
+ * rate measured over it, or 0 without an HPET. Interrupts stay enabled.
+ */
+uint64_t hpet_calibrate_tsc(uint32_t ms);
+
+/* IRQ0 is routed from HPET timer 0 instead of the PIT */
+int hpet_owns_irq0(void);
@@ -6,11 +6,15 @@
 
 #include "keyboard.h"
 #include "../port_io/port.h"
-#include "../pic/pic.h"
-#include "../serial/serial.h"
+#include "../../kernel/klog.h"
+#include "../../kernel/trace.h"
 #include "../mouse/mouse.h"
+#include "../video/console.h"
 #include "../../kernel/asm_utils.h"
-#include <stdio.h>
+#include "../../kernel/delay.h"
+#include "../../kernel/irq.h"
+#include "../../kernel/kstat.h"
+#include "../../kernel/softirq.h"
 
 /* Keyboard IRQ number */
 #define KEYBOARD_IRQ 1
@@ -20,23 +24,73 @@ static keyboard_scancode_callback_t scancode_callback = 0;
 static keyboard_char_callback_t char_callback = 0;
 static special_key_callback_t special_callback = 0;
 
+static void keyboard_irq(struct InterruptFrame* frame, void* ctx);
+static void keyboard_softirq(void);
+
+/* Filled by the interrupt, drained by the softirq; free-running counters */
+static volatile uint8_t scancode_ring[KEYBOARD_RING_SIZE];
+static volatile uint32_t ring_head = 0;
+static volatile uint32_t ring_tail = 0;
+
+DEFINE_KSTAT_COUNTER(stat_dropped, "kbd.dropped");
+
 /* Keyboard state */
 static struct KeyboardState keyboard_state = {0};
 static struct SpecialKeyEvent special_event = {0};
 
+/* Console hotkeys handled before any callback sees the key */
+static int console_hotkey(const struct SpecialKeyEvent* event) {
+    if (!event->is_pressed) {
+        return 0;
+    }
+
+    /* Alt+F1..F6 selects a virtual console */
+    if (event->state.alt_pressed && event->key_code >= KEY_F1 &&
+        event->key_code < KEY_F1 + CONSOLE_COUNT) {
+        console_switch(event->key_code - KEY_F1);
+        return 1;
+    }
+
+    if (!event->state.shift_pressed) {
+        return 0;
+    }
+
+    switch (event->key_code) {
+        case KEY_PAGEUP:
+            console_scroll(CONSOLE_ROWS - 1);
+            return 1;
+        case KEY_PAGEDOWN:
+            console_scroll(-(CONSOLE_ROWS - 1));
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+int keyboard_wait_write(void) {
+    return poll_until(!(port_byte_in(KEYBOARD_STATUS_PORT) & KEYBOARD_STATUS_INPUT),
+                      KEYBOARD_CTRL_TIMEOUT_US);
+}
+
+int keyboard_wait_read(void) {
+    return poll_until(port_byte_in(KEYBOARD_STATUS_PORT) & KEYBOARD_STATUS_OUTPUT,
+                      KEYBOARD_CTRL_TIMEOUT_US);
+}
+
+int keyboard_expect(uint8_t byte, uint32_t timeout_us) {
+    return poll_until((port_byte_in(KEYBOARD_STATUS_PORT) & KEYBOARD_STATUS_OUTPUT) &&
+                      port_byte_in(KEYBOARD_DATA_PORT) == byte, timeout_us);
+}
+
 void keyboard_init(void) {
-    serial_write_string(COM1_PORT, "[DEBUG] Starting keyboard initialization...\n");
+    klog_debug("[KBD] Starting keyboard initialization...");
     
     /* Disable interrupts during initialization */
     asm_cli();
     
     /* Wait for keyboard controller to be ready */
-    int timeout = 100000;
-    while ((port_byte_in(KEYBOARD_STATUS_PORT) & 2) != 0 && timeout > 0) {
-        timeout--;
-    }
-    if (timeout == 0) {
-        serial_write_string(COM1_PORT, "[KBD] Error: Initial controller timeout\n");
+    if (keyboard_wait_write() != 0) {
+        klog_err("[KBD] Error: Initial controller timeout");
         asm_sti();
         return;
     }
@@ -46,122 +100,101 @@ void keyboard_init(void) {
     port_byte_out(KEYBOARD_COMMAND_PORT, 0xA7);  /* Disable mouse */
     
     /* Flush the output buffer */
-    while ((port_byte_in(KEYBOARD_STATUS_PORT) & 1) != 0) {
+    while ((port_byte_in(KEYBOARD_STATUS_PORT) & KEYBOARD_STATUS_OUTPUT) != 0) {
         port_byte_in(KEYBOARD_DATA_PORT);
     }
     
     /* Read current controller configuration */
     port_byte_out(KEYBOARD_COMMAND_PORT, 0x20);
-    timeout = 100000;
-    while (--timeout > 0) {
-        if (port_byte_in(KEYBOARD_STATUS_PORT) & 1) {
-            uint8_t config = port_byte_in(KEYBOARD_DATA_PORT);
-            
-            /* Enable keyboard interrupt and keyboard interface */
-            config |= 1;       /* Enable IRQ */
-            config &= ~(1 << 4); /* Enable keyboard interface */
-            config &= ~(1 << 6); /* Enable translation */
-            
-            /* Write back configuration */
-            port_byte_out(KEYBOARD_COMMAND_PORT, 0x60);
-            port_byte_out(KEYBOARD_DATA_PORT, config);
-            serial_write_string(COM1_PORT, "[DEBUG] Keyboard controller configured\n");
-            break;
-        }
-    }
-    if (timeout == 0) {
-        serial_write_string(COM1_PORT, "[KBD] Error: Controller configuration failed\n");
+    if (keyboard_wait_read() != 0) {
+        klog_err("[KBD] Error: Controller configuration failed");
         asm_sti();
         return;
     }
+    uint8_t config = port_byte_in(KEYBOARD_DATA_PORT);
+    
+    /* Enable keyboard interrupt and keyboard interface */
+    config |= 1;       /* Enable IRQ */
+    config &= ~(1 << 4); /* Enable keyboard interface */
+    config &= ~(1 << 6); /* Enable translation */
+    
+    /* Write back configuration */
+    keyboard_wait_write();
+    port_byte_out(KEYBOARD_COMMAND_PORT, 0x60);
+    keyboard_wait_write();
+    port_byte_out(KEYBOARD_DATA_PORT, config);
+    klog_info("[KBD] Keyboard controller configured");
     
     /* Re-enable keyboard */
+    keyboard_wait_write();
     port_byte_out(KEYBOARD_COMMAND_PORT, 0xAE);
     
     /* Reset keyboard */
-    port_byte_out(KEYBOARD_DATA_PORT, 0xFF);
-    timeout = 100000;
-    while (--timeout > 0) {
-        if (port_byte_in(KEYBOARD_STATUS_PORT) & 1) {
-            uint8_t response = port_byte_in(KEYBOARD_DATA_PORT);
-            if (response == 0xFA) {
-                serial_write_string(COM1_PORT, "[DEBUG] Keyboard reset acknowledged\n");
-                break;
-            }
-        }
-    }
-    if (timeout == 0) {
-        serial_write_string(COM1_PORT, "[KBD] Error: Keyboard reset failed\n");
+    keyboard_wait_write();
+    port_byte_out(KEYBOARD_DATA_PORT, KEYBOARD_CMD_RESET);
+    if (keyboard_expect(0xFA, KEYBOARD_ACK_TIMEOUT_US) != 0) {
+        klog_err("[KBD] Error: Keyboard reset failed");
         asm_sti();
         return;
     }
+    klog_debug("[KBD] Keyboard reset acknowledged");
     
     /* Wait for self-test completion */
-    timeout = 100000;
-    while (--timeout > 0) {
-        if (port_byte_in(KEYBOARD_STATUS_PORT) & 1) {
-            uint8_t response = port_byte_in(KEYBOARD_DATA_PORT);
-            if (response == 0xAA) {
-                serial_write_string(COM1_PORT, "[DEBUG] Keyboard self-test passed\n");
-                break;
-            }
-        }
-    }
-    if (timeout == 0) {
-        serial_write_string(COM1_PORT, "[KBD] Error: Keyboard self-test failed\n");
+    if (keyboard_expect(0xAA, KEYBOARD_RESET_TIMEOUT_US) != 0) {
+        klog_err("[KBD] Error: Keyboard self-test failed");
         asm_sti();
         return;
     }
+    klog_debug("[KBD] Keyboard self-test passed");
     
     /* Enable keyboard */
-    port_byte_out(KEYBOARD_DATA_PORT, 0xF4);
-    timeout = 100000;
-    while (--timeout > 0) {
-        if (port_byte_in(KEYBOARD_STATUS_PORT) & 1) {
-            uint8_t response = port_byte_in(KEYBOARD_DATA_PORT);
-            if (response == 0xFA) {
-                serial_write_string(COM1_PORT, "[KBD] Keyboard enabled\n");
-                break;
-            }
-        }
-    }
-    if (timeout == 0) {
-        serial_write_string(COM1_PORT, "[KBD] Error: Keyboard enable failed\n");
+    keyboard_wait_write();
+    port_byte_out(KEYBOARD_DATA_PORT, KEYBOARD_CMD_ENABLE);
+    if (keyboard_expect(0xFA, KEYBOARD_ACK_TIMEOUT_US) != 0) {
+        klog_err("[KBD] Error: Keyboard enable failed");
         asm_sti();
         return;
     }
+    klog_info("[KBD] Keyboard enabled");
     
     /* Enable keyboard interrupt */
-    pic_clear_mask(KEYBOARD_IRQ);
-    serial_write_string(COM1_PORT, "[DEBUG] Keyboard interrupt enabled\n");
+    softirq_register(SOFTIRQ_KEYBOARD, keyboard_softirq);
+    irq_register(IRQ_VECTOR(KEYBOARD_IRQ), keyboard_irq, NULL);
+    irq_unmask(KEYBOARD_IRQ);
+    klog_debug("[KBD] Keyboard interrupt enabled");
     
     /* Initialize mouse after keyboard is fully set up */
-    serial_write_string(COM1_PORT, "[DEBUG] Starting mouse initialization...\n");
+    klog_debug("[KBD] Starting mouse initialization...");
     mouse_init();
     
     /* Re-enable interrupts */
     asm_sti();
     
-    serial_write_string(COM1_PORT, "[DEBUG] Keyboard initialization complete\n");
+    klog_info("[KBD] Keyboard initialization complete");
 }
 
-void keyboard_handler(void) {
-    /* Disable interrupts during handler */
-    asm_cli();
+/* Top half: take the byte off the controller and leave decoding to the softirq */
+static void keyboard_irq(struct InterruptFrame* frame, void* ctx) {
+    (void)frame;
+    (void)ctx;
     
     /* Check if there's actually data to read */
-    if (!(port_byte_in(KEYBOARD_STATUS_PORT) & 1)) {
-        pic_send_eoi(KEYBOARD_IRQ);
-        asm_sti();
+    if (!(port_byte_in(KEYBOARD_STATUS_PORT) & KEYBOARD_STATUS_OUTPUT)) {
         return;
     }
     
-    uint8_t scancode = keyboard_read_scan_code();
-    
-    /* Send scancode to serial for debugging */
-    char debug_msg[32];
-    sprintf(debug_msg, "[KBD] Scancode: 0x%02x\n", scancode);
-    serial_write_string(COM1_PORT, debug_msg);
+    uint8_t scancode = port_byte_in(KEYBOARD_DATA_PORT);
+    if (ring_head - ring_tail == KEYBOARD_RING_SIZE) {
+        kstat_inc(stat_dropped);
+        return;
+    }
+    scancode_ring[ring_head & (KEYBOARD_RING_SIZE - 1)] = scancode;
+    ring_head++;
+    softirq_raise(SOFTIRQ_KEYBOARD);
+}
+
+static void keyboard_process(uint8_t scancode) {
+    trace("kbd scancode=%02x", scancode);
     
     /* Update keyboard state */
     update_keyboard_state(scancode, &keyboard_state);
@@ -174,7 +207,9 @@ void keyboard_handler(void) {
     /* Handle special keys */
     if (is_special_key(scancode)) {
         handle_special_key(scancode, &keyboard_state, &special_event);
-        if (special_callback) {
+        if (console_hotkey(&special_event)) {
+            /* Consumed by the console */
+        } else if (special_callback) {
             special_callback(&special_event);
         }
     }
@@ -185,21 +220,20 @@ void keyboard_handler(void) {
             char_callback(c);
         }
     }
-    
-    /* Send EOI to PIC */
-    pic_send_eoi(KEYBOARD_IRQ);
-    
-    /* Re-enable interrupts */
-    asm_sti();
+}
+
+/* Bottom half; the only consumer, so the tail needs no interrupt protection */
+static void keyboard_softirq(void) {
+    while (ring_tail != ring_head) {
+        uint8_t scancode = scancode_ring[ring_tail & (KEYBOARD_RING_SIZE - 1)];
+        ring_tail++;
+        keyboard_process(scancode);
+    }
 }
 
 uint8_t keyboard_read_scan_code(void) {
     /* Wait until data is available */
-    int timeout = 10000;
-    while (!(port_byte_in(KEYBOARD_STATUS_PORT) & 1) && timeout > 0) {
-        timeout--;
-    }
-    if (timeout == 0) {
+    if (keyboard_wait_read() != 0) {
         return 0;  /* Return 0 on timeout */
     }
     return port_byte_in(KEYBOARD_DATA_PORT);
@@ -207,52 +241,24 @@ uint8_t keyboard_read_scan_code(void) {
 
 void keyboard_enable(void) {
     /* Wait for keyboard to be ready */
-    int timeout = 10000;
-    while ((port_byte_in(KEYBOARD_STATUS_PORT) & 2) != 0 && timeout > 0) {
-        timeout--;
-    }
-    if (timeout == 0) {
+    if (keyboard_wait_write() != 0) {
         return;
     }
     
-    /* Send enable command */
+    /* Send enable command and wait for the acknowledgment */
     port_byte_out(KEYBOARD_DATA_PORT, KEYBOARD_CMD_ENABLE);
-    
-    /* Wait for acknowledgment with timeout */
-    timeout = 10000;
-    while (timeout > 0) {
-        if (port_byte_in(KEYBOARD_STATUS_PORT) & 1) {
-            if (port_byte_in(KEYBOARD_DATA_PORT) == 0xFA) {
-                break;
-            }
-        }
-        timeout--;
-    }
+    keyboard_expect(0xFA, KEYBOARD_ACK_TIMEOUT_US);
 }
 
 void keyboard_disable(void) {
     /* Wait for keyboard to be ready */
-    int timeout = 10000;
-    while ((port_byte_in(KEYBOARD_STATUS_PORT) & 2) != 0 && timeout > 0) {
-        timeout--;
-    }
-    if (timeout == 0) {
+    if (keyboard_wait_write() != 0) {
         return;
     }
     
-    /* Send disable command */
+    /* Send disable command and wait for the acknowledgment */
     port_byte_out(KEYBOARD_DATA_PORT, KEYBOARD_CMD_DISABLE);
-    
-    /* Wait for acknowledgment with timeout */
-    timeout = 10000;
-    while (timeout > 0) {
-        if (port_byte_in(KEYBOARD_STATUS_PORT) & 1) {
-            if (port_byte_in(KEYBOARD_DATA_PORT) == 0xFA) {
-                break;
-            }
-        }
-        timeout--;
-    }
+    keyboard_expect(0xFA, KEYBOARD_ACK_TIMEOUT_US);
 }
 
 void keyboard_set_scancode_callback(keyboard_scancode_callback_t callback) {
@@ -13,6 +13,18 @@
 #define KEYBOARD_STATUS_PORT    0x64
 #define KEYBOARD_COMMAND_PORT   0x64
 
+/* Controller status bits */
+#define KEYBOARD_STATUS_OUTPUT  0x01    /* Output buffer full: data to read */
+#define KEYBOARD_STATUS_INPUT   0x02    /* Input buffer full: controller busy */
+
+/* Response timeouts in microseconds */
+#define KEYBOARD_CTRL_TIMEOUT_US    10000       /* Controller buffer handshake */
+#define KEYBOARD_ACK_TIMEOUT_US     100000      /* Device command acknowledge */
+#define KEYBOARD_RESET_TIMEOUT_US   1000000     /* Device self-test after reset */
+
+/* Scancodes buffered between the interrupt and the keyboard softirq; a power of two */
+#define KEYBOARD_RING_SIZE      64
+
 /* Keyboard commands */
 #define KEYBOARD_CMD_LED       0xED
 #define KEYBOARD_CMD_ECHO      0xEE
@@ -25,12 +37,22 @@
 
 /* Function declarations */
 void keyboard_init(void);              /* Initialize keyboard */
-void keyboard_handler(void);           /* Keyboard interrupt handler */
 uint8_t keyboard_read_scan_code(void); /* Read scan code from keyboard */
 void keyboard_enable(void);            /* Enable keyboard */
 void keyboard_disable(void);           /* Disable keyboard */
 
-/* Callback types */
+/*
+ * Controller handshakes shared with the mouse driver; each returns 0, or -1
+ * on timeout. keyboard_expect() discards bytes until `byte` arrives.
+ */
+int keyboard_wait_write(void);
+int keyboard_wait_read(void);
+int keyboard_expect(uint8_t byte, uint32_t timeout_us);
+
+/*
+ * Callbacks run from the keyboard softirq with interrupts enabled. Work
+ * that draws or takes long belongs on the workqueue (schedule_work()).
+ */
 typedef void (*keyboard_scancode_callback_t)(uint8_t scancode);
 typedef void (*keyboard_char_callback_t)(char c);
 
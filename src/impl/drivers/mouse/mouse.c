@@ -6,9 +6,12 @@
 
 #include "mouse.h"
 #include "../port_io/port.h"
-#include "../pic/pic.h"
-#include "../serial/serial.h"
+#include "../../kernel/klog.h"
+#include "../../kernel/trace.h"
 #include "../../kernel/asm_utils.h"
+#include "../../kernel/irq.h"
+#include "../../kernel/kstat.h"
+#include "../../kernel/softirq.h"
 #include "../keyboard/keyboard.h"
 
 /* Mouse IRQ number */
@@ -23,8 +26,31 @@ struct MouseState mouse_state = {
 };
 static mouse_callback_t mouse_callback = 0;
 
+static void mouse_irq(struct InterruptFrame* frame, void* ctx);
+static void mouse_softirq(void);
+
+/* State after each packet, for the callback; free-running counters */
+static struct MouseState event_ring[MOUSE_RING_SIZE];
+static uint32_t ring_head = 0;
+static uint32_t ring_tail = 0;
+
+DEFINE_KSTAT_COUNTER(stat_dropped, "mouse.dropped");
+
+/* Send a byte to the mouse through the controller; 0 once it is acknowledged */
+static int mouse_write(uint8_t data) {
+    if (keyboard_wait_write() != 0) {
+        return -1;
+    }
+    port_byte_out(KEYBOARD_COMMAND_PORT, 0xD4);
+    if (keyboard_wait_write() != 0) {
+        return -1;
+    }
+    port_byte_out(KEYBOARD_DATA_PORT, data);
+    return keyboard_expect(0xFA, KEYBOARD_ACK_TIMEOUT_US);
+}
+
 void mouse_init(void) {
-    serial_write_string(COM1_PORT, "[MOUSE] Starting mouse initialization...\n");
+    klog_info("[MOUSE] Starting mouse initialization...");
     
     /* Disable interrupts during initialization */
     asm_cli();
@@ -34,67 +60,46 @@ void mouse_init(void) {
     port_byte_out(KEYBOARD_COMMAND_PORT, 0xA7);  /* Disable mouse */
     
     /* Step 2: Flush the output buffer */
-    while ((port_byte_in(KEYBOARD_STATUS_PORT) & 1)) {
+    while ((port_byte_in(KEYBOARD_STATUS_PORT) & KEYBOARD_STATUS_OUTPUT)) {
         port_byte_in(KEYBOARD_DATA_PORT);
     }
     
     /* Step 3: Set the controller configuration byte */
     port_byte_out(KEYBOARD_COMMAND_PORT, 0x20);  /* Read config */
-    
-    int timeout = 100000;
-    while (--timeout > 0) {
-        if (port_byte_in(KEYBOARD_STATUS_PORT) & 1) {
-            uint8_t config = port_byte_in(KEYBOARD_DATA_PORT);
-            config |= 0x02;      /* Enable IRQ12 */
-            config &= ~0x20;     /* Enable mouse clock */
-            config |= 0x01;      /* Enable keyboard interrupt */
-            config &= ~0x10;     /* Enable keyboard clock */
-            
-            port_byte_out(KEYBOARD_COMMAND_PORT, 0x60);  /* Write config */
-            port_byte_out(KEYBOARD_DATA_PORT, config);
-            serial_write_string(COM1_PORT, "[MOUSE] Controller configured\n");
-            break;
-        }
-    }
-    if (timeout == 0) {
-        serial_write_string(COM1_PORT, "[MOUSE] Error: Controller configuration failed\n");
+    if (keyboard_wait_read() != 0) {
+        klog_err("[MOUSE] Error: Controller configuration failed");
         asm_sti();
         return;
     }
     
-    /* Step 4: Enable the auxiliary mouse device */
-    port_byte_out(KEYBOARD_COMMAND_PORT, 0xA8);
+    uint8_t config = port_byte_in(KEYBOARD_DATA_PORT);
+    config |= 0x02;      /* Enable IRQ12 */
+    config &= ~0x20;     /* Enable mouse clock */
+    config |= 0x01;      /* Enable keyboard interrupt */
+    config &= ~0x10;     /* Enable keyboard clock */
     
-    /* Small delay */
-    for (volatile int i = 0; i < 100; i++) {}
+    keyboard_wait_write();
+    port_byte_out(KEYBOARD_COMMAND_PORT, 0x60);  /* Write config */
+    keyboard_wait_write();
+    port_byte_out(KEYBOARD_DATA_PORT, config);
+    klog_info("[MOUSE] Controller configured");
     
-    /* Step 5: Set mouse parameters */
-    /* Set sample rate */
-    port_byte_out(KEYBOARD_COMMAND_PORT, 0xD4);
-    port_byte_out(KEYBOARD_DATA_PORT, 0xF3);  /* Set sample rate */
-    port_byte_out(KEYBOARD_DATA_PORT, 100);   /* 100 samples/sec */
+    /* Step 4: Enable the auxiliary mouse device */
+    keyboard_wait_write();
+    port_byte_out(KEYBOARD_COMMAND_PORT, 0xA8);
     
-    /* Set resolution */
-    port_byte_out(KEYBOARD_COMMAND_PORT, 0xD4);
-    port_byte_out(KEYBOARD_DATA_PORT, 0xE8);  /* Set resolution */
-    port_byte_out(KEYBOARD_DATA_PORT, 0x03);  /* 8 counts/mm */
-    
-    /* Set scaling 1:1 */
-    port_byte_out(KEYBOARD_COMMAND_PORT, 0xD4);
-    port_byte_out(KEYBOARD_DATA_PORT, 0xE6);
+    /* Step 5: Set mouse parameters; each byte is acknowledged */
+    mouse_write(0xF3);  /* Set sample rate */
+    mouse_write(100);   /* 100 samples/sec */
+    mouse_write(0xE8);  /* Set resolution */
+    mouse_write(0x03);  /* 8 counts/mm */
+    mouse_write(0xE6);  /* Set scaling 1:1 */
     
     /* Enable packet streaming */
-    port_byte_out(KEYBOARD_COMMAND_PORT, 0xD4);
-    port_byte_out(KEYBOARD_DATA_PORT, 0xF4);
-    
-    timeout = 100000;
-    while (--timeout > 0) {
-        if (port_byte_in(KEYBOARD_STATUS_PORT) & 1) {
-            if (port_byte_in(KEYBOARD_DATA_PORT) == 0xFA) {
-                serial_write_string(COM1_PORT, "[MOUSE] Packet streaming enabled\n");
-                break;
-            }
-        }
+    if (mouse_write(0xF4) == 0) {
+        klog_info("[MOUSE] Packet streaming enabled");
+    } else {
+        klog_warn("[MOUSE] No acknowledgment for packet streaming");
     }
     
     /* Step 6: Re-enable keyboard */
@@ -106,63 +111,55 @@ void mouse_init(void) {
     mouse_state.buttons = 0;
     
     /* Enable mouse interrupt */
-    pic_clear_mask(MOUSE_IRQ);
-    serial_write_string(COM1_PORT, "[MOUSE] Interrupt enabled\n");
+    softirq_register(SOFTIRQ_MOUSE, mouse_softirq);
+    irq_register(IRQ_VECTOR(MOUSE_IRQ), mouse_irq, NULL);
+    irq_unmask(MOUSE_IRQ);
+    klog_info("[MOUSE] Interrupt enabled");
     
     /* Re-enable interrupts */
     asm_sti();
     
-    serial_write_string(COM1_PORT, "[MOUSE] Initialization complete\n");
+    klog_info("[MOUSE] Initialization complete");
 }
 
-void mouse_handler(void) {
+static void mouse_irq(struct InterruptFrame* frame, void* ctx) {
     static uint8_t cycle = 0;
     static struct MousePacket packet = {0};
     uint8_t status;
-    char debug_msg[64];
+    
+    (void)frame;
+    (void)ctx;
     
     /* Read status before data */
     status = port_byte_in(KEYBOARD_STATUS_PORT);
     
-    /* Debug output */
-    sprintf(debug_msg, "[MOUSE] Status: 0x%02x\n", status);
-    serial_write_string(COM1_PORT, debug_msg);
-    
     /* Check if this is actually mouse data */
     if (!(status & 0x20)) {
-        serial_write_string(COM1_PORT, "[MOUSE] Not mouse data, ignoring\n");
-        pic_send_eoi(MOUSE_IRQ);
+        klog_debug_ratelimited("[MOUSE] Not mouse data (status 0x%02x), ignoring", status);
         return;
     }
     
     /* Read the data */
     uint8_t data = port_byte_in(KEYBOARD_DATA_PORT);
     
-    /* Debug output */
-    sprintf(debug_msg, "[MOUSE] Received data: 0x%02x, cycle: %d\n", data, cycle);
-    serial_write_string(COM1_PORT, debug_msg);
-    
     switch(cycle) {
         case 0:
             /* Verify first byte (should have bit 3 set) */
             if (data & 0x08) {
                 packet.buttons = data;
                 cycle = 1;
-                serial_write_string(COM1_PORT, "[MOUSE] First byte received\n");
             } else {
-                serial_write_string(COM1_PORT, "[MOUSE] Invalid first byte, resetting\n");
+                klog_warn_ratelimited("[MOUSE] Invalid first byte 0x%02x, resetting", data);
             }
             break;
             
         case 1:
             packet.x_movement = (int8_t)data;
             cycle = 2;
-            serial_write_string(COM1_PORT, "[MOUSE] X movement received\n");
             break;
             
         case 2:
             packet.y_movement = (int8_t)data;
-            serial_write_string(COM1_PORT, "[MOUSE] Y movement received\n");
             
             /* Update mouse state */
             mouse_state.buttons = packet.buttons & 0x07;
@@ -181,77 +178,47 @@ void mouse_handler(void) {
             mouse_state.x_pos = (new_x < 0) ? 0 : (new_x > 1023) ? 1023 : new_x;
             mouse_state.y_pos = (new_y < 0) ? 0 : (new_y > 767) ? 767 : new_y;
             
-            /* Debug output */
-            sprintf(debug_msg, "[MOUSE] Position: X=%d, Y=%d, Buttons=%02x\n", 
-                    mouse_state.x_pos, mouse_state.y_pos, mouse_state.buttons);
-            serial_write_string(COM1_PORT, debug_msg);
+            trace("mouse x=%u y=%u buttons=%02x",
+                  mouse_state.x_pos, mouse_state.y_pos, mouse_state.buttons);
             
-            /* Call callback if registered */
-            if (mouse_callback) {
-                mouse_callback(&mouse_state);
-                serial_write_string(COM1_PORT, "[MOUSE] Callback executed\n");
+            /* The callback runs from the softirq */
+            if (ring_head - ring_tail < MOUSE_RING_SIZE) {
+                event_ring[ring_head & (MOUSE_RING_SIZE - 1)] = mouse_state;
+                ring_head++;
+                softirq_raise(SOFTIRQ_MOUSE);
             } else {
-                serial_write_string(COM1_PORT, "[MOUSE] No callback registered\n");
+                kstat_inc(stat_dropped);
             }
             
             cycle = 0;
             break;
     }
-    
-    /* Send EOI to PIC */
-    pic_send_eoi(MOUSE_IRQ);
 }
 
-void mouse_enable(void) {
-    /* Wait for keyboard controller to be ready */
-    int timeout = 10000;
-    while ((port_byte_in(KEYBOARD_STATUS_PORT) & 2) != 0 && timeout > 0) {
-        timeout--;
-    }
-    if (timeout == 0) {
-        return;
-    }
-    
-    /* Send enable command */
-    port_byte_out(KEYBOARD_COMMAND_PORT, 0xD4);
-    port_byte_out(KEYBOARD_DATA_PORT, MOUSE_CMD_ENABLE);
-    
-    /* Wait for acknowledgment with timeout */
-    timeout = 10000;
-    while (timeout > 0) {
-        if (port_byte_in(KEYBOARD_STATUS_PORT) & 1) {
-            if (port_byte_in(KEYBOARD_DATA_PORT) == 0xFA) {
-                break;
-            }
+static void mouse_softirq(void) {
+    for (;;) {
+        struct MouseState state;
+        uint64_t flags = asm_irq_save();
+        if (ring_tail == ring_head) {
+            asm_irq_restore(flags);
+            break;
+        }
+        state = event_ring[ring_tail & (MOUSE_RING_SIZE - 1)];
+        ring_tail++;
+        asm_irq_restore(flags);
+
+        if (mouse_callback) {
+            mouse_callback(&state);
         }
-        timeout--;
     }
 }
 
+void mouse_enable(void) {
+    mouse_write(MOUSE_CMD_ENABLE);
+}
+
 void mouse_disable(void) {
-    /* Wait for keyboard controller to be ready */
-    int timeout = 10000;
-    while ((port_byte_in(KEYBOARD_STATUS_PORT) & 2) != 0 && timeout > 0) {
-        timeout--;
-    }
-    if (timeout == 0) {
-        return;
-    }
-    
-    /* Send disable command */
-    port_byte_out(KEYBOARD_COMMAND_PORT, 0xD4);
-    port_byte_out(KEYBOARD_DATA_PORT, MOUSE_CMD_DISABLE);
-    
-    /* Wait for acknowledgment with timeout */
-    timeout = 10000;
-    while (timeout > 0) {
-        if (port_byte_in(KEYBOARD_STATUS_PORT) & 1) {
-            if (port_byte_in(KEYBOARD_DATA_PORT) == 0xFA) {
-                break;
-            }
-        }
-        timeout--;
-    }
+    mouse_write(MOUSE_CMD_DISABLE);
 }
 
 void mouse_set_callback(mouse_callback_t callback) {
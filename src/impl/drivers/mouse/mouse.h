@@ -45,11 +45,13 @@ extern struct MouseState mouse_state;
 
 /* Function declarations */
 void mouse_init(void);              /* Initialize mouse */
-void mouse_handler(void);           /* Mouse interrupt handler */
 void mouse_enable(void);            /* Enable mouse */
 void mouse_disable(void);           /* Disable mouse */
 
-/* Callback type for mouse events */
+/* Mouse states buffered between the interrupt and the mouse softirq; a power of two */
+#define MOUSE_RING_SIZE       32
+
+/* Callback type for mouse events; runs from the mouse softirq with interrupts enabled */
 typedef void (*mouse_callback_t)(struct MouseState* state);
 
 /* Set callback for mouse events */
@@ -41,7 +41,7 @@ void pic_init(void) {
     /* Restore masks - enable timer, keyboard, and cascade */
     mask1 = 0xF8;  /* 1111 1000 - Enable IRQ0 (timer), IRQ1 (keyboard), IRQ2 (cascade) */
     mask2 = 0xFF;  /* All disabled on slave PIC initially */
-    
+
     port_byte_out(PIC1_DATA, mask1);
     port_io_wait();
     port_byte_out(PIC2_DATA, mask2);
@@ -56,6 +56,22 @@ void pic_send_eoi(uint8_t irq) {
     port_byte_out(PIC1_COMMAND, PIC_EOI);
 }
 
+int pic_spurious(uint8_t irq) {
+    if (irq != 7 && irq != 15) {
+        return 0;
+    }
+
+    uint16_t port = irq == 7 ? PIC1_COMMAND : PIC2_COMMAND;
+    port_byte_out(port, PIC_READ_ISR);
+    if (port_byte_in(port) & 0x80) {
+        return 0;
+    }
+    if (irq == 15) {
+        port_byte_out(PIC1_COMMAND, PIC_EOI);
+    }
+    return 1;
+}
+
 /* Set interrupt mask */
 void pic_set_mask(uint8_t irq) {
     uint16_t port;
@@ -91,4 +107,27 @@ void pic_disable(void) {
     /* Mask all interrupts */
     port_byte_out(PIC1_DATA, 0xFF);
     port_byte_out(PIC2_DATA, 0xFF);
-} 
\ No newline at end of file
+}
+
+static inline int pic_vector(uint64_t vector) {
+    return vector >= IRQ_BASE_VECTOR && vector < IRQ_BASE_VECTOR + IRQ_LEGACY_COUNT;
+}
+
+/* A line that dropped before the acknowledge cycle shows up as IRQ7/15 */
+static int pic_chip_spurious(uint64_t vector) {
+    return pic_vector(vector) && pic_spurious(vector - IRQ_BASE_VECTOR);
+}
+
+static void pic_chip_eoi(uint64_t vector) {
+    if (pic_vector(vector)) {
+        pic_send_eoi(vector - IRQ_BASE_VECTOR);
+    }
+}
+
+const struct IRQChip pic_irq_chip = {
+    .name = "8259 PIC",
+    .mask = pic_set_mask,
+    .unmask = pic_clear_mask,
+    .spurious = pic_chip_spurious,
+    .eoi = pic_chip_eoi,
+};
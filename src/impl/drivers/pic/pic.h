@@ -6,6 +6,7 @@
 
 #pragma once
 #include <stdint.h>
+#include "../../kernel/irq.h"
 
 /* PIC ports */
 #define PIC1_COMMAND    0x20
@@ -15,6 +16,7 @@
 
 /* PIC commands */
 #define PIC_EOI         0x20    /* End of interrupt command */
+#define PIC_READ_ISR    0x0B    /* OCW3: next command port read returns the in-service register */
 #define ICW1_ICW4       0x01    /* ICW4 needed */
 #define ICW1_SINGLE     0x02    /* Single (cascade) mode */
 #define ICW1_INTERVAL4  0x04    /* Call address interval 4 */
@@ -31,4 +33,14 @@ void pic_init(void);                    /* Initialize PIC */
 void pic_send_eoi(uint8_t irq);         /* Send end of interrupt */
 void pic_disable(void);                 /* Disable PIC */
 void pic_set_mask(uint8_t irq);         /* Set interrupt mask */
-void pic_clear_mask(uint8_t irq);       /* Clear interrupt mask */ 
\ No newline at end of file
+void pic_clear_mask(uint8_t irq);       /* Clear interrupt mask */
+
+/*
+ * True for an IRQ7/IRQ15 that is not in service, i.e. spurious; it must
+ * not get an EOI. A spurious IRQ15 still used the master's cascade input,
+ * so the master is acknowledged here.
+ */
+int pic_spurious(uint8_t irq);
+
+/* Legacy IRQs on the 8259 pair; the dispatcher's default chip */
+extern const struct IRQChip pic_irq_chip;
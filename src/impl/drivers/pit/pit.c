@@ -6,25 +6,53 @@
 
 #include "pit.h"
 #include "../port_io/port.h"
-#include "../pic/pic.h"
-#include "../serial/serial.h"
+#include "../../kernel/klog.h"
+#include "../../kernel/asm_utils.h"
+#include "../../kernel/tracepoint.h"
+#include "../../kernel/clockevent.h"
+#include "../../kernel/irq.h"
+#include "../../kernel/ktime.h"
 
 /* PIT IRQ number */
 #define PIT_IRQ 0
 
-/* Internal variables */
-static uint64_t tick_count = 0;
-static timer_callback_t timer_callback = 0;
+DEFINE_TRACEPOINT(pit_tick, "tick=%llu oversample=%llu");
+
+/* Longest one-shot count: 65535 PIT clocks, about 54.9 ms */
+#define PIT_MAX_COUNT   0xFFFF
+
+static void pit_ce_set_periodic(struct ClockEventDevice* dev, uint32_t hz);
+static void pit_ce_set_next_event(struct ClockEventDevice* dev, uint64_t delta_ns);
+
+static struct ClockEventDevice pit_clockevent = {
+    .name = "pit",
+    .features = CLOCK_EVT_FEAT_PERIODIC | CLOCK_EVT_FEAT_ONESHOT,
+    .rating = 100,
+    .min_delta_ns = 10 * NSEC_PER_USEC,
+    .max_delta_ns = PIT_MAX_COUNT * NSEC_PER_SEC / PIT_FREQUENCY,
+    .set_periodic = pit_ce_set_periodic,
+    .set_next_event = pit_ce_set_next_event,
+};
+
+static void pit_irq(struct InterruptFrame* frame, void* ctx) {
+    (void)frame;
+    (void)ctx;
+    clockevents_handle(&pit_clockevent);
+    tracepoint(pit_tick, tick_get_ticks(), tick_get_oversample());
+}
 
 void pit_init(uint32_t frequency) {
     /* Set up the timer frequency */
-    pit_set_frequency(frequency);
+    clockevents_register(&pit_clockevent, frequency);
+
+    /* Fails harmlessly once the HPET has taken IRQ0 over */
+    irq_register(IRQ_VECTOR(PIT_IRQ), pit_irq, NULL);
     
     /* Enable timer interrupt */
-    pic_clear_mask(PIT_IRQ);
+    irq_unmask(PIT_IRQ);
     
     /* Send initialization message */
-    serial_write_string(COM1_PORT, "[PIT] Timer initialized\n");
+    klog_info("[PIT] Timer initialized");
 }
 
 void pit_set_frequency(uint32_t hz) {
@@ -39,27 +67,89 @@ void pit_set_frequency(uint32_t hz) {
     port_byte_out(PIT_CHANNEL0, (divisor >> 8) & 0xFF);    /* High byte */
 }
 
-void pit_handler(void) {
-    tick_count++;
-    
-    /* Send heartbeat every second */
-    if (tick_count % PIT_DEFAULT_HZ == 0) {
-        serial_write_string(COM1_PORT, ".");
+static void pit_ce_set_periodic(struct ClockEventDevice* dev, uint32_t hz) {
+    (void)dev;
+    pit_set_frequency(hz);
+}
+
+/* Mode 0: IRQ0 fires once when the count reaches zero */
+static void pit_ce_set_next_event(struct ClockEventDevice* dev, uint64_t delta_ns) {
+    (void)dev;
+    uint64_t count = delta_ns * PIT_FREQUENCY / NSEC_PER_SEC;
+    if (count == 0) {
+        count = 1;
+    } else if (count > PIT_MAX_COUNT) {
+        count = PIT_MAX_COUNT;
     }
-    
-    /* Call timer callback if registered */
-    if (timer_callback) {
-        timer_callback();
+
+    port_byte_out(PIT_COMMAND, PIT_CHANNEL0_SELECT | PIT_LOBYTE_HIBYTE | PIT_ONE_SHOT | PIT_BINARY_MODE);
+    port_byte_out(PIT_CHANNEL0, count & 0xFF);
+    port_byte_out(PIT_CHANNEL0, (count >> 8) & 0xFF);
+}
+
+void pit_set_oversample(uint32_t factor) {
+    tick_set_oversample(factor);
+}
+
+uint8_t pit_channel2_start(uint16_t count) {
+    /* Gate channel 2 on, keep the speaker disconnected */
+    uint8_t control = port_byte_in(PIT_CONTROL_PORT);
+    port_byte_out(PIT_CONTROL_PORT, (control & ~PIT_CONTROL_SPEAKER) | PIT_CONTROL_GATE2);
+
+    port_byte_out(PIT_COMMAND, PIT_CHANNEL2_SELECT | PIT_LOBYTE_HIBYTE | PIT_ONE_SHOT | PIT_BINARY_MODE);
+    port_byte_out(PIT_CHANNEL2, count & 0xFF);
+    port_byte_out(PIT_CHANNEL2, (count >> 8) & 0xFF);   /* Counting starts here */
+    return control;
+}
+
+int pit_channel2_expired(void) {
+    return (port_byte_in(PIT_CONTROL_PORT) & PIT_CONTROL_OUT2) != 0;
+}
+
+void pit_channel2_stop(uint8_t control) {
+    port_byte_out(PIT_CONTROL_PORT, control);
+}
+
+uint64_t pit_calibrate_tsc(uint32_t ms) {
+    uint32_t latch = (uint32_t)((uint64_t)PIT_FREQUENCY * ms / 1000);
+    if (ms == 0 || latch > 0xFFFF) {
+        return 0;
     }
-    
-    /* Send EOI to PIC */
-    pic_send_eoi(PIT_IRQ);
+
+    uint8_t control = pit_channel2_start(latch);
+    uint64_t start = asm_rdtsc();
+    uint64_t end = 0;
+
+    /* Each port read takes about a microsecond; allow far more than `ms` */
+    for (uint32_t spins = 0; spins < ms * 100000; spins++) {
+        if (pit_channel2_expired()) {
+            end = asm_rdtsc();
+            break;
+        }
+    }
+
+    pit_channel2_stop(control);
+    if (!end) {
+        return 0;
+    }
+
+    /* The interval is exactly `latch` PIT clocks */
+    return (end - start) * PIT_FREQUENCY / latch;
+}
+
+uint16_t pit_read_counter(void) {
+    uint64_t flags = asm_irq_save();
+    port_byte_out(PIT_COMMAND, PIT_CHANNEL0_SELECT | PIT_LATCH_COUNT);
+    uint16_t count = port_byte_in(PIT_CHANNEL0);
+    count |= (uint16_t)port_byte_in(PIT_CHANNEL0) << 8;
+    asm_irq_restore(flags);
+    return count;
 }
 
 uint64_t pit_get_ticks(void) {
-    return tick_count;
+    return tick_get_ticks();
 }
 
 void pit_set_callback(timer_callback_t callback) {
-    timer_callback = callback;
+    tick_set_callback(callback);
 } 
\ No newline at end of file
@@ -18,6 +18,15 @@
 #define PIT_LOBYTE_HIBYTE      0x30    /* Access mode: low byte/high byte */
 #define PIT_SQUARE_WAVE        0x06    /* Square wave generator */
 #define PIT_BINARY_MODE        0x00    /* 16-bit binary mode */
+#define PIT_CHANNEL2_SELECT     0x80    /* Select channel 2 */
+#define PIT_ONE_SHOT            0x00    /* Mode 0: output goes high at terminal count */
+#define PIT_LATCH_COUNT         0x00    /* Access mode 0: latch the count for reading */
+
+/* Channel 2 gate and output live in the system control port */
+#define PIT_CONTROL_PORT        0x61
+#define PIT_CONTROL_GATE2       0x01    /* Channel 2 counts while set */
+#define PIT_CONTROL_SPEAKER     0x02    /* Speaker data enable */
+#define PIT_CONTROL_OUT2        0x20    /* Channel 2 output level */
 
 /* PIT frequency */
 #define PIT_FREQUENCY    1193180        /* Base frequency: 1.193180 MHz */
@@ -26,11 +35,31 @@
 /* Function declarations */
 void pit_init(uint32_t frequency);      /* Initialize PIT with given frequency */
 void pit_set_frequency(uint32_t hz);    /* Set PIT frequency in Hz */
-uint64_t pit_get_ticks(void);          /* Get number of ticks since boot */
-void pit_handler(void);                 /* Timer interrupt handler */
+uint64_t pit_get_ticks(void);          /* Kernel ticks since boot (see tick_get_ticks) */
+
+/* Oversample the kernel tick (see tick_set_oversample) */
+void pit_set_oversample(uint32_t factor);
+
+/*
+ * Count down about `ms` milliseconds (at most 54) on channel 2 with the
+ * speaker off and return the TSC rate in Hz measured over it, or 0 if the
+ * channel never expired. Independent of channel 0 and of interrupts.
+ */
+uint64_t pit_calibrate_tsc(uint32_t ms);
+
+/*
+ * One-shot countdown of `count` PIT clocks on channel 2 with the speaker
+ * off. Start returns the previous system control value for stop to restore.
+ */
+uint8_t pit_channel2_start(uint16_t count);
+int pit_channel2_expired(void);
+void pit_channel2_stop(uint8_t control);
+
+/* Latch and read channel 0's current count (it counts down) */
+uint16_t pit_read_counter(void);
 
 /* Timer callback type */
 typedef void (*timer_callback_t)(void);
 
-/* Set callback for timer events */
+/* Set callback for kernel ticks (see tick_set_callback) */
 void pit_set_callback(timer_callback_t callback); 
\ No newline at end of file
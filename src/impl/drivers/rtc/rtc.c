@@ -6,27 +6,58 @@
 
 #include "rtc.h"
 #include "../port_io/port.h"
-#include "../pic/pic.h"
+#include "../hpet/hpet.h"
+#include "../../kernel/klog.h"
+#include "../../kernel/asm_utils.h"
+#include "../../kernel/kstat.h"
+#include "../../kernel/ktime.h"
+#include "../../kernel/timer.h"
+#include "../../kernel/delay.h"
+#include "../../kernel/clockevent.h"
+#include "../../kernel/irq.h"
 
 /* RTC IRQ number */
 #define RTC_IRQ 8
 
+/* UIP rises 244 us before an update, which then takes at most 2 ms */
+#define RTC_UPDATE_TIMEOUT_US   2500
+
+DEFINE_KSTAT_COUNTER(stat_resyncs, "rtc.resyncs");
+
 /* Internal callback */
 static rtc_callback_t rtc_callback = 0;
 
 /* Internal RTC time */
 static struct RTCTime current_time = {0};
 
-/* Read RTC register */
-static uint8_t rtc_read_register(uint8_t reg) {
+/*
+ * Resync state: the timer starts a resync every RTC_RESYNC_SECONDS; the
+ * next update-ended event then sets the wall clock at a second boundary.
+ * With HPET legacy replacement IRQ8 belongs to the HPET, so the timer
+ * polls the update-ended flag once per tick instead.
+ */
+static void rtc_resync_timer(void* data);
+static struct Timer resync_timer = TIMER_INIT(resync_timer, rtc_resync_timer, NULL);
+static int resync_pending = 0;
+static int resync_polled = 0;
+
+static void rtc_irq(struct InterruptFrame* frame, void* ctx);
+
+/* Read RTC register; the index/data pair must not be split by the handler */
+uint8_t rtc_read_register(uint8_t reg) {
+    uint64_t flags = asm_irq_save();
     port_byte_out(RTC_INDEX_PORT, reg);
-    return port_byte_in(RTC_DATA_PORT);
+    uint8_t value = port_byte_in(RTC_DATA_PORT);
+    asm_irq_restore(flags);
+    return value;
 }
 
 /* Write RTC register */
 static void rtc_write_register(uint8_t reg, uint8_t value) {
+    uint64_t flags = asm_irq_save();
     port_byte_out(RTC_INDEX_PORT, reg);
     port_byte_out(RTC_DATA_PORT, value);
+    asm_irq_restore(flags);
 }
 
 uint8_t rtc_bcd_to_bin(uint8_t bcd) {
@@ -38,41 +69,146 @@ uint8_t rtc_bin_to_bcd(uint8_t bin) {
 }
 
 int rtc_update_in_progress(void) {
-    return rtc_read_register(RTC_STATUS_A) & 0x80;
+    return rtc_read_register(RTC_STATUS_A) & RTC_A_UIP;
 }
 
-void rtc_read_time(struct RTCTime* time) {
-    /* Wait until RTC is not updating */
-    while (rtc_update_in_progress());
+/* Read the clock registers as they are, decoding the current data mode */
+static void rtc_read_current(struct RTCTime* time) {
+    uint8_t status = rtc_read_register(RTC_STATUS_B);
+    uint8_t second = rtc_read_register(RTC_SECONDS);
+    uint8_t minute = rtc_read_register(RTC_MINUTES);
+    uint8_t hour = rtc_read_register(RTC_HOURS);
+    uint8_t day = rtc_read_register(RTC_DAY);
+    uint8_t month = rtc_read_register(RTC_MONTH);
+    uint8_t year = rtc_read_register(RTC_YEAR);
+    uint8_t weekday = rtc_read_register(RTC_WEEKDAY);
+    uint8_t pm = hour & RTC_HOUR_PM;
 
-    /* Read all time values in BCD format */
-    time->second = rtc_bcd_to_bin(rtc_read_register(RTC_SECONDS));
-    time->minute = rtc_bcd_to_bin(rtc_read_register(RTC_MINUTES));
-    time->hour = rtc_bcd_to_bin(rtc_read_register(RTC_HOURS));
-    time->day = rtc_bcd_to_bin(rtc_read_register(RTC_DAY));
-    time->month = rtc_bcd_to_bin(rtc_read_register(RTC_MONTH));
-    time->year = rtc_bcd_to_bin(rtc_read_register(RTC_YEAR)) + 2000;
-    time->weekday = rtc_bcd_to_bin(rtc_read_register(RTC_WEEKDAY));
+    hour &= ~RTC_HOUR_PM;
+    if (!(status & RTC_B_BINARY)) {
+        second = rtc_bcd_to_bin(second);
+        minute = rtc_bcd_to_bin(minute);
+        hour = rtc_bcd_to_bin(hour);
+        day = rtc_bcd_to_bin(day);
+        month = rtc_bcd_to_bin(month);
+        year = rtc_bcd_to_bin(year);
+        weekday = rtc_bcd_to_bin(weekday);
+    }
+    if (!(status & RTC_B_24HOUR)) {
+        hour = hour % 12 + (pm ? 12 : 0);
+    }
+
+    time->second = second;
+    time->minute = minute;
+    time->hour = hour;
+    time->day = day;
+    time->month = month;
+    time->year = year + 2000;
+    time->weekday = weekday;
 }
 
-void rtc_init(void) {
-    uint8_t status;
+void rtc_read_time(struct RTCTime* time) {
+    /* Reading during an update gives torn values */
+    poll_until(!rtc_update_in_progress(), RTC_UPDATE_TIMEOUT_US);
+    rtc_read_current(time);
+}
 
-    /* Read Status Register B */
-    status = rtc_read_register(RTC_STATUS_B);
+uint64_t rtc_time_to_epoch(const struct RTCTime* time) {
+    /* Days from 1970-01-01 in the proleptic Gregorian calendar, years from March */
+    uint32_t year = time->year - (time->month <= 2);
+    uint32_t era = year / 400;
+    uint32_t year_of_era = year - era * 400;
+    uint32_t day_of_year = (153 * (time->month + (time->month > 2 ? -3 : 9)) + 2) / 5 + time->day - 1;
+    uint32_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    uint64_t days = (uint64_t)era * 146097 + day_of_era - 719468;
 
-    /* Set 24-hour mode, binary mode */
-    status |= 0x02;  /* 24 hour mode */
-    status |= 0x04;  /* Binary mode */
+    return days * 86400 + time->hour * 3600 + time->minute * 60 + time->second;
+}
 
-    /* Write back Status Register B */
+static void rtc_set_update_interrupt(int enable) {
+    uint8_t status = rtc_read_register(RTC_STATUS_B);
+    status = enable ? (status | RTC_B_UIE) : (status & ~RTC_B_UIE);
     rtc_write_register(RTC_STATUS_B, status);
+}
+
+/* An update just ended, so the registers are stable for almost a second */
+static void rtc_update_ended(void) {
+    rtc_read_current(&current_time);
+
+    if (resync_pending) {
+        uint64_t real = rtc_time_to_epoch(&current_time) * NSEC_PER_SEC;
+        int64_t step = (int64_t)(real - ktime_get_real());
 
-    /* Enable RTC interrupt */
-    pic_clear_mask(RTC_IRQ);
+        ktime_set_real(real);
+        kstat_inc(stat_resyncs);
+        klog_debug("[RTC] Wall clock resynced, stepped %lld us", (long long)(step / 1000));
+
+        resync_pending = 0;
+        if (!resync_polled && !rtc_callback) {
+            rtc_set_update_interrupt(0);
+        }
+        timer_mod(&resync_timer, tick_get_ticks() + (uint64_t)RTC_RESYNC_SECONDS * tick_get_hz());
+    }
 
-    /* Read initial time */
-    rtc_read_time(&current_time);
+    if (rtc_callback) {
+        rtc_callback(&current_time);
+    }
+}
+
+static void rtc_resync_timer(void* data) {
+    (void)data;
+
+    if (!resync_pending) {
+        resync_pending = 1;
+        resync_polled = hpet_owns_irq0();
+        rtc_read_register(RTC_STATUS_C);   /* Drop a stale update-ended flag */
+        if (!resync_polled) {
+            rtc_set_update_interrupt(1);
+            return;
+        }
+    } else if (rtc_read_register(RTC_STATUS_C) & RTC_C_UF) {
+        /* Polled: the update ended within the last tick */
+        rtc_update_ended();
+        return;
+    }
+    timer_mod(&resync_timer, tick_get_ticks() + 1);
+}
+
+void rtc_init(void) {
+    struct RTCTime now;
+    uint8_t status = rtc_read_register(RTC_STATUS_B);
+
+    /* Whatever format the firmware left the clock in */
+    rtc_read_time(&now);
+
+    /*
+     * Changing the data mode does not convert the stored values, so hold
+     * updates and write the time back in the new format.
+     */
+    if ((status & (RTC_B_BINARY | RTC_B_24HOUR)) != (RTC_B_BINARY | RTC_B_24HOUR)) {
+        status |= RTC_B_BINARY | RTC_B_24HOUR;
+        rtc_write_register(RTC_STATUS_B, status | RTC_B_SET);
+        rtc_write_register(RTC_SECONDS, now.second);
+        rtc_write_register(RTC_MINUTES, now.minute);
+        rtc_write_register(RTC_HOURS, now.hour);
+        rtc_write_register(RTC_DAY, now.day);
+        rtc_write_register(RTC_MONTH, now.month);
+        rtc_write_register(RTC_YEAR, now.year % 100);
+        rtc_write_register(RTC_WEEKDAY, now.weekday);
+        rtc_write_register(RTC_STATUS_B, status);
+    }
+
+    current_time = now;
+    ktime_set_real(rtc_time_to_epoch(&now) * NSEC_PER_SEC);
+    klog_info("[RTC] %04u-%02u-%02u %02u:%02u:%02u UTC", now.year, now.month, now.day,
+              now.hour, now.minute, now.second);
+
+    /* The read above is only good to the second; the next update pins it down */
+    irq_register(IRQ_VECTOR(RTC_IRQ), rtc_irq, NULL);
+    irq_unmask(RTC_IRQ);
+    if (!resync_pending) {
+        timer_mod(&resync_timer, tick_get_ticks());
+    }
 }
 
 void rtc_enable_interrupt(void) {
@@ -82,7 +218,7 @@ void rtc_enable_interrupt(void) {
     status = rtc_read_register(RTC_STATUS_B);
 
     /* Enable periodic interrupt */
-    status |= 0x40;
+    status |= RTC_B_PIE;
 
     /* Write back Status Register B */
     rtc_write_register(RTC_STATUS_B, status);
@@ -98,28 +234,25 @@ void rtc_disable_interrupt(void) {
     status = rtc_read_register(RTC_STATUS_B);
 
     /* Disable periodic interrupt */
-    status &= ~0x40;
+    status &= ~RTC_B_PIE;
 
     /* Write back Status Register B */
     rtc_write_register(RTC_STATUS_B, status);
 }
 
-void rtc_handler(void) {
-    /* Read Status Register C to acknowledge interrupt */
-    rtc_read_register(RTC_STATUS_C);
+static void rtc_irq(struct InterruptFrame* frame, void* ctx) {
+    (void)frame;
+    (void)ctx;
 
-    /* Update current time */
-    rtc_read_time(&current_time);
+    /* Reading Status Register C acknowledges the interrupt */
+    uint8_t flags = rtc_read_register(RTC_STATUS_C);
 
-    /* Call callback if registered */
-    if (rtc_callback) {
-        rtc_callback(&current_time);
+    if (flags & RTC_C_UF) {
+        rtc_update_ended();
     }
-
-    /* Send EOI to PIC */
-    pic_send_eoi(RTC_IRQ);
 }
 
 void rtc_set_callback(rtc_callback_t callback) {
     rtc_callback = callback;
-} 
\ No newline at end of file
+    rtc_set_update_interrupt(callback || (resync_pending && !resync_polled));
+}
@@ -24,6 +24,20 @@
 #define RTC_STATUS_C       0x0C
 #define RTC_STATUS_D       0x0D
 
+/* Status register bits */
+#define RTC_A_UIP          0x80    /* Update in progress (or starting within 244 us) */
+#define RTC_B_SET          0x80    /* Hold updates while the time is written */
+#define RTC_B_PIE          0x40    /* Periodic interrupt enable */
+#define RTC_B_UIE          0x10    /* Update-ended interrupt enable */
+#define RTC_B_BINARY       0x04    /* Binary instead of BCD values */
+#define RTC_B_24HOUR       0x02
+#define RTC_C_PF           0x40    /* Periodic interrupt flag */
+#define RTC_C_UF           0x10    /* Update-ended flag; set whether or not UIE is */
+#define RTC_HOUR_PM        0x80    /* In 12-hour mode */
+
+/* Wall clock resync period against the update-ended interrupt */
+#define RTC_RESYNC_SECONDS 300
+
 /* Time structure */
 struct RTCTime {
     uint8_t second;
@@ -35,21 +49,35 @@ struct RTCTime {
     uint8_t weekday;
 };
 
-/* Function declarations */
-void rtc_init(void);                          /* Initialize RTC */
-void rtc_read_time(struct RTCTime* time);     /* Read current time */
+/*
+ * Switch the RTC to binary 24-hour mode (rewriting the time so it survives
+ * the switch), read it once to set the wall clock, and schedule a resync at
+ * the next update-ended interrupt to pin the sub-second phase. Needs the
+ * kernel tick running.
+ */
+void rtc_init(void);
+
+/*
+ * Read the clock registers, waiting out an update in progress. This costs
+ * port I/O and up to 2 ms; use ktime_get_real() for the time of day.
+ */
+void rtc_read_time(struct RTCTime* time);
 int rtc_update_in_progress(void);             /* Check if RTC update in progress */
+uint8_t rtc_read_register(uint8_t reg);
+
+/* Seconds since the Unix epoch for a UTC calendar time */
+uint64_t rtc_time_to_epoch(const struct RTCTime* time);
 
 /* Time format conversion functions */
 uint8_t rtc_bcd_to_bin(uint8_t bcd);         /* Convert BCD to binary */
 uint8_t rtc_bin_to_bcd(uint8_t bin);         /* Convert binary to BCD */
 
 /* RTC interrupt handling */
-void rtc_enable_interrupt(void);              /* Enable RTC interrupt */
-void rtc_disable_interrupt(void);             /* Disable RTC interrupt */
+void rtc_enable_interrupt(void);              /* Enable periodic interrupt */
+void rtc_disable_interrupt(void);             /* Disable periodic interrupt */
 
 /* Callback type for RTC updates */
 typedef void (*rtc_callback_t)(struct RTCTime* time);
 
-/* Set callback for RTC updates */
+/* Set callback for RTC updates; while set, the update-ended interrupt stays on */
 void rtc_set_callback(rtc_callback_t callback); 
\ No newline at end of file
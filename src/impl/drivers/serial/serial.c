@@ -6,10 +6,96 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdarg.h>
+#include <stdio.h>
 #include "serial.h"
 #include "../port_io/port.h"
+#include "../../kernel/asm_utils.h"
+#include "../../kernel/irq.h"
+
+/*
+ * Per-port state for interrupt-driven operation. Rings are indexed by
+ * free-running 32-bit counters; the producer owns head, the consumer tail.
+ * All updates happen with interrupts off, so one CPU needs no other lock.
+ */
+struct SerialPort {
+    uint16_t base;
+    uint8_t irq;
+    uint8_t interrupts;     /* Interrupt-driven mode enabled */
+    uint8_t ier;            /* Shadow of the interrupt enable register */
+
+    uint32_t tx_head;
+    uint32_t tx_tail;
+    uint32_t rx_head;
+    uint32_t rx_tail;
+    char tx[SERIAL_TX_BUFFER];
+    char rx[SERIAL_RX_BUFFER];
+
+    uint64_t queued;
+    uint64_t tx_dropped;
+    uint64_t rx_dropped;
+    uint64_t overruns;
+};
+
+static struct SerialPort ports[] = {
+    { .base = COM1_PORT, .irq = 4 },
+    { .base = COM2_PORT, .irq = 3 }
+};
+
+#define NUM_PORTS (sizeof(ports) / sizeof(ports[0]))
+
+/* Set by serial_force_sync(); every port polls from then on */
+static int force_sync = 0;
+
+static struct SerialPort* serial_port(uint16_t base) {
+    for (size_t i = 0; i < NUM_PORTS; i++) {
+        if (ports[i].base == base) {
+            return &ports[i];
+        }
+    }
+    return NULL;
+}
+
+/* Port state if it is interrupt-driven right now, else NULL */
+static inline struct SerialPort* serial_async(uint16_t base) {
+    if (force_sync) {
+        return NULL;
+    }
+    struct SerialPort* sp = serial_port(base);
+    return (sp && sp->interrupts) ? sp : NULL;
+}
+
+static inline void serial_set_ier(struct SerialPort* sp, uint8_t ier) {
+    if (sp->ier != ier) {
+        sp->ier = ier;
+        port_byte_out(sp->base + SERIAL_INT_ENABLE, ier);
+    }
+}
+
+/* Stop TX interrupts and push out whatever is still queued by polling */
+static void serial_tx_flush_sync(struct SerialPort* sp) {
+    serial_set_ier(sp, 0);
+    while (sp->tx_tail != sp->tx_head) {
+        while (!(port_byte_in(sp->base + SERIAL_LINE_STATUS) & SERIAL_LSR_THRE));
+        port_byte_out(sp->base, sp->tx[sp->tx_tail & (SERIAL_TX_BUFFER - 1)]);
+        sp->tx_tail++;
+    }
+}
 
 void serial_init(uint16_t port, uint16_t baud) {
+    uint64_t flags = asm_irq_save();
+    struct SerialPort* sp = serial_port(port);
+    if (sp) {
+        /* Re-initialising an interrupt-driven port must not lose queued output */
+        if (sp->interrupts) {
+            serial_tx_flush_sync(sp);
+        }
+        sp->interrupts = 0;
+        sp->ier = 0;
+        sp->tx_head = sp->tx_tail = 0;
+        sp->rx_head = sp->rx_tail = 0;
+    }
+
     /* Disable interrupts */
     port_byte_out(port + SERIAL_INT_ENABLE, 0x00);
 
@@ -24,32 +110,241 @@ void serial_init(uint16_t port, uint16_t baud) {
     port_byte_out(port + SERIAL_LINE_CTRL, SERIAL_LC_8BITS);
 
     /* Enable FIFO, clear them, with 14-byte threshold */
-    port_byte_out(port + SERIAL_INT_ID, 0xC7);
+    port_byte_out(port + SERIAL_INT_ID, SERIAL_FCR_ENABLE | SERIAL_FCR_CLEAR_RX |
+                                        SERIAL_FCR_CLEAR_TX | SERIAL_FCR_TRIG_14);
 
     /* IRQs enabled, RTS/DSR set */
     port_byte_out(port + SERIAL_MODEM_CTRL, 0x0B);
+    asm_irq_restore(flags);
+}
+
+static void serial_irq(struct InterruptFrame* frame, void* ctx) {
+    (void)frame;
+    serial_irq_handler(((struct SerialPort*)ctx)->base);
+}
+
+void serial_enable_interrupts(uint16_t port) {
+    struct SerialPort* sp = serial_port(port);
+    if (!sp) {
+        return;
+    }
+
+    uint64_t flags = asm_irq_save();
+    sp->interrupts = 1;
+    serial_set_ier(sp, SERIAL_IER_RX | SERIAL_IER_LINE);
+    /* Enabling again after serial_init() replaces the earlier registration */
+    irq_unregister(IRQ_VECTOR(sp->irq));
+    irq_register(IRQ_VECTOR(sp->irq), serial_irq, sp);
+    irq_unmask(sp->irq);
+    asm_irq_restore(flags);
+}
+
+/* Load up to a FIFO's worth from the TX ring; the FIFO must be empty */
+static void serial_tx_fill(struct SerialPort* sp) {
+    for (int i = 0; i < SERIAL_FIFO_SIZE && sp->tx_tail != sp->tx_head; i++) {
+        port_byte_out(sp->base + SERIAL_DATA, (uint8_t)sp->tx[sp->tx_tail & (SERIAL_TX_BUFFER - 1)]);
+        sp->tx_tail++;
+    }
+}
+
+/* Start transmission if the THRE interrupt is not already driving it */
+static void serial_tx_kick(struct SerialPort* sp) {
+    if (sp->ier & SERIAL_IER_THRE) {
+        return;
+    }
+    if (port_byte_in(sp->base + SERIAL_LINE_STATUS) & SERIAL_LSR_THRE) {
+        serial_tx_fill(sp);
+    }
+    if (sp->tx_tail != sp->tx_head) {
+        serial_set_ier(sp, sp->ier | SERIAL_IER_THRE);
+    }
+}
+
+static void serial_rx_drain(struct SerialPort* sp) {
+    uint8_t status;
+    while ((status = port_byte_in(sp->base + SERIAL_LINE_STATUS)) & SERIAL_LSR_DATA) {
+        if (status & SERIAL_LSR_OVERRUN) {
+            sp->overruns++;
+        }
+        char c = (char)port_byte_in(sp->base + SERIAL_DATA);
+        if (sp->rx_head - sp->rx_tail < SERIAL_RX_BUFFER) {
+            sp->rx[sp->rx_head & (SERIAL_RX_BUFFER - 1)] = c;
+            sp->rx_head++;
+        } else {
+            sp->rx_dropped++;
+        }
+    }
+}
+
+void serial_irq_handler(uint16_t port) {
+    struct SerialPort* sp = serial_port(port);
+    if (!sp) {
+        return;
+    }
+
+    /* Service every pending cause before returning */
+    uint8_t iir;
+    while (!((iir = port_byte_in(port + SERIAL_INT_ID)) & SERIAL_IIR_NONE)) {
+        switch (iir & SERIAL_IIR_MASK) {
+            case SERIAL_IIR_LINE:
+                if (port_byte_in(port + SERIAL_LINE_STATUS) & SERIAL_LSR_OVERRUN) {
+                    sp->overruns++;
+                }
+                break;
+
+            case SERIAL_IIR_RX:
+            case SERIAL_IIR_TIMEOUT:
+                serial_rx_drain(sp);
+                break;
+
+            case SERIAL_IIR_THRE:
+                serial_tx_fill(sp);
+                if (sp->tx_tail == sp->tx_head) {
+                    serial_set_ier(sp, sp->ier & ~SERIAL_IER_THRE);
+                }
+                break;
+
+            default:
+                port_byte_in(port + SERIAL_MODEM_STATUS);
+                break;
+        }
+    }
 }
 
 int serial_received(uint16_t port) {
-    return port_byte_in(port + SERIAL_LINE_STATUS) & 1;
+    struct SerialPort* sp = serial_async(port);
+    if (sp) {
+        return sp->rx_head != sp->rx_tail;
+    }
+    return port_byte_in(port + SERIAL_LINE_STATUS) & SERIAL_LSR_DATA;
+}
+
+int serial_try_read(uint16_t port) {
+    struct SerialPort* sp = serial_async(port);
+    if (!sp) {
+        return serial_received(port) ? port_byte_in(port) : -1;
+    }
+
+    int c = -1;
+    uint64_t flags = asm_irq_save();
+    if (sp->rx_head != sp->rx_tail) {
+        c = (uint8_t)sp->rx[sp->rx_tail & (SERIAL_RX_BUFFER - 1)];
+        sp->rx_tail++;
+    }
+    asm_irq_restore(flags);
+    return c;
 }
 
 char serial_read(uint16_t port) {
-    while (serial_received(port) == 0);
-    return port_byte_in(port);
+    int c;
+    while ((c = serial_try_read(port)) < 0);
+    return (char)c;
 }
 
 int serial_transmit_empty(uint16_t port) {
-    return port_byte_in(port + SERIAL_LINE_STATUS) & 0x20;
+    return port_byte_in(port + SERIAL_LINE_STATUS) & SERIAL_LSR_THRE;
 }
 
-void serial_write(uint16_t port, char c) {
+static void serial_write_sync(uint16_t port, char c) {
     while (serial_transmit_empty(port) == 0);
     port_byte_out(port, c);
 }
 
+/* Queue a run of bytes; whatever does not fit is dropped and counted */
+void serial_write_bytes(uint16_t port, const void* buffer, size_t len) {
+    const char* data = buffer;
+    struct SerialPort* sp = serial_async(port);
+    if (!sp) {
+        for (size_t i = 0; i < len; i++) {
+            serial_write_sync(port, data[i]);
+        }
+        return;
+    }
+
+    uint64_t flags = asm_irq_save();
+    size_t room = SERIAL_TX_BUFFER - (sp->tx_head - sp->tx_tail);
+    size_t count = len < room ? len : room;
+    for (size_t i = 0; i < count; i++) {
+        sp->tx[sp->tx_head & (SERIAL_TX_BUFFER - 1)] = data[i];
+        sp->tx_head++;
+    }
+    sp->queued += count;
+    sp->tx_dropped += len - count;
+    serial_tx_kick(sp);
+    asm_irq_restore(flags);
+}
+
+void serial_write(uint16_t port, char c) {
+    serial_write_bytes(port, &c, 1);
+}
+
 void serial_write_string(uint16_t port, const char* str) {
-    for (size_t i = 0; str[i] != '\0'; i++) {
-        serial_write(port, str[i]);
+    size_t len = 0;
+    while (str[len] != '\0') {
+        len++;
+    }
+    serial_write_bytes(port, str, len);
+}
+
+void serial_force_sync(void) {
+    asm_cli();
+    force_sync = 1;
+
+    for (size_t i = 0; i < NUM_PORTS; i++) {
+        struct SerialPort* sp = &ports[i];
+        if (!sp->interrupts) {
+            continue;
+        }
+        serial_tx_flush_sync(sp);
+    }
+}
+
+void serial_wait_room(uint16_t port, size_t len) {
+    struct SerialPort* sp;
+    while ((sp = serial_async(port)) && SERIAL_TX_BUFFER - (sp->tx_head - sp->tx_tail) < len) {
+        /* Feed the FIFO directly so this also works with interrupts off */
+        uint64_t flags = asm_irq_save();
+        if (port_byte_in(sp->base + SERIAL_LINE_STATUS) & SERIAL_LSR_THRE) {
+            serial_tx_fill(sp);
+        }
+        asm_irq_restore(flags);
+    }
+}
+
+size_t serial_tx_room(uint16_t port) {
+    struct SerialPort* sp = serial_async(port);
+    if (!sp) {
+        return (size_t)-1;
     }
-} 
\ No newline at end of file
+    return SERIAL_TX_BUFFER - (sp->tx_head - sp->tx_tail);
+}
+
+void serial_get_stats(uint16_t port, struct SerialStats* stats) {
+    struct SerialPort* sp = serial_port(port);
+    if (!sp) {
+        *stats = (struct SerialStats){0};
+        return;
+    }
+
+    uint64_t flags = asm_irq_save();
+    stats->queued = sp->queued;
+    stats->tx_dropped = sp->tx_dropped;
+    stats->rx_dropped = sp->rx_dropped;
+    stats->overruns = sp->overruns;
+    stats->tx_pending = sp->tx_head - sp->tx_tail;
+    stats->rx_pending = sp->rx_head - sp->rx_tail;
+    asm_irq_restore(flags);
+}
+
+/* Formatting sink: ctx carries the port number */
+static void serial_sink(void* ctx, const char* data, size_t len) {
+    serial_write_bytes((uint16_t)(uintptr_t)ctx, data, len);
+}
+
+int serial_printf(uint16_t port, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int ret = format_vprint(serial_sink, (void*)(uintptr_t)port, format, args);
+    va_end(args);
+    return ret;
+}
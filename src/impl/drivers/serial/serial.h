@@ -6,6 +6,7 @@
 
 #pragma once
 #include <stdint.h>
+#include <stddef.h>
 
 /* COM port addresses */
 #define COM1_PORT 0x3F8
@@ -34,6 +35,36 @@
 #define SERIAL_LC_PARITY   0x08    /* Enable parity */
 #define SERIAL_LC_DLAB     0x80    /* Divisor latch access */
 
+/* Interrupt enable bits */
+#define SERIAL_IER_RX       0x01    /* Received data available */
+#define SERIAL_IER_THRE     0x02    /* Transmit holding register empty */
+#define SERIAL_IER_LINE     0x04    /* Receiver line status */
+
+/* Interrupt identification (low nibble of SERIAL_INT_ID) */
+#define SERIAL_IIR_NONE     0x01    /* No interrupt pending */
+#define SERIAL_IIR_MASK     0x0E
+#define SERIAL_IIR_MODEM    0x00
+#define SERIAL_IIR_THRE     0x02
+#define SERIAL_IIR_RX       0x04
+#define SERIAL_IIR_LINE     0x06
+#define SERIAL_IIR_TIMEOUT  0x0C    /* RX FIFO below trigger but idle */
+
+/* FIFO control: enable, clear both, RX interrupt at 14 bytes */
+#define SERIAL_FCR_ENABLE   0x01
+#define SERIAL_FCR_CLEAR_RX 0x02
+#define SERIAL_FCR_CLEAR_TX 0x04
+#define SERIAL_FCR_TRIG_14  0xC0
+#define SERIAL_FIFO_SIZE    16      /* 16550A transmit FIFO depth */
+
+/* Line status bits */
+#define SERIAL_LSR_DATA     0x01    /* Data ready */
+#define SERIAL_LSR_OVERRUN  0x02    /* Receiver FIFO overrun */
+#define SERIAL_LSR_THRE     0x20    /* Transmit FIFO empty */
+
+/* Software rings for interrupt-driven operation; powers of two */
+#define SERIAL_TX_BUFFER    8192
+#define SERIAL_RX_BUFFER    1024
+
 /* Common baud rates */
 #define SERIAL_BAUD_115200 1
 #define SERIAL_BAUD_57600  2
@@ -43,12 +74,49 @@
 #define SERIAL_BAUD_4800   24
 #define SERIAL_BAUD_2400   48
 
+struct SerialStats {
+    uint64_t queued;        /* Bytes accepted into the TX ring */
+    uint64_t tx_dropped;    /* Bytes lost to a full TX ring */
+    uint64_t rx_dropped;    /* Bytes lost to a full RX ring */
+    uint64_t overruns;      /* Hardware FIFO overruns reported by the UART */
+    uint32_t tx_pending;
+    uint32_t rx_pending;
+};
+
 /* Function declarations */
 void serial_init(uint16_t port, uint16_t baud);  /* Initialize serial port */
 void serial_write(uint16_t port, char c);        /* Write character to port */
 char serial_read(uint16_t port);                 /* Read character from port */
+int serial_try_read(uint16_t port);              /* Next byte, or -1 if none */
 int serial_received(uint16_t port);              /* Check if data available */
 int serial_transmit_empty(uint16_t port);        /* Check if transmit buffer empty */
 
+/*
+ * Switch COM1/COM2 to interrupt-driven mode: writes queue into the TX ring
+ * and return at once, the UART interrupt moves bytes in FIFO-sized bursts.
+ * Until this is called, and for other ports, writes poll the UART.
+ */
+void serial_enable_interrupts(uint16_t port);
+
+/* Interrupt handler body for the port's IRQ; the dispatcher sends the EOI */
+void serial_irq_handler(uint16_t port);
+
+/* Panic path: disable interrupts, push out queued bytes by polling and stay synchronous */
+void serial_force_sync(void);
+
+/* Free TX ring space; large when the port is synchronous */
+size_t serial_tx_room(uint16_t port);
+
+/* Block until `len` bytes fit in the TX ring, for bulk dumps */
+void serial_wait_room(uint16_t port, size_t len);
+
+void serial_get_stats(uint16_t port, struct SerialStats* stats);
+
 /* Write string to serial port */
-void serial_write_string(uint16_t port, const char* str); 
\ No newline at end of file
+void serial_write_string(uint16_t port, const char* str);
+
+/* Write raw bytes in one piece; never interleaved with other writers */
+void serial_write_bytes(uint16_t port, const void* data, size_t len);
+
+/* Formatted write to the port; no intermediate buffer */
+int serial_printf(uint16_t port, const char* format, ...);
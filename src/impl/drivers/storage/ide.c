@@ -6,8 +6,11 @@
 
 #include "ide.h"
 #include "../port_io/port.h"
-#include "../serial/serial.h"
+#include "../../kernel/klog.h"
 #include "../../kernel/asm_utils.h"
+#include "../../kernel/delay.h"
+#include "../../kernel/tracepoint.h"
+#include "../../kernel/kstat.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -15,6 +18,11 @@
 /* Maximum number of sectors to transfer at once */
 #define MAX_SECTORS_PER_TRANSFER 256
 
+DEFINE_TRACEPOINT(ide_read, "lba=%llu sectors=%llu");
+
+DEFINE_KSTAT_COUNTER(stat_sectors_read, "ide.sectors_read");
+DEFINE_KSTAT_COUNTER(stat_sectors_written, "ide.sectors_written");
+
 /* Static operations structure */
 static struct StorageDeviceOps ide_ops = {
     .init = NULL,
@@ -26,36 +34,13 @@ static struct StorageDeviceOps ide_ops = {
 
 /* Wait for IDE controller to be ready */
 int ide_wait_ready(uint16_t base) {
-    uint8_t status;
-    int timeout = 100000;  /* Arbitrary timeout value */
-    
-    while (--timeout > 0) {
-        status = port_byte_in(base + 7);
-        if (!(status & IDE_SR_BSY)) {
-            if (status & IDE_SR_DRDY) {
-                return 0;  /* Success */
-            }
-        }
-        port_io_wait();  /* Small delay */
-    }
-    
-    return -1;  /* Timeout */
+    return poll_until((port_byte_in(base + 7) & (IDE_SR_BSY | IDE_SR_DRDY)) == IDE_SR_DRDY,
+                      IDE_READY_TIMEOUT_US);
 }
 
 /* Wait for IDE controller to not be busy */
 int ide_wait_busy(uint16_t base) {
-    uint8_t status;
-    int timeout = 100000;  /* Arbitrary timeout value */
-    
-    while (--timeout > 0) {
-        status = port_byte_in(base + 7);
-        if (!(status & IDE_SR_BSY)) {
-            return 0;  /* Success */
-        }
-        port_io_wait();  /* Small delay */
-    }
-    
-    return -1;  /* Timeout */
+    return poll_until(!(port_byte_in(base + 7) & IDE_SR_BSY), IDE_READY_TIMEOUT_US);
 }
 
 /* Select IDE drive */
@@ -86,7 +71,7 @@ static void ide_read_identify_space(uint16_t* buf, int offset, int length, char*
 /* Identify IDE device */
 int ide_identify(struct IDEDevice* dev) {
     uint16_t identify_data[256] = {0};  // Initialize array to zero
-    int timeout = 100000;
+    uint8_t status = 0;
     
     /* Select drive */
     ide_select_drive(dev);
@@ -99,18 +84,13 @@ int ide_identify(struct IDEDevice* dev) {
     port_byte_out(dev->base + IDE_PRIMARY_COMMAND, IDE_CMD_IDENTIFY);
     
     /* Wait for data or error */
-    while (--timeout > 0) {
-        uint8_t status = port_byte_in(dev->base + IDE_PRIMARY_STATUS);
-        if (status & IDE_SR_ERR) {
-            return -1;  /* Device error */
-        }
-        if (status & IDE_SR_DRQ) {
-            break;  /* Data ready */
-        }
-    }
-    if (timeout == 0) {
+    if (poll_until((status = port_byte_in(dev->base + IDE_PRIMARY_STATUS)) & (IDE_SR_ERR | IDE_SR_DRQ),
+                   IDE_IDENTIFY_TIMEOUT_US) != 0) {
         return -1;  /* Timeout */
     }
+    if (status & IDE_SR_ERR) {
+        return -1;  /* Device error */
+    }
     
     /* Read identify data */
     for (int i = 0; i < 256; i++) {
@@ -147,6 +127,7 @@ int ide_read_sectors(struct IDEDevice* dev, uint64_t lba, uint8_t sectors, void*
     if (!dev || !buffer || sectors == 0) {
         return -1;
     }
+    tracepoint(ide_read, lba, sectors);
     
     /* Select the drive */
     ide_select_drive(dev);
@@ -191,6 +172,7 @@ int ide_read_sectors(struct IDEDevice* dev, uint64_t lba, uint8_t sectors, void*
         
         buf += 256;  /* Next sector */
     }
+    kstat_add(stat_sectors_read, sectors);
     
     return 0;
 }
@@ -250,6 +232,7 @@ int ide_write_sectors(struct IDEDevice* dev, uint64_t lba, uint8_t sectors, cons
             ide_wait_ready(dev->base);
         }
     }
+    kstat_add(stat_sectors_written, sectors);
     
     return 0;
 }
@@ -258,14 +241,14 @@ int ide_write_sectors(struct IDEDevice* dev, uint64_t lba, uint8_t sectors, cons
 struct StorageDevice* ide_init_device(uint16_t base, uint8_t slave) {
     struct StorageDevice* dev = malloc(sizeof(struct StorageDevice));
     if (!dev) {
-        serial_write_string(COM1_PORT, "[IDE] Error: Failed to allocate device structure\n");
+        klog_err("[IDE] Error: Failed to allocate device structure");
         return NULL;
     }
 
     struct IDEDevice* ide_dev = malloc(sizeof(struct IDEDevice));
     if (!ide_dev) {
         free(dev);
-        serial_write_string(COM1_PORT, "[IDE] Error: Failed to allocate IDE structure\n");
+        klog_err("[IDE] Error: Failed to allocate IDE structure");
         return NULL;
     }
 
@@ -285,7 +268,7 @@ struct StorageDevice* ide_init_device(uint16_t base, uint8_t slave) {
     if (ide_identify(ide_dev) != 0) {
         free(ide_dev);
         free(dev);
-        serial_write_string(COM1_PORT, "[IDE] Error: Device identification failed\n");
+        klog_err("[IDE] Error: Device identification failed");
         return NULL;
     }
 
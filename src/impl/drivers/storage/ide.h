@@ -38,6 +38,10 @@
 #define IDE_SR_DRDY 0x40  /* Drive ready */
 #define IDE_SR_BSY  0x80  /* Busy */
 
+/* Status wait timeouts in microseconds; a spun-down disk can stay busy for seconds */
+#define IDE_READY_TIMEOUT_US    2000000
+#define IDE_IDENTIFY_TIMEOUT_US 100000
+
 /* IDE commands */
 #define IDE_CMD_READ_PIO        0x20
 #define IDE_CMD_READ_PIO_EXT    0x24
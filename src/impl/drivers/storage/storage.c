@@ -6,37 +6,53 @@
 
 #include "storage.h"
 #include "../serial/serial.h"
+#include "../../kernel/klog.h"
 #include "../../kernel/asm_utils.h"
 #include <string.h>
 #include <stdio.h>
 
 /* Maximum number of storage devices */
 #define MAX_STORAGE_DEVICES 16
+#define STORAGE_HASH_SLOTS 32
 
-/* Storage device registry */
-static struct StorageDevice* devices[MAX_STORAGE_DEVICES];
+/* Storage device registry: by name, and in registration order */
+static int device_name_match(const struct HashNode* node, const void* key) {
+    const struct StorageDevice* dev = hash_entry(node, struct StorageDevice, name_node);
+    return strcmp(dev->info.name, (const char*)key) == 0;
+}
+
+static struct HashSlot device_slots[STORAGE_HASH_SLOTS];
+static struct HashTable device_names =
+    HASH_TABLE_INIT(device_slots, STORAGE_HASH_SLOTS, device_name_match);
+static struct ListNode devices = LIST_HEAD_INIT(devices);
 static int num_devices = 0;
 
 /* Initialize storage subsystem */
 void storage_init(void) {
-    serial_write_string(COM1_PORT, "[STORAGE] Initializing storage subsystem...\n");
+    klog_info("[STORAGE] Initializing storage subsystem...");
     
     /* Clear device registry */
-    memset(devices, 0, sizeof(devices));
+    hash_init(&device_names, device_slots, STORAGE_HASH_SLOTS, device_name_match);
+    list_init(&devices);
     num_devices = 0;
     
-    serial_write_string(COM1_PORT, "[STORAGE] Storage subsystem initialized\n");
+    klog_info("[STORAGE] Storage subsystem initialized");
 }
 
 /* Register a storage device */
 int storage_register_device(struct StorageDevice* dev) {
     if (!dev) {
-        serial_write_string(COM1_PORT, "[STORAGE] Error: Cannot register NULL device\n");
+        klog_err("[STORAGE] Error: Cannot register NULL device");
         return -1;
     }
     
     if (num_devices >= MAX_STORAGE_DEVICES) {
-        serial_write_string(COM1_PORT, "[STORAGE] Error: Maximum number of devices reached\n");
+        klog_err("[STORAGE] Error: Maximum number of devices reached");
+        return -1;
+    }
+
+    if (storage_get_device(dev->info.name)) {
+        klog_err("[STORAGE] Error: Device name already registered");
         return -1;
     }
     
@@ -44,21 +60,18 @@ int storage_register_device(struct StorageDevice* dev) {
     if (dev->ops && dev->ops->init) {
         int result = dev->ops->init(dev);
         if (result != 0) {
-            char error_msg[64];
-            sprintf(error_msg, "[STORAGE] Error: Device initialization failed: %d\n", result);
-            serial_write_string(COM1_PORT, error_msg);
+            klog_err("[STORAGE] Error: Device initialization failed: %d", result);
             return result;
         }
     }
     
     /* Add to registry */
-    devices[num_devices++] = dev;
+    hash_insert(&device_names, &dev->name_node, hash_string(dev->info.name));
+    list_add_tail(&dev->link, &devices);
+    num_devices++;
     
-    /* Print device info */
-    char info_msg[128];
-    sprintf(info_msg, "[STORAGE] Registered device: %s (%s)\n", 
-            dev->info.name, storage_type_to_string(dev->info.type));
-    serial_write_string(COM1_PORT, info_msg);
+    klog_info("[STORAGE] Registered device: %s (%s)",
+              dev->info.name, storage_type_to_string(dev->info.type));
     
     return 0;
 }
@@ -67,49 +80,39 @@ int storage_register_device(struct StorageDevice* dev) {
 void storage_unregister_device(struct StorageDevice* dev) {
     if (!dev) return;
     
-    /* Find device in registry */
-    for (int i = 0; i < num_devices; i++) {
-        if (devices[i] == dev) {
-            /* Call cleanup if available */
-            if (dev->ops && dev->ops->cleanup) {
-                dev->ops->cleanup(dev);
-            }
-            
-            /* Remove from registry */
-            for (int j = i; j < num_devices - 1; j++) {
-                devices[j] = devices[j + 1];
-            }
-            devices[--num_devices] = NULL;
-            
-            char info_msg[64];
-            sprintf(info_msg, "[STORAGE] Unregistered device: %s\n", dev->info.name);
-            serial_write_string(COM1_PORT, info_msg);
-            return;
-        }
+    /* Only devices currently in the registry */
+    if (storage_get_device(dev->info.name) != dev) return;
+
+    /* Call cleanup if available */
+    if (dev->ops && dev->ops->cleanup) {
+        dev->ops->cleanup(dev);
     }
+
+    /* Remove from registry */
+    hash_remove(&device_names, &dev->name_node);
+    list_del(&dev->link);
+    num_devices--;
+
+    klog_info("[STORAGE] Unregistered device: %s", dev->info.name);
 }
 
 /* Get device by name */
 struct StorageDevice* storage_get_device(const char* name) {
     if (!name) return NULL;
     
-    for (int i = 0; i < num_devices; i++) {
-        if (devices[i] && strcmp(devices[i]->info.name, name) == 0) {
-            return devices[i];
-        }
-    }
-    
-    return NULL;
+    struct HashNode* node = hash_find(&device_names, hash_string(name), name);
+    return node ? hash_entry(node, struct StorageDevice, name_node) : NULL;
 }
 
 /* Get list of storage devices */
 int storage_get_device_list(struct StorageDeviceInfo* list, int max_devices) {
     if (!list || max_devices <= 0) return 0;
     
-    int count = (num_devices < max_devices) ? num_devices : max_devices;
-    
-    for (int i = 0; i < count; i++) {
-        memcpy(&list[i], &devices[i]->info, sizeof(struct StorageDeviceInfo));
+    int count = 0;
+    struct StorageDevice* dev;
+    list_for_each_entry(dev, &devices, link) {
+        if (count >= max_devices) break;
+        memcpy(&list[count++], &dev->info, sizeof(struct StorageDeviceInfo));
     }
     
     return count;
@@ -163,14 +166,14 @@ void storage_print_device_info(struct StorageDeviceInfo* info) {
 
 /* Probe for storage devices */
 struct StorageDevice* storage_probe_devices(void) {
-    serial_write_string(COM1_PORT, "[STORAGE] Probing for storage devices...\n");
+    klog_info("[STORAGE] Probing for storage devices...");
     
     /* TODO: Implement probing for different storage types */
     /* This will be implemented in separate driver files */
     
-    char info_msg[64];
-    sprintf(info_msg, "[STORAGE] Found %d storage devices\n", num_devices);
-    serial_write_string(COM1_PORT, info_msg);
+    klog_info("[STORAGE] Found %d storage devices", num_devices);
     
-    return devices[0]; /* Return first device (usually boot device) */
+    /* Return first device (usually boot device) */
+    struct ListNode* first = list_first(&devices);
+    return first ? list_entry(first, struct StorageDevice, link) : NULL;
 } 
\ No newline at end of file
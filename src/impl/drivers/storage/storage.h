@@ -6,6 +6,8 @@
 
 #pragma once
 #include <stdint.h>
+#include "../../kernel/hashtable.h"
+#include "../../kernel/list.h"
 
 /* Storage device types */
 #define STORAGE_TYPE_UNKNOWN   0
@@ -46,6 +48,8 @@ struct StorageDevice {
     struct StorageDeviceInfo info;
     struct StorageDeviceOps* ops;
     void* private_data;
+    struct HashNode name_node;      /* Registry lookup by name */
+    struct ListNode link;           /* Registry in registration order */
 };
 
 /* Storage manager functions */
@@ -0,0 +1,373 @@
+/**
+ * VGA Text Console Implementation
+ * NansOS Driver System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "console.h"
+#include "../port_io/port.h"
+#include "vga.h"
+#include "../../kernel/asm_utils.h"
+#include <string.h>
+
+#define TAB_WIDTH               8
+
+/* Cursor location past the last displayable cell hides the cursor */
+#define CURSOR_HIDDEN           (CONSOLE_VRAM_ROWS * CONSOLE_COLS)
+
+/*
+ * Lines are numbered from the start of output; line n lives in ring slot
+ * n % CONSOLE_SCROLLBACK. The live screen is lines top .. top + ROWS - 1
+ * and the display shows ROWS lines starting at `view`.
+ */
+struct Console {
+    uint16_t lines[CONSOLE_SCROLLBACK][CONSOLE_COLS];
+    uint32_t top;
+    uint32_t view;
+    uint16_t row;
+    uint16_t col;
+    uint8_t color;
+};
+
+/*
+ * Only the active console owns text memory and the CRTC; the others
+ * just accumulate cells in their rings until switched to.
+ */
+static struct Console consoles[CONSOLE_COUNT];
+static struct Console* active = &consoles[CONSOLE_MAIN];
+static struct Console* output = &consoles[CONSOLE_MAIN];
+static int console_ready = 0;
+
+/*
+ * Text memory is a cache of consecutive lines: VRAM row i holds line
+ * vram_base + i for i < vram_count. Scrolling moves the CRTC start
+ * address down this window; only when the live screen runs off its end
+ * are the on-screen lines copied back to row 0.
+ */
+static uint16_t* const vram = (uint16_t*)CONSOLE_VRAM;
+static uint32_t vram_base = 0;
+static uint32_t vram_count = 0;
+static uint16_t crtc_start = 0;
+static uint16_t crtc_cursor = 0;
+
+static inline uint16_t make_cell(char c, uint8_t color) {
+    return (uint16_t)(uint8_t)c | ((uint16_t)color << 8);
+}
+
+static inline uint16_t* ring_line(struct Console* con, uint32_t line) {
+    return con->lines[line & (CONSOLE_SCROLLBACK - 1)];
+}
+
+static inline uint16_t* vram_line(uint32_t line) {
+    return vram + (line - vram_base) * CONSOLE_COLS;
+}
+
+static inline int vram_has(uint32_t line) {
+    return line >= vram_base && line - vram_base < vram_count;
+}
+
+/* Oldest line still held in the ring */
+static inline uint32_t oldest_line(const struct Console* con) {
+    uint32_t end = con->top + CONSOLE_ROWS;
+    return end > CONSOLE_SCROLLBACK ? end - CONSOLE_SCROLLBACK : 0;
+}
+
+static void fill_cells(uint16_t* cells, uint16_t cell, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        cells[i] = cell;
+    }
+}
+
+static void crtc_write16(uint8_t high_reg, uint16_t value) {
+    port_byte_out(VGA_CRTC_INDEX, high_reg);
+    port_byte_out(VGA_CRTC_DATA, (uint8_t)(value >> 8));
+    port_byte_out(VGA_CRTC_INDEX, high_reg + 1);
+    port_byte_out(VGA_CRTC_DATA, (uint8_t)value);
+}
+
+/* Refill text memory from the ring, starting at `first` */
+static void vram_load(struct Console* con, uint32_t first) {
+    uint32_t end = con->top + CONSOLE_ROWS;
+    if (end - first > CONSOLE_VRAM_ROWS) {
+        end = first + CONSOLE_VRAM_ROWS;
+    }
+
+    vram_base = first;
+    vram_count = end - first;
+    for (uint32_t line = first; line < end; line++) {
+        memcpy(vram_line(line), ring_line(con, line), CONSOLE_COLS * sizeof(uint16_t));
+    }
+}
+
+/* Point the CRTC at the current view, reloading text memory if needed */
+static void update_display(struct Console* con) {
+    uint32_t last = con->view + CONSOLE_ROWS - 1;
+
+    if (!vram_has(con->view) || !vram_has(last)) {
+        if (con->view == con->top) {
+            vram_load(con, con->top);
+        } else {
+            /* Keep as much history as fits, with the live screen at the end */
+            uint32_t end = con->top + CONSOLE_ROWS;
+            uint32_t base = end > CONSOLE_VRAM_ROWS ? end - CONSOLE_VRAM_ROWS : 0;
+            if (base < oldest_line(con)) {
+                base = oldest_line(con);
+            }
+            if (con->view < base) {
+                base = con->view;
+            }
+            vram_load(con, base);
+        }
+    }
+
+    uint16_t start = (uint16_t)((con->view - vram_base) * CONSOLE_COLS);
+    if (start != crtc_start) {
+        crtc_write16(CRTC_START_HIGH, start);
+        crtc_start = start;
+    }
+
+    uint32_t cursor_line = con->top + con->row;
+    uint16_t cursor = CURSOR_HIDDEN;
+    if (vram_has(cursor_line) && con->col < CONSOLE_COLS) {
+        cursor = (uint16_t)((cursor_line - vram_base) * CONSOLE_COLS + con->col);
+    }
+    if (cursor != crtc_cursor) {
+        crtc_write16(CRTC_CURSOR_HIGH, cursor);
+        crtc_cursor = cursor;
+    }
+}
+
+static void console_newline(struct Console* con) {
+    con->col = 0;
+    if (con->row < CONSOLE_ROWS - 1) {
+        con->row++;
+        return;
+    }
+
+    int live = con->view == con->top;
+    con->top++;
+    if (live) {
+        con->view = con->top;
+    } else if (con->view < oldest_line(con)) {
+        con->view = oldest_line(con);
+    }
+
+    uint32_t line = con->top + CONSOLE_ROWS - 1;
+    uint16_t blank = make_cell(' ', con->color);
+    fill_cells(ring_line(con, line), blank, CONSOLE_COLS);
+
+    /* Extend the text window in place while it has room */
+    if (con == active && line == vram_base + vram_count && vram_count < CONSOLE_VRAM_ROWS) {
+        vram_count++;
+        fill_cells(vram_line(line), blank, CONSOLE_COLS);
+    }
+}
+
+/* Store a run of printable characters that fits on the current row */
+static void console_put_run(struct Console* con, const char* data, size_t len) {
+    uint32_t line = con->top + con->row;
+    uint16_t* cells = ring_line(con, line) + con->col;
+
+    for (size_t i = 0; i < len; i++) {
+        cells[i] = make_cell(data[i], con->color);
+    }
+    if (con == active && vram_has(line)) {
+        memcpy(vram_line(line) + con->col, cells, len * sizeof(uint16_t));
+    }
+    con->col += (uint16_t)len;
+}
+
+static void console_write_locked(struct Console* con, const char* data, size_t len) {
+    static const char spaces[TAB_WIDTH] = "        ";
+    size_t i = 0;
+
+    while (i < len) {
+        char c = data[i];
+
+        if (c == '\n') {
+            console_newline(con);
+            i++;
+            continue;
+        }
+        if (c == '\r') {
+            con->col = 0;
+            i++;
+            continue;
+        }
+        if (c == '\b') {
+            if (con->col > 0) {
+                con->col--;
+            }
+            i++;
+            continue;
+        }
+
+        /* Wrap lazily so a full row followed by '\n' leaves no blank line */
+        if (con->col >= CONSOLE_COLS) {
+            console_newline(con);
+        }
+
+        if (c == '\t') {
+            size_t pad = TAB_WIDTH - (con->col % TAB_WIDTH);
+            if (pad > (size_t)(CONSOLE_COLS - con->col)) {
+                pad = CONSOLE_COLS - con->col;
+            }
+            console_put_run(con, spaces, pad);
+            i++;
+            continue;
+        }
+
+        size_t room = CONSOLE_COLS - con->col;
+        size_t run = 0;
+        while (i + run < len && run < room) {
+            char r = data[i + run];
+            if (r == '\n' || r == '\r' || r == '\t' || r == '\b') {
+                break;
+            }
+            run++;
+        }
+        console_put_run(con, data + i, run);
+        i += run;
+    }
+}
+
+void console_init(void) {
+    for (int i = 0; i < CONSOLE_COUNT; i++) {
+        struct Console* con = &consoles[i];
+        if (!con->color) {
+            con->color = VGA_COLOR_WHITE;
+        }
+        uint16_t blank = make_cell(' ', con->color);
+
+        con->top = 0;
+        con->view = 0;
+        con->row = 0;
+        con->col = 0;
+        for (uint32_t line = 0; line < CONSOLE_ROWS; line++) {
+            fill_cells(ring_line(con, line), blank, CONSOLE_COLS);
+        }
+    }
+
+    /* 80-column rows, block-bottom cursor, display at row 0 */
+    port_byte_out(VGA_CRTC_INDEX, CRTC_OFFSET);
+    port_byte_out(VGA_CRTC_DATA, CONSOLE_COLS / 2);
+    port_byte_out(VGA_CRTC_INDEX, CRTC_CURSOR_START);
+    port_byte_out(VGA_CRTC_DATA, 0x0E);
+    port_byte_out(VGA_CRTC_INDEX, CRTC_CURSOR_END);
+    port_byte_out(VGA_CRTC_DATA, 0x0F);
+    crtc_write16(CRTC_START_HIGH, 0);
+    crtc_start = 0;
+    crtc_cursor = CURSOR_HIDDEN;
+
+    vram_load(active, 0);
+    console_ready = 1;
+    update_display(active);
+}
+
+void console_write_to(int index, const char* data, size_t len) {
+    if (index < 0 || index >= CONSOLE_COUNT) {
+        return;
+    }
+
+    uint64_t flags = asm_irq_save();
+    if (!console_ready) {
+        console_init();
+    }
+    struct Console* con = &consoles[index];
+    console_write_locked(con, data, len);
+    if (con == active) {
+        update_display(con);
+    }
+    asm_irq_restore(flags);
+}
+
+void console_write(const char* data, size_t len) {
+    console_write_to((int)(output - consoles), data, len);
+}
+
+/* Push the current screen into the scrollback and start a blank one */
+void console_clear(void) {
+    uint64_t flags = asm_irq_save();
+    if (!console_ready) {
+        console_init();
+    }
+
+    struct Console* con = output;
+    if (con->row || con->col) {
+        con->top += con->row + 1u;
+    }
+    con->view = con->top;
+    con->row = 0;
+    con->col = 0;
+
+    uint16_t blank = make_cell(' ', con->color);
+    for (uint32_t line = con->top; line < con->top + CONSOLE_ROWS; line++) {
+        fill_cells(ring_line(con, line), blank, CONSOLE_COLS);
+    }
+    if (con == active) {
+        vram_load(con, con->top);
+        update_display(con);
+    }
+    asm_irq_restore(flags);
+}
+
+void console_set_color(uint8_t color) {
+    output->color = color;
+}
+
+int console_set_output(int index) {
+    int previous = (int)(output - consoles);
+    if (index >= 0 && index < CONSOLE_COUNT) {
+        output = &consoles[index];
+    }
+    return previous;
+}
+
+/* Show another console: one bulk copy of its visible lines from RAM */
+void console_switch(int index) {
+    if (index < 0 || index >= CONSOLE_COUNT) {
+        return;
+    }
+
+    uint64_t flags = asm_irq_save();
+    if (!console_ready) {
+        console_init();
+    }
+    if (active != &consoles[index]) {
+        active = &consoles[index];
+        vram_count = 0;
+        update_display(active);
+    }
+    asm_irq_restore(flags);
+}
+
+int console_active(void) {
+    return (int)(active - consoles);
+}
+
+void console_scroll(int lines) {
+    uint64_t flags = asm_irq_save();
+    struct Console* con = active;
+
+    if (lines > 0) {
+        uint32_t oldest = oldest_line(con);
+        con->view = con->view - oldest > (uint32_t)lines ? con->view - (uint32_t)lines : oldest;
+    } else if (lines < 0) {
+        uint32_t down = (uint32_t)-lines;
+        con->view = con->top - con->view > down ? con->view + down : con->top;
+    }
+
+    if (console_ready) {
+        update_display(con);
+    }
+    asm_irq_restore(flags);
+}
+
+void console_scroll_reset(void) {
+    uint64_t flags = asm_irq_save();
+    active->view = active->top;
+    if (console_ready) {
+        update_display(active);
+    }
+    asm_irq_restore(flags);
+}
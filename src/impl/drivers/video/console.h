@@ -0,0 +1,57 @@
+/**
+ * VGA Text Console
+ * NansOS Driver System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/* Screen geometry */
+#define CONSOLE_COLS            80
+#define CONSOLE_ROWS            25
+
+/* Lines kept in RAM per console, screen included; power of two */
+#define CONSOLE_SCROLLBACK      512
+
+/* Virtual consoles, switched with Alt+F1..F6 */
+#define CONSOLE_COUNT           6
+#define CONSOLE_MAIN            0       /* Setup wizard and kernel output */
+#define CONSOLE_BOOT_LOG        1       /* Subsystem messages during init */
+#define CONSOLE_DEBUG           2       /* debug_print() output */
+
+/* Rows that fit in the 32KB text window at 0xB8000 */
+#define CONSOLE_VRAM_ROWS       204
+
+/* Text memory and CRTC registers */
+#define CONSOLE_VRAM            0xB8000
+#define CRTC_CURSOR_START       0x0A
+#define CRTC_CURSOR_END         0x0B
+#define CRTC_START_HIGH         0x0C
+#define CRTC_START_LOW          0x0D
+#define CRTC_CURSOR_HIGH        0x0E
+#define CRTC_CURSOR_LOW         0x0F
+#define CRTC_OFFSET             0x13
+
+/* Set up the text window, hardware cursor and an empty screen */
+void console_init(void);
+
+/* Write a run of text to the output console; handles \n, \r, \t and \b */
+void console_write(const char* data, size_t len);
+void console_clear(void);
+void console_set_color(uint8_t color);
+
+/* Write to a specific console; background consoles only update RAM */
+void console_write_to(int index, const char* data, size_t len);
+
+/* Select where console_write() goes; returns the previous console */
+int console_set_output(int index);
+
+/* Display another console */
+void console_switch(int index);
+int console_active(void);
+
+/* Scrollback view of the displayed console: positive moves towards older output */
+void console_scroll(int lines);
+void console_scroll_reset(void);
@@ -6,8 +6,11 @@
 
 #include "vga.h"
 #include "../port_io/port.h"
-#include "../serial/serial.h"
+#include "../../kernel/klog.h"
 #include "../../kernel/asm_utils.h"
+#include "../../kernel/string_simd.h"
+#include "../../kernel/alternative.h"
+#include "../../kernel/sysinfo.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -23,6 +26,15 @@ static struct VGAMode current_mode;
 static uint8_t* front_buffer = (uint8_t*)VGA_MEMORY_BASE;
 static uint8_t back_buffer[VGA_MEMORY_SIZE];
 
+/* Back-buffer fill and swap; patched to the SSE2 kernels at boot */
+void* vga_fill(void* dest, int color, size_t n);
+void* vga_copy(void* dest, const void* src, size_t n);
+
+ALTERNATIVE_ENTRY(vga_fill, memset);
+ALTERNATIVE_VARIANT(vga_fill, memset_sse2, CPU_FEATURE_SSE2, 1);
+ALTERNATIVE_ENTRY(vga_copy, memcpy);
+ALTERNATIVE_VARIANT(vga_copy, memcpy_sse2, CPU_FEATURE_SSE2, 1);
+
 /* Window system colors */
 #define WINDOW_BORDER_COLOR     VGA_COLOR_LIGHT_GRAY
 #define WINDOW_TITLE_COLOR      VGA_COLOR_BLUE
@@ -32,7 +44,7 @@ static uint8_t back_buffer[VGA_MEMORY_SIZE];
 
 /* Initialize VGA */
 void vga_init(void) {
-    serial_write_string(COM1_PORT, "[VGA] Initializing graphics system...\n");
+    klog_info("[VGA] Initializing graphics system...");
     
     /* Initialize VGA registers */
     port_byte_out(0x3C2, 0x63);  /* Miscellaneous output register */
@@ -54,7 +66,7 @@ void vga_init(void) {
     memset(back_buffer, 0, VGA_MEMORY_SIZE);
     memset((void*)VGA_MEMORY_BASE, 0, VGA_MEMORY_SIZE);
     
-    serial_write_string(COM1_PORT, "[VGA] Graphics system initialized\n");
+    klog_info("[VGA] Graphics system initialized");
 }
 
 /* Set VGA mode */
@@ -96,7 +108,7 @@ int vga_set_mode(uint8_t mode) {
             break;
             
         default:
-            serial_write_string(COM1_PORT, "[VGA] Error: Unsupported video mode\n");
+            klog_err("[VGA] Error: Unsupported video mode");
             return -1;
     }
     
@@ -107,7 +119,7 @@ int vga_set_mode(uint8_t mode) {
     memset(back_buffer, 0, VGA_MEMORY_SIZE);
     memset((void*)VGA_MEMORY_BASE, 0, VGA_MEMORY_SIZE);
     
-    serial_write_string(COM1_PORT, "[VGA] Video mode set successfully\n");
+    klog_info("[VGA] Video mode set successfully");
     return 0;
 }
 
@@ -150,12 +162,12 @@ void vga_draw_line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint8_t c
 
 /* Clear the screen */
 void vga_clear_screen(uint8_t color) {
-    memset(back_buffer, color, VGA_MEMORY_SIZE);
+    vga_fill(back_buffer, color, VGA_MEMORY_SIZE);
 }
 
 /* Swap front and back buffers */
 void vga_swap_buffers(void) {
-    memcpy(front_buffer, back_buffer, VGA_MEMORY_SIZE);
+    vga_copy(front_buffer, back_buffer, VGA_MEMORY_SIZE);
 }
 
 /* Draw text in graphics mode */
@@ -6,7 +6,9 @@
 
 #include "window.h"
 #include "vga.h"
-#include "../serial/serial.h"
+#include "../../kernel/klog.h"
+#include "../../kernel/tracepoint.h"
+#include "../../kernel/kstat.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -18,14 +20,18 @@
 #define WINDOW_BACKGROUND_COLOR VGA_COLOR_WHITE
 #define TASKBAR_COLOR         VGA_COLOR_DARK_GRAY
 
-/* Window list */
-static struct Window* windows[MAX_WINDOWS];
+/* Window stack: head is the bottom, tail is the topmost window */
+static struct ListNode windows = LIST_HEAD_INIT(windows);
 static int num_windows = 0;
 static struct Window* active_window = NULL;
 static struct Window* dragging_window = NULL;
 static int drag_offset_x = 0;
 static int drag_offset_y = 0;
 
+DEFINE_TRACEPOINT(window_update, "windows=%llu active=0x%llx");
+
+DEFINE_KSTAT_COUNTER(stat_frames, "gui.frames");
+
 /* Terminal buffer */
 #define TERMINAL_BUFFER_SIZE 1024
 struct TerminalBuffer {
@@ -35,10 +41,10 @@ struct TerminalBuffer {
 
 /* Initialize window manager */
 void window_init(void) {
-    serial_write_string(COM1_PORT, "[WINDOW] Initializing window manager...\n");
+    klog_info("[WINDOW] Initializing window manager...");
     
     /* Initialize window list */
-    memset(windows, 0, sizeof(windows));
+    list_init(&windows);
     num_windows = 0;
     active_window = NULL;
     dragging_window = NULL;
@@ -46,19 +52,25 @@ void window_init(void) {
     /* Initialize in text mode first */
     vga_init();
     
-    serial_write_string(COM1_PORT, "[WINDOW] Window manager initialized\n");
+    klog_info("[WINDOW] Window manager initialized");
+}
+
+/* Topmost window, or NULL when none are open */
+static struct Window* top_window(void) {
+    struct ListNode* last = list_last(&windows);
+    return last ? list_entry(last, struct Window, link) : NULL;
 }
 
 /* Create a new window */
 struct Window* window_create(const char* title, uint16_t x, uint16_t y, uint16_t width, uint16_t height) {
     if (num_windows >= MAX_WINDOWS) {
-        serial_write_string(COM1_PORT, "[WINDOW] Error: Maximum number of windows reached\n");
+        klog_err("[WINDOW] Error: Maximum number of windows reached");
         return NULL;
     }
     
     struct Window* window = (struct Window*)malloc(sizeof(struct Window));
     if (!window) {
-        serial_write_string(COM1_PORT, "[WINDOW] Error: Failed to allocate window structure\n");
+        klog_err("[WINDOW] Error: Failed to allocate window structure");
         return NULL;
     }
     
@@ -76,7 +88,8 @@ struct Window* window_create(const char* title, uint16_t x, uint16_t y, uint16_t
     window->on_key = NULL;
     
     /* Add to window list */
-    windows[num_windows++] = window;
+    list_add_tail(&window->link, &windows);
+    num_windows++;
     
     /* Make it the active window */
     window_bring_to_front(window);
@@ -89,27 +102,22 @@ void window_destroy(struct Window* window) {
     if (!window) return;
     
     /* Remove from window list */
-    for (int i = 0; i < num_windows; i++) {
-        if (windows[i] == window) {
-            /* Shift remaining windows */
-            for (int j = i; j < num_windows - 1; j++) {
-                windows[j] = windows[j + 1];
-            }
-            windows[--num_windows] = NULL;
-            
-            /* Update active window if needed */
-            if (active_window == window) {
-                active_window = (num_windows > 0) ? windows[num_windows - 1] : NULL;
-            }
-            
-            /* Free window resources */
-            if (window->content) {
-                free(window->content);
-            }
-            free(window);
-            break;
-        }
+    list_del(&window->link);
+    num_windows--;
+
+    /* Update active window if needed */
+    if (active_window == window) {
+        active_window = top_window();
+    }
+    if (dragging_window == window) {
+        dragging_window = NULL;
+    }
+
+    /* Free window resources */
+    if (window->content) {
+        free(window->content);
     }
+    free(window);
 }
 
 /* Show a window */
@@ -124,7 +132,7 @@ void window_hide(struct Window* window) {
     if (!window) return;
     window->flags &= ~WINDOW_FLAG_VISIBLE;
     if (active_window == window) {
-        active_window = (num_windows > 0) ? windows[num_windows - 1] : NULL;
+        active_window = top_window();
     }
 }
 
@@ -146,18 +154,9 @@ void window_resize(struct Window* window, uint16_t width, uint16_t height) {
 void window_bring_to_front(struct Window* window) {
     if (!window) return;
     
-    /* Find window in list */
-    for (int i = 0; i < num_windows; i++) {
-        if (windows[i] == window) {
-            /* Move to end of list */
-            for (int j = i; j < num_windows - 1; j++) {
-                windows[j] = windows[j + 1];
-            }
-            windows[num_windows - 1] = window;
-            active_window = window;
-            break;
-        }
-    }
+    /* Move to the top of the stack */
+    list_move_tail(&window->link, &windows);
+    active_window = window;
 }
 
 /* Minimize window */
@@ -198,8 +197,8 @@ void window_handle_mouse(uint16_t x, uint16_t y, uint8_t buttons) {
     }
     
     /* Check for window interactions */
-    for (int i = num_windows - 1; i >= 0; i--) {
-        struct Window* window = windows[i];
+    struct Window* window;
+    list_for_each_entry_reverse(window, &windows, link) {
         if (!(window->flags & WINDOW_FLAG_VISIBLE)) continue;
         
         /* Check if click is in window */
@@ -238,6 +237,9 @@ void window_handle_key(char key) {
 
 /* Update all windows */
 void window_update(void) {
+    kstat_inc(stat_frames);
+    tracepoint(window_update, num_windows, active_window);
+
     /* Clear screen */
     vga_clear_screen(DESKTOP_COLOR);
     
@@ -245,8 +247,8 @@ void window_update(void) {
     vga_draw_taskbar();
     
     /* Draw all windows */
-    for (int i = 0; i < num_windows; i++) {
-        struct Window* window = windows[i];
+    struct Window* window;
+    list_for_each_entry(window, &windows, link) {
         if (!(window->flags & WINDOW_FLAG_VISIBLE)) continue;
         
         /* Draw window frame */
@@ -347,12 +349,12 @@ struct Window* window_create_text_editor(void) {
 
 /* Initialize graphical interface */
 void window_init_gui(void) {
-    serial_write_string(COM1_PORT, "[WINDOW] Initializing graphical interface...\n");
+    klog_info("[WINDOW] Initializing graphical interface...");
     
     /* Get current VGA mode */
     const struct VGAMode* mode = vga_get_mode();
     if (!mode) {
-        serial_write_string(COM1_PORT, "[WINDOW] Error: No VGA mode set\n");
+        klog_err("[WINDOW] Error: No VGA mode set");
         return;
     }
     
@@ -378,5 +380,5 @@ void window_init_gui(void) {
     /* Initial screen update */
     vga_swap_buffers();
     
-    serial_write_string(COM1_PORT, "[WINDOW] Graphical interface initialized\n");
+    klog_info("[WINDOW] Graphical interface initialized");
 } 
\ No newline at end of file
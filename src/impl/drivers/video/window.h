@@ -6,6 +6,7 @@
 
 #pragma once
 #include <stdint.h>
+#include "../../kernel/list.h"
 
 /* Maximum number of windows */
 #define MAX_WINDOWS 16
@@ -29,6 +30,7 @@ struct Window {
     void (*on_paint)(struct Window* window);
     void (*on_click)(struct Window* window, uint16_t x, uint16_t y);
     void (*on_key)(struct Window* window, char key);
+    struct ListNode link;           /* Z-order position, bottom to top */
 };
 
 /* Window manager functions */
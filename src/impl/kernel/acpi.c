@@ -0,0 +1,131 @@
+/**
+ * ACPI Table Discovery Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "acpi.h"
+#include "mmu.h"
+#include "klog.h"
+#include <string.h>
+
+#define RSDP_SIGNATURE      "RSD PTR "
+#define EBDA_SEGMENT_PTR    0x40E       /* BDA word holding the EBDA segment */
+#define BIOS_AREA_START     0xE0000
+#define BIOS_AREA_END       0x100000
+
+struct RSDP {
+    char signature[8];
+    uint8_t checksum;           /* Covers the first 20 bytes */
+    char oem_id[6];
+    uint8_t revision;           /* 0 for ACPI 1.0, 2 and up have the XSDT */
+    uint32_t rsdt_address;
+    uint32_t length;
+    uint64_t xsdt_address;
+    uint8_t extended_checksum;
+    uint8_t reserved[3];
+} __attribute__((packed));
+
+static const struct ACPITableHeader* root_table = NULL;
+static int root_entry_size = 0;     /* 8 for the XSDT, 4 for the RSDT */
+
+static uint8_t checksum(const void* data, uint32_t length) {
+    const uint8_t* bytes = data;
+    uint8_t sum = 0;
+    for (uint32_t i = 0; i < length; i++) {
+        sum += bytes[i];
+    }
+    return sum;
+}
+
+static const struct RSDP* rsdp_scan(uint64_t start, uint64_t end) {
+    for (uint64_t addr = start; addr + sizeof(struct RSDP) <= end; addr += 16) {
+        const struct RSDP* rsdp = (const struct RSDP*)addr;
+        if (memcmp(rsdp->signature, RSDP_SIGNATURE, 8) == 0 && checksum(rsdp, 20) == 0) {
+            return rsdp;
+        }
+    }
+    return NULL;
+}
+
+/* Tables may sit above the boot identity map; map the header, then the rest */
+static const struct ACPITableHeader* map_table(uint64_t phys) {
+    const struct ACPITableHeader* table = mmu_map_mmio(phys, sizeof(struct ACPITableHeader));
+    if (!table) {
+        return NULL;
+    }
+    if (!mmu_map_mmio(phys, table->length) || checksum(table, table->length) != 0) {
+        klog_warn("[ACPI] Bad table at 0x%llx", (unsigned long long)phys);
+        return NULL;
+    }
+    return table;
+}
+
+int acpi_init(void) {
+    const struct RSDP* rsdp = NULL;
+    uint16_t segment;
+
+    memcpy(&segment, (const void*)EBDA_SEGMENT_PTR, sizeof(segment));
+    uint64_t ebda = (uint64_t)segment << 4;
+
+    if (ebda >= 0x80000 && ebda < 0xA0000) {
+        rsdp = rsdp_scan(ebda, ebda + 1024);
+    }
+    if (!rsdp) {
+        rsdp = rsdp_scan(BIOS_AREA_START, BIOS_AREA_END);
+    }
+    if (!rsdp) {
+        klog_warn("[ACPI] No RSDP found");
+        return -1;
+    }
+
+    if (rsdp->revision >= 2 && rsdp->xsdt_address &&
+        checksum(rsdp, rsdp->length) == 0) {
+        root_table = map_table(rsdp->xsdt_address);
+        root_entry_size = 8;
+    }
+    if (!root_table) {
+        root_table = map_table(rsdp->rsdt_address);
+        root_entry_size = 4;
+    }
+    if (!root_table) {
+        return -1;
+    }
+
+    klog_info("[ACPI] %.4s revision %u, %u tables", root_table->signature, rsdp->revision,
+              (unsigned)((root_table->length - sizeof(*root_table)) / root_entry_size));
+    return 0;
+}
+
+const struct ACPITableHeader* acpi_find_table(const char* signature) {
+    if (!root_table) {
+        return NULL;
+    }
+
+    const uint8_t* entries = (const uint8_t*)(root_table + 1);
+    uint32_t count = (root_table->length - sizeof(*root_table)) / root_entry_size;
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t phys = 0;
+        memcpy(&phys, entries + i * root_entry_size, root_entry_size);
+
+        const struct ACPITableHeader* table = mmu_map_mmio(phys, sizeof(*table));
+        if (table && memcmp(table->signature, signature, 4) == 0) {
+            return map_table(phys);
+        }
+    }
+    return NULL;
+}
+
+const struct ACPIMADTEntry* acpi_madt_next(const struct ACPIMADT* madt,
+                                           const struct ACPIMADTEntry* entry) {
+    const uint8_t* end = (const uint8_t*)madt + madt->header.length;
+    const uint8_t* next = entry ? (const uint8_t*)entry + entry->length : (const uint8_t*)(madt + 1);
+
+    /* A zero length would loop forever; treat it as the end */
+    if ((entry && entry->length == 0) || next + sizeof(struct ACPIMADTEntry) > end) {
+        return NULL;
+    }
+    entry = (const struct ACPIMADTEntry*)next;
+    return next + entry->length <= end ? entry : NULL;
+}
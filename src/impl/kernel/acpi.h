@@ -0,0 +1,102 @@
+/**
+ * ACPI Table Discovery
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+
+/* Common header of every system description table */
+struct ACPITableHeader {
+    char signature[4];
+    uint32_t length;            /* Whole table, header included */
+    uint8_t revision;
+    uint8_t checksum;           /* All bytes of the table sum to zero */
+    char oem_id[6];
+    char oem_table_id[8];
+    uint32_t oem_revision;
+    uint32_t creator_id;
+    uint32_t creator_revision;
+} __attribute__((packed));
+
+/* Register location as used by HPET, FADT and friends */
+struct ACPIGenericAddress {
+    uint8_t space_id;           /* ACPI_SPACE_* */
+    uint8_t bit_width;
+    uint8_t bit_offset;
+    uint8_t access_size;
+    uint64_t address;
+} __attribute__((packed));
+
+#define ACPI_SPACE_MEMORY   0
+#define ACPI_SPACE_IO       1
+
+/* Multiple APIC Description Table ("APIC"); variable-length entries follow */
+struct ACPIMADT {
+    struct ACPITableHeader header;
+    uint32_t lapic_address;     /* Superseded by an ACPI_MADT_LAPIC_ADDRESS entry */
+    uint32_t flags;
+} __attribute__((packed));
+
+#define ACPI_MADT_PCAT_COMPAT       (1 << 0)    /* Dual 8259s are present as well */
+
+struct ACPIMADTEntry {
+    uint8_t type;               /* ACPI_MADT_* */
+    uint8_t length;             /* Whole entry, header included */
+} __attribute__((packed));
+
+#define ACPI_MADT_LAPIC             0
+#define ACPI_MADT_IOAPIC            1
+#define ACPI_MADT_OVERRIDE          2
+#define ACPI_MADT_LAPIC_NMI         4
+#define ACPI_MADT_LAPIC_ADDRESS     5
+
+struct ACPIMADTIOAPIC {
+    struct ACPIMADTEntry entry;
+    uint8_t id;
+    uint8_t reserved;
+    uint32_t address;
+    uint32_t gsi_base;          /* First global system interrupt of its pins */
+} __attribute__((packed));
+
+/* An ISA IRQ wired to a different GSI or with non-ISA polarity/trigger */
+struct ACPIMADTOverride {
+    struct ACPIMADTEntry entry;
+    uint8_t bus;                /* Always 0, ISA */
+    uint8_t source;             /* ISA IRQ */
+    uint32_t gsi;
+    uint16_t flags;             /* ACPI_MADT_POLARITY_* | ACPI_MADT_TRIGGER_* */
+} __attribute__((packed));
+
+struct ACPIMADTLAPICNMI {
+    struct ACPIMADTEntry entry;
+    uint8_t processor;          /* ACPI processor ID, 0xFF for all */
+    uint16_t flags;
+    uint8_t lint;               /* LINT0 or LINT1 */
+} __attribute__((packed));
+
+struct ACPIMADTLAPICAddress {
+    struct ACPIMADTEntry entry;
+    uint16_t reserved;
+    uint64_t address;
+} __attribute__((packed));
+
+/* MPS INTI flags; "conforms" means the bus default (ISA: active high, edge) */
+#define ACPI_MADT_POLARITY_MASK     0x3
+#define ACPI_MADT_POLARITY_LOW      0x3
+#define ACPI_MADT_TRIGGER_MASK      0xC
+#define ACPI_MADT_TRIGGER_LEVEL     0xC
+
+/*
+ * Find the RSDP in the EBDA or the BIOS area and validate the RSDT/XSDT.
+ * Returns 0 on success, -1 if the firmware provides no ACPI tables.
+ */
+int acpi_init(void);
+
+/* First table with the 4-character signature (e.g. "HPET"), or NULL */
+const struct ACPITableHeader* acpi_find_table(const char* signature);
+
+/* MADT entry after `entry` (NULL for the first), or NULL past the end */
+const struct ACPIMADTEntry* acpi_madt_next(const struct ACPIMADT* madt,
+                                           const struct ACPIMADTEntry* entry);
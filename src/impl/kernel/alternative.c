@@ -0,0 +1,95 @@
+/**
+ * Boot-Time Code Alternatives Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "alternative.h"
+#include "asm_utils.h"
+#include "sysinfo.h"
+#include "../drivers/serial/serial.h"
+
+#define CR0_WP          (1 << 16)
+#define OPCODE_CALL     0xE8
+#define OPCODE_JMP      0xE9
+
+/* Provided by the linker script */
+extern const struct AltEntry __alternatives_start[];
+extern const struct AltEntry __alternatives_end[];
+
+void text_poke(void* addr, const void* bytes, size_t len) {
+    uint32_t eax, ebx, ecx, edx;
+    uint64_t flags = asm_irq_save();
+    uint64_t cr0 = asm_read_cr0();
+
+    /* Kernel text may be mapped read-only once page protections exist */
+    if (cr0 & CR0_WP) {
+        asm_write_cr0(cr0 & ~(uint64_t)CR0_WP);
+    }
+    /* Byte copy: memcpy itself may be the entry being patched */
+    volatile uint8_t* dst = (volatile uint8_t*)addr;
+    const uint8_t* src = (const uint8_t*)bytes;
+    for (size_t i = 0; i < len; i++) {
+        dst[i] = src[i];
+    }
+    if (cr0 & CR0_WP) {
+        asm_write_cr0(cr0);
+    }
+
+    /* Serialize so the new bytes are fetched, not stale decoded ones */
+    asm_cpuid(0, &eax, &ebx, &ecx, &edx);
+    asm_irq_restore(flags);
+}
+
+int text_patch_branch(uint64_t site, uint64_t target) {
+    uint8_t* insn = (uint8_t*)(uintptr_t)site;
+    int64_t rel = (int64_t)(target - (site + 5));
+
+    if ((insn[0] != OPCODE_JMP && insn[0] != OPCODE_CALL) ||
+        rel < INT32_MIN || rel > INT32_MAX) {
+        return -1;
+    }
+
+    int32_t rel32 = (int32_t)rel;
+    text_poke(insn + 1, &rel32, sizeof(rel32));
+    return 0;
+}
+
+/* True if another eligible entry for the same site should win */
+static int alt_superseded(const struct AltEntry* entry, uint64_t features) {
+    for (const struct AltEntry* other = __alternatives_start; other < __alternatives_end; other++) {
+        if (other == entry || other->site != entry->site) {
+            continue;
+        }
+        if ((features & other->features) != other->features) {
+            continue;
+        }
+        if (other->priority > entry->priority ||
+            (other->priority == entry->priority && other > entry)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void alternatives_apply(void) {
+    uint64_t features = sysinfo_get()->cpu.features;
+    int patched = 0;
+
+    for (const struct AltEntry* entry = __alternatives_start; entry < __alternatives_end; entry++) {
+        if ((features & entry->features) != entry->features) {
+            continue;
+        }
+        if (alt_superseded(entry, features)) {
+            continue;
+        }
+        if (text_patch_branch(entry->site, entry->target) != 0) {
+            serial_printf(COM1_PORT, "[ALT] Bad patch site 0x%llx\n", entry->site);
+            continue;
+        }
+        patched++;
+    }
+
+    serial_printf(COM1_PORT, "[ALT] Applied %d of %d alternatives\n", patched,
+                  (int)(__alternatives_end - __alternatives_start));
+}
@@ -0,0 +1,53 @@
+/**
+ * Boot-Time Code Alternatives
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/* One candidate implementation for a patchable entry point */
+struct AltEntry {
+    uint64_t site;          /* Address of the rel32 jmp/call to patch */
+    uint64_t target;        /* Replacement implementation */
+    uint64_t features;      /* CPU_FEATURE_* bits the target requires */
+    uint64_t priority;      /* Highest eligible priority wins */
+};
+
+#define ALT_STRINGIFY(x) #x
+
+/*
+ * Defines `name` as an 8-byte aligned `jmp rel32` to `fallback`. Callers
+ * call `name` directly; alternatives_apply() rewrites the displacement
+ * once at boot, so each call costs one direct, perfectly predicted jump.
+ * The prototype of `name` must be declared separately.
+ */
+#define ALTERNATIVE_ENTRY(name, fallback)                       \
+    __asm__(".pushsection .text\n"                              \
+            ".balign 8\n"                                       \
+            ".globl " ALT_STRINGIFY(name) "\n"                  \
+            ".type " ALT_STRINGIFY(name) ", @function\n"        \
+            ALT_STRINGIFY(name) ":\n"                           \
+            ".byte 0xE9\n"                                      \
+            ".long " ALT_STRINGIFY(fallback) " - . - 4\n"       \
+            ".size " ALT_STRINGIFY(name) ", 5\n"                \
+            ".popsection\n")
+
+/* Records `impl` as the target of `name` on CPUs with `feature_bits` */
+#define ALTERNATIVE_VARIANT(name, impl, feature_bits, prio)                 \
+    static const struct AltEntry __alt_##name##_##impl                      \
+        __attribute__((section(".alternatives"), used, aligned(8))) = {     \
+        (uint64_t)(uintptr_t)name, (uint64_t)(uintptr_t)impl,               \
+        (uint64_t)(feature_bits), (uint64_t)(prio)                          \
+    }
+
+/* Patch every recorded site for the detected CPU; call after sysinfo_init */
+void alternatives_apply(void);
+
+/* Write to kernel text with interrupts off; serializes afterwards */
+void text_poke(void* addr, const void* bytes, size_t len);
+
+/* Retarget the rel32 jmp/call at `site`; returns -1 if it is not one */
+int text_patch_branch(uint64_t site, uint64_t target);
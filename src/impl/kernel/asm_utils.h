@@ -6,6 +6,7 @@
 
 #pragma once
 #include <stdint.h>
+#include "static_key.h"
 
 /* GCC/Clang inline assembly */
 #if defined(__GNUC__) || defined(__clang__)
@@ -44,6 +45,25 @@ static inline void asm_cpuid(uint32_t leaf, uint32_t* eax, uint32_t* ebx, uint32
 #endif
 }
 
+/* CPUID with a sub-leaf in ECX */
+static inline void asm_cpuid_count(uint32_t leaf, uint32_t subleaf, uint32_t* eax, uint32_t* ebx, uint32_t* ecx, uint32_t* edx) {
+#if defined(HAVE_INTRINSICS)
+    int cpu_info[4];
+    __cpuidex(cpu_info, leaf, subleaf);
+    *eax = cpu_info[0];
+    *ebx = cpu_info[1];
+    *ecx = cpu_info[2];
+    *edx = cpu_info[3];
+#elif defined(HAVE_INLINE_ASM)
+    ASM_INLINE (
+        "cpuid"
+        : "=a" (*eax), "=b" (*ebx), "=c" (*ecx), "=d" (*edx)
+        : "a" (leaf), "c" (subleaf)
+        : "memory"
+    );
+#endif
+}
+
 /* Read MSR operation */
 static inline uint64_t asm_rdmsr(uint32_t msr) {
 #if defined(HAVE_INTRINSICS)
@@ -171,15 +191,30 @@ static inline uint32_t asm_inl(uint16_t port) {
 
 /* Additional x86_64 specific operations */
 #ifdef __x86_64__
+
+/*
+ * IRQ-off span tracing (irqstat.h). The hooks sit behind a static key,
+ * so each costs one NOP while tracing is off.
+ */
+extern struct StaticKey irqoff_trace_key;
+void irqoff_trace_begin(void);
+void irqoff_trace_end(void);
+
 static inline void asm_cli(void) {
 #if defined(HAVE_INTRINSICS)
     _disable();
 #elif defined(HAVE_INLINE_ASM)
     ASM_INLINE ("cli" ::: "memory");
 #endif
+    if (static_key_false(&irqoff_trace_key)) {
+        irqoff_trace_begin();
+    }
 }
 
 static inline void asm_sti(void) {
+    if (static_key_false(&irqoff_trace_key)) {
+        irqoff_trace_end();
+    }
 #if defined(HAVE_INTRINSICS)
     _enable();
 #elif defined(HAVE_INLINE_ASM)
@@ -195,12 +230,47 @@ static inline void asm_hlt(void) {
 #endif
 }
 
+/* Enable interrupts and halt; the sti shadow means no wakeup is lost in between */
+static inline void asm_safe_halt(void) {
+    if (static_key_false(&irqoff_trace_key)) {
+        irqoff_trace_end();
+    }
+#if defined(HAVE_INTRINSICS)
+    _enable();
+    __halt();
+#elif defined(HAVE_INLINE_ASM)
+    ASM_INLINE ("sti\n\thlt" ::: "memory");
+#endif
+}
+
+/* Spin-wait hint: saves power and avoids the memory-order flush on loop exit */
+static inline void asm_pause(void) {
+#if defined(HAVE_INTRINSICS)
+    _mm_pause();
+#elif defined(HAVE_INLINE_ASM)
+    ASM_INLINE ("pause" ::: "memory");
+#endif
+}
+
+/* Read the time-stamp counter */
+static inline uint64_t asm_rdtsc(void) {
+#if defined(HAVE_INTRINSICS)
+    return __rdtsc();
+#elif defined(HAVE_INLINE_ASM)
+    uint32_t low, high;
+    ASM_INLINE ("rdtsc" : "=a" (low), "=d" (high));
+    return ((uint64_t)high << 32) | low;
+#else
+    return 0;
+#endif
+}
+
 static inline uint64_t asm_read_cr0(void) {
 #if defined(HAVE_INTRINSICS)
     return __readcr0();
 #elif defined(HAVE_INLINE_ASM)
     uint64_t cr0;
-    ASM_INLINE ("mov %%cr0, %0" : "=r" (cr0) :: "memory");
+    ASM_INLINE ("mov %0, cr0" : "=r" (cr0) :: "memory");
     return cr0;
 #else
     return 0;
@@ -211,7 +281,7 @@ static inline void asm_write_cr0(uint64_t value) {
 #if defined(HAVE_INTRINSICS)
     __writecr0(value);
 #elif defined(HAVE_INLINE_ASM)
-    ASM_INLINE ("mov %0, %%cr0" :: "r" (value) : "memory");
+    ASM_INLINE ("mov cr0, %0" :: "r" (value) : "memory");
 #endif
 }
 
@@ -220,7 +290,7 @@ static inline uint64_t asm_read_cr2(void) {
     return __readcr2();
 #elif defined(HAVE_INLINE_ASM)
     uint64_t cr2;
-    ASM_INLINE ("mov %%cr2, %0" : "=r" (cr2) :: "memory");
+    ASM_INLINE ("mov %0, cr2" : "=r" (cr2) :: "memory");
     return cr2;
 #else
     return 0;
@@ -232,7 +302,7 @@ static inline uint64_t asm_read_cr3(void) {
     return __readcr3();
 #elif defined(HAVE_INLINE_ASM)
     uint64_t cr3;
-    ASM_INLINE ("mov %%cr3, %0" : "=r" (cr3) :: "memory");
+    ASM_INLINE ("mov %0, cr3" : "=r" (cr3) :: "memory");
     return cr3;
 #else
     return 0;
@@ -243,10 +313,86 @@ static inline void asm_write_cr3(uint64_t value) {
 #if defined(HAVE_INTRINSICS)
     __writecr3(value);
 #elif defined(HAVE_INLINE_ASM)
-    ASM_INLINE ("mov %0, %%cr3" :: "r" (value) : "memory");
+    ASM_INLINE ("mov cr3, %0" :: "r" (value) : "memory");
 #endif
 }
 
+static inline uint64_t asm_read_cr4(void) {
+#if defined(HAVE_INTRINSICS)
+    return __readcr4();
+#elif defined(HAVE_INLINE_ASM)
+    uint64_t cr4;
+    ASM_INLINE ("mov %0, cr4" : "=r" (cr4) :: "memory");
+    return cr4;
+#else
+    return 0;
+#endif
+}
+
+static inline void asm_write_cr4(uint64_t value) {
+#if defined(HAVE_INTRINSICS)
+    __writecr4(value);
+#elif defined(HAVE_INLINE_ASM)
+    ASM_INLINE ("mov cr4, %0" :: "r" (value) : "memory");
+#endif
+}
+
+/* Drop the TLB entry for one page */
+static inline void asm_invlpg(uint64_t addr) {
+#if defined(HAVE_INTRINSICS)
+    __invlpg((void*)addr);
+#elif defined(HAVE_INLINE_ASM)
+    ASM_INLINE ("invlpg [%0]" :: "r" (addr) : "memory");
+#endif
+}
+
+/* Extended control register access (requires CR4.OSXSAVE) */
+static inline uint64_t asm_xgetbv(uint32_t xcr) {
+#if defined(HAVE_INTRINSICS)
+    return _xgetbv(xcr);
+#elif defined(HAVE_INLINE_ASM)
+    uint32_t low, high;
+    ASM_INLINE ("xgetbv" : "=a" (low), "=d" (high) : "c" (xcr));
+    return ((uint64_t)high << 32) | low;
+#else
+    return 0;
+#endif
+}
+
+static inline void asm_xsetbv(uint32_t xcr, uint64_t value) {
+#if defined(HAVE_INTRINSICS)
+    _xsetbv(xcr, value);
+#elif defined(HAVE_INLINE_ASM)
+    ASM_INLINE ("xsetbv" :: "c" (xcr), "a" ((uint32_t)value), "d" ((uint32_t)(value >> 32)) : "memory");
+#endif
+}
+
+#define RFLAGS_IF   0x200   /* Interrupts enabled */
+
+/* Save flags and disable interrupts; pair with asm_irq_restore */
+static inline uint64_t asm_irq_save(void) {
+#if defined(HAVE_INTRINSICS)
+    uint64_t flags = __readeflags();
+    _disable();
+    return flags;
+#elif defined(HAVE_INLINE_ASM)
+    uint64_t flags;
+    ASM_INLINE ("pushfq\n\tpop %0\n\tcli" : "=r" (flags) :: "memory");
+    if ((flags & RFLAGS_IF) && static_key_false(&irqoff_trace_key)) {
+        irqoff_trace_begin();
+    }
+    return flags;
+#else
+    return 0;
+#endif
+}
+
+static inline void asm_irq_restore(uint64_t flags) {
+    if (flags & RFLAGS_IF) {
+        asm_sti();
+    }
+}
+
 struct IDTPointer;  /* Forward declaration */
 
 static inline void asm_lidt(struct IDTPointer* ptr) {
@@ -0,0 +1,238 @@
+/**
+ * Clock Event Devices and the Kernel Tick Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "clockevent.h"
+#include "ktime.h"
+#include "kstat.h"
+#include "timer.h"
+#include "klog.h"
+#include "asm_utils.h"
+#include "irq.h"
+#include "profile.h"
+#include "softirq.h"
+
+static struct ClockEventDevice* tick_device = NULL;
+static uint32_t tick_hz = 0;
+static uint64_t tick_period_ns = 0;
+static tick_callback_t tick_callback = NULL;
+static uint32_t oversample = 1;     /* Device interrupts per tick */
+static uint32_t oversample_phase = 0;
+
+/*
+ * With a TSC or HPET clock, the tick count is derived from ktime: tick n
+ * is due at tick_base_ns + n * period. Interrupt jitter, a drifting timer
+ * and long idle sleeps therefore never skew it. Without one, every timer
+ * interrupt is one tick and tickless idle is unavailable.
+ */
+static uint64_t tick_count = 0;
+static uint64_t tick_base_ns = 0;
+static uint64_t last_minute = 0;
+
+static int tick_stopped = 0;        /* Device is in one-shot mode for idle */
+static int force_periodic = 0;
+static int nohz_enabled = 1;
+static uint64_t max_sleep_ns = TICK_DEFAULT_MAX_SLEEP_MS * NSEC_PER_MSEC;
+
+DEFINE_KSTAT_COUNTER(stat_events, "tick.events");
+DEFINE_KSTAT_COUNTER(stat_idle_sleeps, "tick.idle_sleeps");
+DEFINE_KSTAT_COUNTER(stat_wakeups_avoided, "tick.wakeups_avoided");
+
+static void tick_start_periodic(struct ClockEventDevice* dev) {
+    oversample_phase = 0;
+    if (dev->features & CLOCK_EVT_FEAT_PERIODIC) {
+        dev->set_periodic(dev, tick_hz * oversample);
+    } else {
+        dev->set_next_event(dev, tick_period_ns / oversample);
+    }
+}
+
+void clockevents_register(struct ClockEventDevice* dev, uint32_t hz) {
+    if (hz == 0 || (tick_device && tick_device != dev && tick_device->rating >= dev->rating)) {
+        return;
+    }
+
+    uint64_t flags = asm_irq_save();
+    tick_device = dev;
+    tick_hz = hz;
+    tick_period_ns = NSEC_PER_SEC / hz;
+    tick_base_ns = ktime_get_ns() - tick_count * tick_period_ns;
+    tick_stopped = 0;
+    tick_start_periodic(dev);
+    asm_irq_restore(flags);
+
+    klog_info("[TICK] %s drives the %u Hz tick", dev->name, hz);
+}
+
+/* Interrupts are off */
+static void tick_update(void) {
+    uint64_t target;
+
+    if (ktime_high_res()) {
+        /* Nearest due tick, so an interrupt arriving just early still counts */
+        uint64_t since = ktime_get_ns() - tick_base_ns;
+        target = (since + tick_period_ns / 2) / tick_period_ns;
+        if (target <= tick_count) {
+            return;
+        }
+    } else {
+        target = tick_count + 1;
+    }
+    tick_count = target;
+
+    /* Heartbeat once a minute, debug builds only */
+    if (tick_count / (60ull * tick_hz) != last_minute) {
+        last_minute = tick_count / (60ull * tick_hz);
+        klog_debug("[TICK] Heartbeat: %llu ticks", (unsigned long long)tick_count);
+    }
+
+    timer_run(tick_count);
+
+    if (tick_callback) {
+        tick_callback();
+    }
+}
+
+void clockevents_handle(struct ClockEventDevice* dev) {
+    if (dev != tick_device) {
+        return;
+    }
+    kstat_inc(stat_events);
+
+    /* Every timer interrupt is a profiler sample, oversampled ones included */
+    struct InterruptFrame* regs = irq_get_regs();
+    if (regs) {
+        profile_sample(regs->rip, regs->rbp);
+    }
+
+    /* One-shot devices re-arm themselves to emulate the periodic tick */
+    if (!tick_stopped && !(dev->features & CLOCK_EVT_FEAT_PERIODIC)) {
+        dev->set_next_event(dev, tick_period_ns / oversample);
+    }
+
+    /* Only every oversample-th interrupt is a tick */
+    if (++oversample_phase < oversample) {
+        return;
+    }
+    oversample_phase = 0;
+    tick_update();
+}
+
+uint64_t tick_get_ticks(void) {
+    return tick_count;
+}
+
+uint32_t tick_get_hz(void) {
+    return tick_hz;
+}
+
+void tick_set_callback(tick_callback_t callback) {
+    tick_callback = callback;
+}
+
+void tick_set_oversample(uint32_t factor) {
+    uint64_t flags = asm_irq_save();
+    oversample = factor ? factor : 1;
+    if (tick_device && !tick_stopped) {
+        tick_start_periodic(tick_device);
+    }
+    asm_irq_restore(flags);
+}
+
+uint32_t tick_get_oversample(void) {
+    return oversample;
+}
+
+static int tick_can_stop(void) {
+    return tick_device && (tick_device->features & CLOCK_EVT_FEAT_ONESHOT) &&
+           nohz_enabled && !force_periodic && ktime_high_res();
+}
+
+void tick_idle(uint64_t wake_ns) {
+    asm_cli();
+
+    /* Raised after the caller's last check; halting would hold it until the next interrupt */
+    if (softirq_pending() || workqueue_pending()) {
+        asm_sti();
+        return;
+    }
+
+    if (!tick_can_stop()) {
+        asm_safe_halt();
+        return;
+    }
+
+    struct ClockEventDevice* dev = tick_device;
+    uint64_t start = ktime_get_ns();
+    uint64_t sleep = max_sleep_ns;
+
+    /* Wake for the next timer; a tick is counted from its due point on */
+    uint64_t next_timer = timer_next_expiry();
+    if (next_timer != TIMER_NEVER) {
+        uint64_t timer_ns = tick_base_ns + next_timer * tick_period_ns;
+        if (!wake_ns || timer_ns < wake_ns) {
+            wake_ns = timer_ns;
+        }
+    }
+
+    if (wake_ns) {
+        if (wake_ns <= start) {
+            asm_sti();
+            return;
+        }
+        if (wake_ns - start < sleep) {
+            sleep = wake_ns - start;
+        }
+    }
+    if (sleep > dev->max_delta_ns) {
+        sleep = dev->max_delta_ns;
+    }
+
+    /* Not worth reprogramming for less than two periods */
+    if (sleep < 2 * tick_period_ns) {
+        asm_safe_halt();
+        return;
+    }
+
+    tick_stopped = 1;
+    kstat_inc(stat_idle_sleeps);
+    dev->set_next_event(dev, sleep);
+
+    /* Any interrupt ends the sleep; its handler runs before we continue */
+    asm_safe_halt();
+    asm_cli();
+
+    uint64_t slept = ktime_get_ns() - start;
+    uint64_t periods = slept / tick_period_ns;
+    if (periods > 1) {
+        kstat_add(stat_wakeups_avoided, periods - 1);
+    }
+
+    tick_stopped = 0;
+    tick_update();
+    tick_start_periodic(dev);
+    asm_sti();
+}
+
+void tick_set_max_sleep_ms(uint32_t ms) {
+    max_sleep_ns = (uint64_t)ms * NSEC_PER_MSEC;
+}
+
+void tick_force_periodic(int enable) {
+    uint64_t flags = asm_irq_save();
+    force_periodic += enable ? 1 : -1;
+    asm_irq_restore(flags);
+}
+
+void tick_set_nohz(int enable) {
+    nohz_enabled = enable;
+}
+
+void tick_get_stats(struct TickStats* stats) {
+    stats->ticks = tick_count;
+    stats->events = kstat_read(&stat_events, 0);
+    stats->idle_sleeps = kstat_read(&stat_idle_sleeps, 0);
+    stats->wakeups_avoided = kstat_read(&stat_wakeups_avoided, 0);
+}
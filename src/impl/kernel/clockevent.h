@@ -0,0 +1,75 @@
+/**
+ * Clock Event Devices and the Kernel Tick
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+
+#define CLOCK_EVT_FEAT_PERIODIC 0x01
+#define CLOCK_EVT_FEAT_ONESHOT  0x02
+
+#define TICK_DEFAULT_MAX_SLEEP_MS   1000
+
+/*
+ * A timer that can interrupt periodically or once after a delay. The
+ * highest rated registered device drives the kernel tick; its interrupt
+ * handler calls clockevents_handle() once per expiry.
+ */
+struct ClockEventDevice {
+    const char* name;
+    uint32_t features;          /* CLOCK_EVT_FEAT_* */
+    int rating;                 /* Higher is preferred */
+    uint64_t min_delta_ns;      /* Shortest programmable one-shot delay */
+    uint64_t max_delta_ns;      /* Longest programmable one-shot delay */
+    void (*set_periodic)(struct ClockEventDevice* dev, uint32_t hz);
+    void (*set_next_event)(struct ClockEventDevice* dev, uint64_t delta_ns);
+};
+
+typedef void (*tick_callback_t)(void);
+
+struct TickStats {
+    uint64_t ticks;
+    uint64_t events;            /* Timer interrupts taken */
+    uint64_t idle_sleeps;       /* Idle periods run without the periodic tick */
+    uint64_t wakeups_avoided;   /* Periodic ticks that did not interrupt */
+};
+
+/* Offer a device; it becomes the tick device if it beats the current one */
+void clockevents_register(struct ClockEventDevice* dev, uint32_t tick_hz);
+
+/* Device interrupt handler body; accounts ticks, runs timers and the callback */
+void clockevents_handle(struct ClockEventDevice* dev);
+
+uint64_t tick_get_ticks(void);
+uint32_t tick_get_hz(void);
+void tick_set_callback(tick_callback_t callback);
+
+/*
+ * Run the tick device `factor` times faster than the tick rate; ticks,
+ * timers and callbacks still advance at that rate. Used by the sampling
+ * profiler, which samples on every interrupt. 1 restores it.
+ */
+void tick_set_oversample(uint32_t factor);
+uint32_t tick_get_oversample(void);
+
+/*
+ * Halt until an interrupt. When nothing needs the periodic tick, the tick
+ * device is switched to one-shot mode for the sleep and programmed for
+ * `wake_ns` (absolute ktime, 0 for none), the next kernel timer or the
+ * maximum sleep, whichever is sooner; missed ticks are accounted and due
+ * timers run on wakeup. Returns at once while softirqs or work are pending.
+ */
+void tick_idle(uint64_t wake_ns);
+
+/* Longest tickless sleep; the device may impose a shorter one */
+void tick_set_max_sleep_ms(uint32_t ms);
+
+/* Keep the periodic tick while idle (nesting count), e.g. for sampling */
+void tick_force_periodic(int enable);
+
+/* Turn tickless idle on or off altogether */
+void tick_set_nohz(int enable);
+
+void tick_get_stats(struct TickStats* stats);
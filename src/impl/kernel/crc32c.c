@@ -0,0 +1,231 @@
+/**
+ * CRC32C (Castagnoli) Checksums Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "crc32c.h"
+#include "asm_utils.h"
+#include "sysinfo.h"
+#include "alternative.h"
+#include "../drivers/serial/serial.h"
+
+/* Reflected Castagnoli polynomial */
+#define CRC32C_POLY     0x82F63B78
+
+/*
+ * The hardware path runs three independent crc32 streams over adjacent
+ * blocks to hide the instruction's 3-cycle latency, then merges them by
+ * shifting the earlier CRCs over the later blocks' length with the
+ * zero-operator tables below.
+ */
+#define CRC32C_LONG     8192
+#define CRC32C_SHORT    256
+
+typedef uint64_t __attribute__((may_alias)) crc_word_t;
+
+/* Slice-by-8 tables for the software path */
+static uint32_t crc32c_table[8][256];
+
+/* Operators that append CRC32C_LONG / CRC32C_SHORT zero bytes */
+static uint32_t crc32c_long[4][256];
+static uint32_t crc32c_short[4][256];
+
+static int crc32c_have_hw = 0;
+
+/* crc32c() starts on the table path and is patched to SSE4.2 at boot */
+ALTERNATIVE_ENTRY(crc32c, crc32c_sw);
+ALTERNATIVE_VARIANT(crc32c, crc32c_hw, CPU_FEATURE_SSE42, 1);
+
+/* Multiply a 32x32 GF(2) matrix by a vector */
+static uint32_t gf2_matrix_times(const uint32_t* mat, uint32_t vec) {
+    uint32_t sum = 0;
+    while (vec) {
+        if (vec & 1) {
+            sum ^= *mat;
+        }
+        vec >>= 1;
+        mat++;
+    }
+    return sum;
+}
+
+static void gf2_matrix_square(uint32_t* square, const uint32_t* mat) {
+    for (int n = 0; n < 32; n++) {
+        square[n] = gf2_matrix_times(mat, mat[n]);
+    }
+}
+
+/* Operator that feeds `len` zero bytes through the CRC register */
+static void crc32c_zeros_op(uint32_t* even, size_t len) {
+    uint32_t odd[32];
+    uint32_t row = 1;
+
+    /* Operator for one zero bit */
+    odd[0] = CRC32C_POLY;
+    for (int n = 1; n < 32; n++) {
+        odd[n] = row;
+        row <<= 1;
+    }
+
+    /* Two, then four zero bits */
+    gf2_matrix_square(even, odd);
+    gf2_matrix_square(odd, even);
+
+    /* Keep squaring: one zero byte, two, four... until len is consumed */
+    do {
+        gf2_matrix_square(even, odd);
+        len >>= 1;
+        if (len == 0) {
+            return;
+        }
+        gf2_matrix_square(odd, even);
+        len >>= 1;
+    } while (len);
+
+    for (int n = 0; n < 32; n++) {
+        even[n] = odd[n];
+    }
+}
+
+static void crc32c_zeros(uint32_t zeros[][256], size_t len) {
+    uint32_t op[32];
+    crc32c_zeros_op(op, len);
+    for (uint32_t n = 0; n < 256; n++) {
+        zeros[0][n] = gf2_matrix_times(op, n);
+        zeros[1][n] = gf2_matrix_times(op, n << 8);
+        zeros[2][n] = gf2_matrix_times(op, n << 16);
+        zeros[3][n] = gf2_matrix_times(op, n << 24);
+    }
+}
+
+static inline uint32_t crc32c_shift(uint32_t zeros[][256], uint32_t crc) {
+    return zeros[0][crc & 0xFF] ^ zeros[1][(crc >> 8) & 0xFF] ^
+           zeros[2][(crc >> 16) & 0xFF] ^ zeros[3][crc >> 24];
+}
+
+static inline uint64_t crc32c_u64(uint64_t crc, uint64_t data) {
+    ASM_INLINE ("crc32 %0, %1" : "+r" (crc) : "rm" (data));
+    return crc;
+}
+
+static inline uint32_t crc32c_u8(uint32_t crc, uint8_t data) {
+    ASM_INLINE ("crc32 %0, %1" : "+r" (crc) : "rm" (data));
+    return crc;
+}
+
+uint32_t crc32c_hw(uint32_t seed, const void* buf, size_t len) {
+    const uint8_t* next = (const uint8_t*)buf;
+    uint64_t crc0 = seed ^ 0xFFFFFFFF;
+
+    while (len && ((uintptr_t)next & 7)) {
+        crc0 = crc32c_u8((uint32_t)crc0, *next++);
+        len--;
+    }
+
+    while (len >= CRC32C_LONG * 3) {
+        uint64_t crc1 = 0;
+        uint64_t crc2 = 0;
+        const uint8_t* end = next + CRC32C_LONG;
+        do {
+            crc0 = crc32c_u64(crc0, *(const crc_word_t*)next);
+            crc1 = crc32c_u64(crc1, *(const crc_word_t*)(next + CRC32C_LONG));
+            crc2 = crc32c_u64(crc2, *(const crc_word_t*)(next + CRC32C_LONG * 2));
+            next += 8;
+        } while (next < end);
+        crc0 = crc32c_shift(crc32c_long, (uint32_t)crc0) ^ crc1;
+        crc0 = crc32c_shift(crc32c_long, (uint32_t)crc0) ^ crc2;
+        next += CRC32C_LONG * 2;
+        len -= CRC32C_LONG * 3;
+    }
+
+    while (len >= CRC32C_SHORT * 3) {
+        uint64_t crc1 = 0;
+        uint64_t crc2 = 0;
+        const uint8_t* end = next + CRC32C_SHORT;
+        do {
+            crc0 = crc32c_u64(crc0, *(const crc_word_t*)next);
+            crc1 = crc32c_u64(crc1, *(const crc_word_t*)(next + CRC32C_SHORT));
+            crc2 = crc32c_u64(crc2, *(const crc_word_t*)(next + CRC32C_SHORT * 2));
+            next += 8;
+        } while (next < end);
+        crc0 = crc32c_shift(crc32c_short, (uint32_t)crc0) ^ crc1;
+        crc0 = crc32c_shift(crc32c_short, (uint32_t)crc0) ^ crc2;
+        next += CRC32C_SHORT * 2;
+        len -= CRC32C_SHORT * 3;
+    }
+
+    while (len >= 8) {
+        crc0 = crc32c_u64(crc0, *(const crc_word_t*)next);
+        next += 8;
+        len -= 8;
+    }
+
+    while (len) {
+        crc0 = crc32c_u8((uint32_t)crc0, *next++);
+        len--;
+    }
+
+    return (uint32_t)crc0 ^ 0xFFFFFFFF;
+}
+
+uint32_t crc32c_sw(uint32_t seed, const void* buf, size_t len) {
+    const uint8_t* next = (const uint8_t*)buf;
+    uint32_t crc = seed ^ 0xFFFFFFFF;
+
+    while (len && ((uintptr_t)next & 7)) {
+        crc = (crc >> 8) ^ crc32c_table[0][(crc ^ *next++) & 0xFF];
+        len--;
+    }
+
+    while (len >= 8) {
+        uint64_t word = *(const crc_word_t*)next ^ crc;
+        crc = crc32c_table[7][word & 0xFF] ^
+              crc32c_table[6][(word >> 8) & 0xFF] ^
+              crc32c_table[5][(word >> 16) & 0xFF] ^
+              crc32c_table[4][(word >> 24) & 0xFF] ^
+              crc32c_table[3][(word >> 32) & 0xFF] ^
+              crc32c_table[2][(word >> 40) & 0xFF] ^
+              crc32c_table[1][(word >> 48) & 0xFF] ^
+              crc32c_table[0][word >> 56];
+        next += 8;
+        len -= 8;
+    }
+
+    while (len) {
+        crc = (crc >> 8) ^ crc32c_table[0][(crc ^ *next++) & 0xFF];
+        len--;
+    }
+
+    return crc ^ 0xFFFFFFFF;
+}
+
+void crc32c_init(void) {
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t crc = n;
+        for (int k = 0; k < 8; k++) {
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+        }
+        crc32c_table[0][n] = crc;
+    }
+    for (uint32_t n = 0; n < 256; n++) {
+        uint32_t crc = crc32c_table[0][n];
+        for (int k = 1; k < 8; k++) {
+            crc = crc32c_table[0][crc & 0xFF] ^ (crc >> 8);
+            crc32c_table[k][n] = crc;
+        }
+    }
+
+    crc32c_have_hw = sysinfo_has_feature(CPU_FEATURE_SSE42);
+    if (crc32c_have_hw) {
+        crc32c_zeros(crc32c_long, CRC32C_LONG);
+        crc32c_zeros(crc32c_short, CRC32C_SHORT);
+    }
+
+    serial_printf(COM1_PORT, "[CRC32C] Using %s implementation\n",
+                  crc32c_have_hw ? "SSE4.2" : "slice-by-8");
+}
+
+int crc32c_hw_available(void) {
+    return crc32c_have_hw;
+}
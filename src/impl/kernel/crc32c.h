@@ -0,0 +1,23 @@
+/**
+ * CRC32C (Castagnoli) Checksums
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/* Build the lookup tables; must run before the first crc32c() call */
+void crc32c_init(void);
+
+/*
+ * Running CRC32C: pass 0 to start, or a previous result to continue.
+ * crc32c(crc32c(0, a, n), b, m) equals the CRC of a followed by b.
+ */
+uint32_t crc32c(uint32_t seed, const void* buf, size_t len);
+
+/* Individual implementations, exposed for verification and benchmarks */
+uint32_t crc32c_sw(uint32_t seed, const void* buf, size_t len);
+uint32_t crc32c_hw(uint32_t seed, const void* buf, size_t len);
+int crc32c_hw_available(void);
@@ -0,0 +1,106 @@
+/**
+ * Calibrated Busy-Wait Delays Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "delay.h"
+#include "ktime.h"
+#include "klog.h"
+#include "asm_utils.h"
+#include "../drivers/pit/pit.h"
+
+#define CALIBRATE_MS        10
+#define CALIBRATE_CHUNK     256         /* Loops between channel 2 polls */
+
+/* Deliberately high so uncalibrated delays err on the long side */
+#define DEFAULT_LOOPS_PER_MS (1ull << 22)
+
+static uint64_t loops_per_ms = DEFAULT_LOOPS_PER_MS;
+
+static void delay_loops(uint64_t loops) {
+    for (uint64_t i = 0; i < loops; i++) {
+        asm_pause();
+    }
+}
+
+void delay_init(void) {
+    if (ktime_tsc_hz()) {
+        return;
+    }
+
+    uint32_t latch = (uint32_t)((uint64_t)PIT_FREQUENCY * CALIBRATE_MS / 1000);
+    uint64_t flags = asm_irq_save();
+    uint8_t control = pit_channel2_start(latch);
+    uint64_t chunks = 0;
+    int expired;
+
+    /* The channel 2 poll is counted as delay, which only makes delays longer */
+    while (!(expired = pit_channel2_expired()) &&
+           chunks < DEFAULT_LOOPS_PER_MS / CALIBRATE_CHUNK * CALIBRATE_MS) {
+        delay_loops(CALIBRATE_CHUNK);
+        chunks++;
+    }
+    pit_channel2_stop(control);
+    asm_irq_restore(flags);
+
+    if (!expired || chunks == 0) {
+        klog_warn("[DELAY] Calibration failed; delays will run long");
+        return;
+    }
+    loops_per_ms = chunks * CALIBRATE_CHUNK / CALIBRATE_MS;
+    klog_info("[DELAY] No TSC; %llu delay loops per ms", (unsigned long long)loops_per_ms);
+}
+
+void ndelay(uint64_t ns) {
+    uint64_t hz = ktime_tsc_hz();
+
+    if (hz) {
+        /* Split at whole seconds so the product cannot overflow */
+        uint64_t cycles = ns / NSEC_PER_SEC * hz + ns % NSEC_PER_SEC * hz / NSEC_PER_SEC;
+        uint64_t start = asm_rdtsc();
+        while (asm_rdtsc() - start < cycles) {
+            asm_pause();
+        }
+    } else if (ktime_high_res()) {
+        uint64_t deadline = ktime_get_ns() + ns;
+        while (ktime_get_ns() < deadline) {
+            asm_pause();
+        }
+    } else {
+        delay_loops(ns / NSEC_PER_MSEC * loops_per_ms +
+                    (ns % NSEC_PER_MSEC * loops_per_ms + NSEC_PER_MSEC - 1) / NSEC_PER_MSEC);
+    }
+}
+
+void udelay(uint64_t us) {
+    ndelay(us * NSEC_PER_USEC);
+}
+
+void mdelay(uint64_t ms) {
+    ndelay(ms * NSEC_PER_MSEC);
+}
+
+uint64_t delay_loops_per_ms(void) {
+    return ktime_tsc_hz() ? 0 : loops_per_ms;
+}
+
+void poll_timeout_start(struct PollTimeout* timeout, uint64_t timeout_us) {
+    timeout->clocked = ktime_high_res();
+    timeout->deadline = timeout->clocked ? ktime_get_ns() + timeout_us * NSEC_PER_USEC : timeout_us;
+}
+
+int poll_timeout_expired(struct PollTimeout* timeout) {
+    if (timeout->clocked) {
+        asm_pause();
+        return ktime_get_ns() >= timeout->deadline;
+    }
+
+    /* Without a clock, count microseconds; the condition's own cost only adds to the wait */
+    if (timeout->deadline == 0) {
+        return 1;
+    }
+    timeout->deadline--;
+    udelay(1);
+    return 0;
+}
@@ -0,0 +1,58 @@
+/**
+ * Calibrated Busy-Wait Delays
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+
+/*
+ * Calibrate the fallback delay loop against PIT channel 2 when the TSC is
+ * not usable. Call right after ktime_init(); delays before that are long.
+ */
+void delay_init(void);
+
+/*
+ * Spin for at least the given time. Uses the TSC when ktime has a rate for
+ * it, a free-running clocksource otherwise, and the calibrated loop as a
+ * last resort. Safe with interrupts off and from interrupt context.
+ */
+void ndelay(uint64_t ns);
+void udelay(uint64_t us);
+void mdelay(uint64_t ms);
+
+/* Delay loop iterations per millisecond; 0 while the TSC is used instead */
+uint64_t delay_loops_per_ms(void);
+
+/* Deadline state for poll_until(); use the macro rather than these */
+struct PollTimeout {
+    uint64_t deadline;          /* ktime ns, or microseconds left without a clocksource */
+    int clocked;
+};
+
+void poll_timeout_start(struct PollTimeout* timeout, uint64_t timeout_us);
+int poll_timeout_expired(struct PollTimeout* timeout);
+
+/*
+ * Re-evaluate `cond` until it is true or at least `timeout_us` microseconds
+ * have passed. Yields 0 on success and -1 on timeout. `cond` is checked once
+ * more after the deadline, so an interrupt landing between the last check
+ * and the clock read cannot turn success into a timeout.
+ */
+#define poll_until(cond, timeout_us) ({                         \
+    struct PollTimeout __poll;                                  \
+    int __poll_ret;                                             \
+    poll_timeout_start(&__poll, (timeout_us));                  \
+    for (;;) {                                                  \
+        if (cond) {                                             \
+            __poll_ret = 0;                                     \
+            break;                                              \
+        }                                                       \
+        if (poll_timeout_expired(&__poll)) {                    \
+            __poll_ret = (cond) ? 0 : -1;                       \
+            break;                                              \
+        }                                                       \
+    }                                                           \
+    __poll_ret;                                                 \
+})
@@ -0,0 +1,130 @@
+/**
+ * Kernel FPU/SIMD Sections Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "fpu.h"
+#include "asm_utils.h"
+#include "sysinfo.h"
+#include "klog.h"
+#include "../drivers/serial/serial.h"
+
+/* Control register bits */
+#define CR0_MP              (1 << 1)    /* Monitor coprocessor */
+#define CR0_EM              (1 << 2)    /* x87 emulation */
+#define CR0_TS              (1 << 3)    /* Task switched */
+#define CR0_NE              (1 << 5)    /* Native x87 error reporting */
+#define CR4_OSFXSR          (1 << 9)    /* FXSAVE/FXRSTOR and SSE */
+#define CR4_OSXMMEXCPT      (1 << 10)   /* Unmasked SIMD exceptions */
+#define CR4_OSXSAVE         (1 << 18)   /* XSAVE and XCR0 */
+
+static int fpu_enabled = 0;
+static int fpu_use_xsave = 0;
+static uint64_t fpu_xcr0 = 0;
+
+/* Open sections on this CPU and the registers of each interrupted one */
+static volatile int fpu_depth = 0;
+static struct FPUState fpu_nested[FPU_MAX_NESTING];
+
+void fpu_save(struct FPUState* state) {
+    if (fpu_use_xsave) {
+        ASM_INLINE ("xsave64 [%0]"
+                    :: "r" (state->data), "a" ((uint32_t)fpu_xcr0), "d" ((uint32_t)(fpu_xcr0 >> 32))
+                    : "memory");
+    } else {
+        ASM_INLINE ("fxsave64 [%0]" :: "r" (state->data) : "memory");
+    }
+}
+
+void fpu_restore(const struct FPUState* state) {
+    if (fpu_use_xsave) {
+        ASM_INLINE ("xrstor64 [%0]"
+                    :: "r" (state->data), "a" ((uint32_t)fpu_xcr0), "d" ((uint32_t)(fpu_xcr0 >> 32))
+                    : "memory");
+    } else {
+        ASM_INLINE ("fxrstor64 [%0]" :: "r" (state->data) : "memory");
+    }
+}
+
+void fpu_init(void) {
+    uint32_t eax, ebx, ecx, edx;
+
+    if (!sysinfo_has_feature(CPU_FEATURE_FPU | CPU_FEATURE_FXSR | CPU_FEATURE_SSE | CPU_FEATURE_SSE2)) {
+        serial_write_string(COM1_PORT, "[FPU] SSE2 not supported, SIMD paths disabled\n");
+        return;
+    }
+
+    uint64_t cr0 = asm_read_cr0();
+    cr0 &= ~(uint64_t)(CR0_EM | CR0_TS);
+    cr0 |= CR0_MP | CR0_NE;
+    asm_write_cr0(cr0);
+
+    uint64_t cr4 = asm_read_cr4() | CR4_OSFXSR | CR4_OSXMMEXCPT;
+    if (sysinfo_has_feature(CPU_FEATURE_XSAVE)) {
+        cr4 |= CR4_OSXSAVE;
+    }
+    asm_write_cr4(cr4);
+
+    if (sysinfo_has_feature(CPU_FEATURE_XSAVE)) {
+        asm_cpuid_count(0x0D, 0, &eax, &ebx, &ecx, &edx);
+        uint64_t supported = ((uint64_t)edx << 32) | eax;
+
+        fpu_xcr0 = XCR0_X87 | XCR0_SSE;
+        if (sysinfo_has_feature(CPU_FEATURE_AVX) && (supported & XCR0_AVX)) {
+            fpu_xcr0 |= XCR0_AVX;
+        }
+        asm_xsetbv(0, fpu_xcr0);
+
+        /* EBX now reports the save area size for the enabled components */
+        asm_cpuid_count(0x0D, 0, &eax, &ebx, &ecx, &edx);
+        if (ebx > FPU_STATE_SIZE) {
+            fpu_xcr0 = XCR0_X87 | XCR0_SSE;
+            asm_xsetbv(0, fpu_xcr0);
+        }
+        fpu_use_xsave = 1;
+    }
+
+    ASM_INLINE ("fninit" ::: "memory");
+    fpu_enabled = 1;
+
+    serial_printf(COM1_PORT, "[FPU] SIMD enabled (%s, XCR0=0x%llx)\n",
+                  fpu_use_xsave ? "xsave" : "fxsave", fpu_xcr0);
+}
+
+int fpu_available(void) {
+    return fpu_enabled;
+}
+
+void kernel_fpu_begin(void) {
+    uint64_t flags = asm_irq_save();
+    int depth = fpu_depth;
+
+    /* Running on would clobber an interrupted section's registers; halt instead */
+    if (depth > FPU_MAX_NESTING) {
+        serial_force_sync();
+        klog_flush();
+        serial_write_string(COM1_PORT, "[FPU] Section nesting too deep! System halted.\n");
+        for(;;) { asm_hlt(); }
+    }
+
+    /* Only an interrupted section has live registers worth saving */
+    if (depth > 0) {
+        fpu_save(&fpu_nested[depth - 1]);
+    }
+    fpu_depth = depth + 1;
+
+    asm_irq_restore(flags);
+}
+
+void kernel_fpu_end(void) {
+    uint64_t flags = asm_irq_save();
+    int depth = fpu_depth - 1;
+
+    if (depth > 0 && depth <= FPU_MAX_NESTING) {
+        fpu_restore(&fpu_nested[depth - 1]);
+    }
+    fpu_depth = depth;
+
+    asm_irq_restore(flags);
+}
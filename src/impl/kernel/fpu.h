@@ -0,0 +1,43 @@
+/**
+ * Kernel FPU/SIMD Sections
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+
+/* Save area: legacy region (512) + XSAVE header (64) + AVX upper halves (256) */
+#define FPU_STATE_SIZE      1024
+
+/* Sections may nest this deep (thread -> IRQ -> NMI -> spare) */
+#define FPU_MAX_NESTING     4
+
+/* XCR0 state components */
+#define XCR0_X87            (1 << 0)
+#define XCR0_SSE            (1 << 1)
+#define XCR0_AVX            (1 << 2)
+
+struct FPUState {
+    uint8_t data[FPU_STATE_SIZE];
+} __attribute__((aligned(64)));
+
+/* Enable x87/SSE (and AVX when present) for kernel use */
+void fpu_init(void);
+
+/* Non-zero once SSE2 state can be used inside a section */
+int fpu_available(void);
+
+/*
+ * Bracket any code that touches x87/SSE/AVX registers. Sections nest:
+ * an interrupt that opens its own section saves the interrupted
+ * section's registers first and restores them at its end. When nothing
+ * else owns the registers no state is saved at all. Nesting deeper than
+ * FPU_MAX_NESTING halts the system.
+ */
+void kernel_fpu_begin(void);
+void kernel_fpu_end(void);
+
+/* Explicit save/restore for a future per-task context switch */
+void fpu_save(struct FPUState* state);
+void fpu_restore(const struct FPUState* state);
@@ -5,6 +5,10 @@
  */
 
 #include "fs.h"
+#include "rbtree.h"
+#include "radix_tree.h"
+#include "tracepoint.h"
+#include "kstat.h"
 #include <stddef.h>
 #include <string.h>
 #include "../../intf/print.h"
@@ -13,13 +17,36 @@
 #define MAX_MOUNTS 16
 #define MAX_PATH_LEN 256
 
-/* Global variables */
-static struct FileDescriptor fd_table[MAX_FD];
-static struct {
-    char* path;
+DEFINE_TRACEPOINT(vfs_read, "fd=%llu bytes=%lld");
+DEFINE_TRACEPOINT(vfs_write, "fd=%llu bytes=%lld");
+
+DEFINE_KSTAT_COUNTER(stat_reads, "vfs.reads");
+DEFINE_KSTAT_COUNTER(stat_read_bytes, "vfs.read_bytes");
+DEFINE_KSTAT_COUNTER(stat_writes, "vfs.writes");
+DEFINE_KSTAT_COUNTER(stat_write_bytes, "vfs.write_bytes");
+DEFINE_KSTAT_GAUGE(stat_open_files, "vfs.open_files");
+
+/* Mount table, ordered by path */
+struct MountPoint {
+    struct RBNode node;
     struct FileSystem* fs;
-} mount_points[MAX_MOUNTS];
+    char path[MAX_PATH_LEN];
+};
+
+/* Open descriptors indexed by fd; new fds take the lowest free number */
+static struct RadixTree fd_table;
+static struct RadixNode fd_nodes[RADIX_POOL_NODES(MAX_FD)];
 
+/* Descriptor and mount storage is static; unused entries wait on a free stack */
+static struct FileDescriptor fd_pool[MAX_FD];
+static struct FileDescriptor* fd_free[MAX_FD];
+static int fd_free_count = 0;
+
+static struct MountPoint mount_pool[MAX_MOUNTS];
+static struct MountPoint* mount_free[MAX_MOUNTS];
+static int mount_free_count = 0;
+
+static struct RBRoot mount_points = RB_ROOT_INIT;
 static int num_mounts = 0;
 static struct FSNode* root_node = NULL;
 
@@ -74,6 +101,68 @@ char* vfs_normalize_path(const char* path) {
     return normalized;
 }
 
+/* Exact-match mount lookup */
+static struct MountPoint* mount_find(const char* path) {
+    struct RBNode* node = mount_points.node;
+    while (node) {
+        struct MountPoint* mount = rb_entry(node, struct MountPoint, node);
+        int cmp = strcmp(path, mount->path);
+        if (cmp == 0) {
+            return mount;
+        }
+        node = cmp < 0 ? node->left : node->right;
+    }
+    return NULL;
+}
+
+static int mount_insert(struct MountPoint* mount) {
+    struct RBNode** link = &mount_points.node;
+    struct RBNode* parent = NULL;
+    while (*link) {
+        parent = *link;
+        int cmp = strcmp(mount->path, rb_entry(parent, struct MountPoint, node)->path);
+        if (cmp == 0) {
+            return -1;
+        }
+        link = cmp < 0 ? &parent->left : &parent->right;
+    }
+    rb_link_node(&mount->node, parent, link);
+    rb_insert_color(&mount->node, &mount_points);
+    return 0;
+}
+
+/*
+ * Longest mounted prefix of a normalized path: try the whole path, then
+ * each shorter '/' boundary, down to the root.
+ */
+static struct MountPoint* mount_resolve(const char* path, const char** rel_path) {
+    char prefix[MAX_PATH_LEN];
+    size_t len = strlen(path);
+    memcpy(prefix, path, len + 1);
+
+    for (;;) {
+        struct MountPoint* mount = mount_find(prefix);
+        if (mount) {
+            *rel_path = path + len;
+            while (**rel_path == '/') (*rel_path)++;
+            return mount;
+        }
+        if (len <= 1) {
+            return NULL;
+        }
+        char* slash = strrchr(prefix, '/');
+        if (!slash) {
+            return NULL;
+        }
+        len = slash == prefix ? 1 : (size_t)(slash - prefix);
+        prefix[len] = '\0';
+    }
+}
+
+static struct FileDescriptor* fd_get(int fd) {
+    return fd < 0 ? NULL : (struct FileDescriptor*)radix_tree_lookup(&fd_table, (uint32_t)fd);
+}
+
 /* Find a filesystem node by path */
 struct FSNode* vfs_lookup(const char* path) {
     if (!path) return NULL;
@@ -88,22 +177,8 @@ struct FSNode* vfs_lookup(const char* path) {
     }
     
     /* Find mount point */
-    struct FileSystem* fs = NULL;
     const char* rel_path = norm_path;
-    
-    for (int i = 0; i < num_mounts; i++) {
-        size_t mlen = strlen(mount_points[i].path);
-        if (strncmp(norm_path, mount_points[i].path, mlen) == 0) {
-            if (norm_path[mlen] == '/' || norm_path[mlen] == '\0') {
-                fs = mount_points[i].fs;
-                rel_path = norm_path + mlen;
-                while (*rel_path == '/') rel_path++;
-                break;
-            }
-        }
-    }
-    
-    if (!fs) return NULL;
+    if (!mount_resolve(norm_path, &rel_path)) return NULL;
     
     /* Walk the path */
     struct FSNode* node = root_node;
@@ -130,8 +205,15 @@ struct FSNode* vfs_lookup(const char* path) {
 
 /* Initialize the VFS */
 void vfs_init(void) {
-    memset(fd_table, 0, sizeof(fd_table));
-    memset(mount_points, 0, sizeof(mount_points));
+    radix_tree_init(&fd_table, fd_nodes, RADIX_POOL_NODES(MAX_FD), MAX_FD);
+    for (fd_free_count = 0; fd_free_count < MAX_FD; fd_free_count++) {
+        fd_free[fd_free_count] = &fd_pool[MAX_FD - 1 - fd_free_count];
+    }
+    for (mount_free_count = 0; mount_free_count < MAX_MOUNTS; mount_free_count++) {
+        mount_free[mount_free_count] = &mount_pool[MAX_MOUNTS - 1 - mount_free_count];
+    }
+    mount_points.node = NULL;
+    num_mounts = 0;
     print_str("[VFS] Initialized virtual filesystem\n");
 }
 
@@ -150,8 +232,15 @@ int vfs_mount(const char* path, const char* device, const char* fs_type) {
         return -1;
     }
 
-    mount_points[num_mounts].path = strdup(path);
-    mount_points[num_mounts].fs = fs;
+    struct MountPoint* mount = mount_free[--mount_free_count];
+    strncpy(mount->path, vfs_normalize_path(path), MAX_PATH_LEN - 1);
+    mount->path[MAX_PATH_LEN - 1] = '\0';
+    mount->fs = fs;
+    if (mount_insert(mount) < 0) {
+        print_str("[VFS] Error: Path is already a mount point\n");
+        mount_free[mount_free_count++] = mount;
+        return -1;
+    }
     num_mounts++;
 
     print_str("[VFS] Mounted ");
@@ -163,14 +252,27 @@ int vfs_mount(const char* path, const char* device, const char* fs_type) {
     return 0;
 }
 
-/* Find a free file descriptor */
-static int find_free_fd(void) {
-    for (int i = 0; i < MAX_FD; i++) {
-        if (fd_table[i].node == NULL) {
-            return i;
-        }
+/* Unmount a filesystem */
+int vfs_unmount(const char* path) {
+    if (!path) return -1;
+
+    struct MountPoint* mount = mount_find(vfs_normalize_path(path));
+    if (!mount) {
+        print_str("[VFS] Error: Not a mount point - ");
+        print_str(path);
+        print_str("\n");
+        return -1;
+    }
+
+    struct FileSystem* fs = mount->fs;
+    if (fs && fs->ops && fs->ops->unmount && fs->ops->unmount(fs) < 0) {
+        return -1;
     }
-    return -1;
+
+    rb_erase(&mount->node, &mount_points);
+    mount_free[mount_free_count++] = mount;
+    num_mounts--;
+    return 0;
 }
 
 /* Open a file */
@@ -183,16 +285,22 @@ int vfs_open(const char* path, uint32_t flags) {
         return -1;
     }
 
-    int fd = find_free_fd();
+    if (fd_free_count == 0) {
+        print_str("[VFS] Error: No free file descriptors\n");
+        return -1;
+    }
+    struct FileDescriptor* desc = fd_free[fd_free_count - 1];
+    int fd = radix_tree_alloc(&fd_table, desc);
     if (fd < 0) {
         print_str("[VFS] Error: No free file descriptors\n");
         return -1;
     }
-
-    fd_table[fd].node = node;
-    fd_table[fd].offset = 0;
-    fd_table[fd].flags = flags;
-    fd_table[fd].refcount = 1;
+    fd_free_count--;
+    desc->node = node;
+    desc->offset = 0;
+    desc->flags = flags;
+    desc->refcount = 1;
+    kstat_inc(stat_open_files);
 
     if (node->fs && node->fs->ops && node->fs->ops->open) {
         return node->fs->ops->open(node, flags);
@@ -203,69 +311,78 @@ int vfs_open(const char* path, uint32_t flags) {
 
 /* Close a file */
 int vfs_close(int fd) {
-    if (fd < 0 || fd >= MAX_FD || !fd_table[fd].node) {
+    struct FileDescriptor* desc = fd_get(fd);
+    if (!desc) {
         return -1;
     }
 
-    struct FSNode* node = fd_table[fd].node;
+    struct FSNode* node = desc->node;
     if (node->fs && node->fs->ops && node->fs->ops->close) {
         node->fs->ops->close(node);
     }
 
-    fd_table[fd].node = NULL;
-    fd_table[fd].offset = 0;
-    fd_table[fd].flags = 0;
-    fd_table[fd].refcount = 0;
+    radix_tree_remove(&fd_table, (uint32_t)fd);
+    fd_free[fd_free_count++] = desc;
+    kstat_sub(stat_open_files, 1);
 
     return 0;
 }
 
 /* Read from a file */
 int64_t vfs_read(int fd, void* buffer, uint64_t size) {
-    if (fd < 0 || fd >= MAX_FD || !fd_table[fd].node) {
+    struct FileDescriptor* desc = fd_get(fd);
+    if (!desc) {
         return -1;
     }
 
-    struct FSNode* node = fd_table[fd].node;
+    struct FSNode* node = desc->node;
     if (!node->fs || !node->fs->ops || !node->fs->ops->read) {
         return -1;
     }
 
-    int64_t bytes = node->fs->ops->read(node, fd_table[fd].offset, size, buffer);
+    int64_t bytes = node->fs->ops->read(node, desc->offset, size, buffer);
     if (bytes > 0) {
-        fd_table[fd].offset += bytes;
+        desc->offset += bytes;
+        kstat_add(stat_read_bytes, bytes);
     }
+    kstat_inc(stat_reads);
+    tracepoint(vfs_read, fd, bytes);
 
     return bytes;
 }
 
 /* Write to a file */
 int64_t vfs_write(int fd, const void* buffer, uint64_t size) {
-    if (fd < 0 || fd >= MAX_FD || !fd_table[fd].node) {
+    struct FileDescriptor* desc = fd_get(fd);
+    if (!desc) {
         return -1;
     }
 
-    struct FSNode* node = fd_table[fd].node;
+    struct FSNode* node = desc->node;
     if (!node->fs || !node->fs->ops || !node->fs->ops->write) {
         return -1;
     }
 
-    int64_t bytes = node->fs->ops->write(node, fd_table[fd].offset, size, buffer);
+    int64_t bytes = node->fs->ops->write(node, desc->offset, size, buffer);
     if (bytes > 0) {
-        fd_table[fd].offset += bytes;
+        desc->offset += bytes;
+        kstat_add(stat_write_bytes, bytes);
     }
+    kstat_inc(stat_writes);
+    tracepoint(vfs_write, fd, bytes);
 
     return bytes;
 }
 
 /* Seek within a file */
 int64_t vfs_seek(int fd, int64_t offset, int whence) {
-    if (fd < 0 || fd >= MAX_FD || !fd_table[fd].node) {
+    struct FileDescriptor* desc = fd_get(fd);
+    if (!desc) {
         return -1;
     }
 
-    struct FSNode* node = fd_table[fd].node;
-    int64_t new_offset = fd_table[fd].offset;
+    struct FSNode* node = desc->node;
+    int64_t new_offset = desc->offset;
 
     switch (whence) {
         case FS_SEEK_SET:
@@ -285,7 +402,7 @@ int64_t vfs_seek(int fd, int64_t offset, int whence) {
         return -1;
     }
 
-    fd_table[fd].offset = new_offset;
+    desc->offset = new_offset;
     return new_offset;
 }
 
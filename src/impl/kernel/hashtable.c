@@ -0,0 +1,107 @@
+/**
+ * Intrusive Open-Addressing Hash Table Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "hashtable.h"
+
+#define FNV_OFFSET_BASIS    0x811C9DC5u
+#define FNV_PRIME           0x01000193u
+
+void hash_init(struct HashTable* table, struct HashSlot* slots,
+               uint32_t slot_count, hash_match_t match) {
+    for (uint32_t i = 0; i < slot_count; i++) {
+        slots[i].hash = 0;
+        slots[i].node = NULL;
+    }
+    table->slots = slots;
+    table->mask = slot_count - 1;
+    table->count = 0;
+    table->limit = slot_count - slot_count / 4;
+    table->match = match;
+}
+
+int hash_insert(struct HashTable* table, struct HashNode* node, uint32_t hash) {
+    if (table->count >= table->limit) {
+        return -1;
+    }
+
+    uint32_t i = hash & table->mask;
+    while (table->slots[i].node) {
+        i = (i + 1) & table->mask;
+    }
+
+    node->hash = hash;
+    table->slots[i].hash = hash;
+    table->slots[i].node = node;
+    table->count++;
+    return 0;
+}
+
+struct HashNode* hash_find(const struct HashTable* table, uint32_t hash, const void* key) {
+    uint32_t i = hash & table->mask;
+    struct HashSlot* slot;
+
+    while ((slot = &table->slots[i])->node) {
+        if (slot->hash == hash && table->match(slot->node, key)) {
+            return slot->node;
+        }
+        i = (i + 1) & table->mask;
+    }
+    return NULL;
+}
+
+void hash_remove(struct HashTable* table, struct HashNode* node) {
+    uint32_t mask = table->mask;
+    uint32_t hole = node->hash & mask;
+
+    while (table->slots[hole].node != node) {
+        if (!table->slots[hole].node) {
+            return;     /* Not in this table */
+        }
+        hole = (hole + 1) & mask;
+    }
+
+    /*
+     * Backward-shift: pull later members of the cluster into the hole
+     * unless their home slot lies cyclically after the hole, which would
+     * put them in front of where a probe for them starts.
+     */
+    uint32_t i = hole;
+    for (;;) {
+        i = (i + 1) & mask;
+        struct HashSlot* slot = &table->slots[i];
+        if (!slot->node) {
+            break;
+        }
+        uint32_t home = slot->hash & mask;
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            table->slots[hole] = *slot;
+            hole = i;
+        }
+    }
+
+    table->slots[hole].hash = 0;
+    table->slots[hole].node = NULL;
+    table->count--;
+}
+
+struct HashNode* hash_next(const struct HashTable* table, uint32_t* cursor) {
+    while (*cursor <= table->mask) {
+        struct HashNode* node = table->slots[(*cursor)++].node;
+        if (node) {
+            return node;
+        }
+    }
+    return NULL;
+}
+
+uint32_t hash_string(const char* str) {
+    uint32_t hash = FNV_OFFSET_BASIS;
+    while (*str) {
+        hash ^= (uint8_t)*str++;
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
@@ -0,0 +1,57 @@
+/**
+ * Intrusive Open-Addressing Hash Table
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Linear probing over a caller-provided slot array. Each slot caches the
+ * full hash next to the node pointer, so a probe only touches an object
+ * when the hashes already match. Deletion shifts the following cluster
+ * back instead of leaving tombstones, so lookups never slow down as
+ * entries come and go.
+ */
+struct HashNode {
+    uint32_t hash;
+};
+
+struct HashSlot {
+    uint32_t hash;
+    struct HashNode* node;      /* NULL when the slot is empty */
+};
+
+/* Returns non-zero when `node` holds `key` */
+typedef int (*hash_match_t)(const struct HashNode* node, const void* key);
+
+struct HashTable {
+    struct HashSlot* slots;
+    uint32_t mask;              /* Slot count - 1 */
+    uint32_t count;
+    uint32_t limit;             /* Maximum entries before inserts fail */
+    hash_match_t match;
+};
+
+/* Static initializer, equivalent to hash_init() on zeroed slots */
+#define HASH_TABLE_INIT(slot_array, slot_count, match_fn) \
+    { (slot_array), (slot_count) - 1, 0, (slot_count) - (slot_count) / 4, (match_fn) }
+
+#define hash_entry(ptr, type, member) container_of(ptr, type, member)
+
+/* `slot_count` must be a power of two; load is capped at 3/4 */
+void hash_init(struct HashTable* table, struct HashSlot* slots,
+               uint32_t slot_count, hash_match_t match);
+
+/* Returns -1 when the table is at its load limit */
+int hash_insert(struct HashTable* table, struct HashNode* node, uint32_t hash);
+struct HashNode* hash_find(const struct HashTable* table, uint32_t hash, const void* key);
+void hash_remove(struct HashTable* table, struct HashNode* node);
+
+/* Iteration: start with *cursor = 0, stop at NULL */
+struct HashNode* hash_next(const struct HashTable* table, uint32_t* cursor);
+
+/* FNV-1a over a NUL-terminated string */
+uint32_t hash_string(const char* str);
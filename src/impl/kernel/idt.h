@@ -56,9 +56,29 @@
 #define ICW1_ICW4         0x01
 #define ICW4_8086         0x01
 
-/* Interrupt handler structure */
+/*
+ * Saved state of an interrupted context, as laid out on the stack by the
+ * entry stubs in interrupts.asm: general purpose registers, the vector and
+ * error code pushed by the stub (or the CPU), then the CPU's iretq frame.
+ */
 struct InterruptFrame {
-    uint64_t error_code;  /* Error code (if applicable) */
+    uint64_t rax;
+    uint64_t rbx;
+    uint64_t rcx;
+    uint64_t rdx;
+    uint64_t rsi;
+    uint64_t rdi;
+    uint64_t rbp;
+    uint64_t r8;
+    uint64_t r9;
+    uint64_t r10;
+    uint64_t r11;
+    uint64_t r12;
+    uint64_t r13;
+    uint64_t r14;
+    uint64_t r15;
+    uint64_t vector;
+    uint64_t error_code;  /* Error code (if applicable, 0 otherwise) */
     uint64_t rip;         /* Instruction pointer */
     uint64_t cs;          /* Code segment */
     uint64_t rflags;      /* CPU flags */
@@ -86,63 +106,8 @@ struct IDTPointer {
 /* Function declarations */
 void idt_init(void);
 void idt_set_entry(uint8_t num, uint64_t base, uint8_t flags);
-void idt_install(void);
 void idt_enable_interrupts(void);
 void idt_disable_interrupts(void);
 
-/* Interrupt handler type */
-typedef void (*interrupt_handler_t)(struct InterruptFrame* frame);
-
-/* Register interrupt handler */
-void idt_register_handler(uint8_t num, interrupt_handler_t handler);
-
-/* PIC functions */
-void pic_remap(uint8_t offset1, uint8_t offset2);
-void pic_set_mask(uint8_t irq);
-void pic_clear_mask(uint8_t irq);
-void pic_send_eoi(uint8_t irq);
-
-/* Default interrupt handlers */
-void isr_default_handler(struct InterruptFrame* frame);
-void isr_page_fault_handler(struct InterruptFrame* frame);
-void isr_keyboard_handler(struct InterruptFrame* frame);
-void isr_timer_handler(struct InterruptFrame* frame);
-void isr_syscall_handler(struct InterruptFrame* frame);
-
-/* Exception handlers */
-void isr_divide_by_zero(struct InterruptFrame* frame);
-void isr_debug(struct InterruptFrame* frame);
-void isr_nmi(struct InterruptFrame* frame);
-void isr_breakpoint(struct InterruptFrame* frame);
-void isr_overflow(struct InterruptFrame* frame);
-void isr_bound_range(struct InterruptFrame* frame);
-void isr_invalid_opcode(struct InterruptFrame* frame);
-void isr_device_not_available(struct InterruptFrame* frame);
-void isr_double_fault(struct InterruptFrame* frame);
-void isr_invalid_tss(struct InterruptFrame* frame);
-void isr_segment_not_present(struct InterruptFrame* frame);
-void isr_stack_segment(struct InterruptFrame* frame);
-void isr_general_protection(struct InterruptFrame* frame);
-void isr_fpu_fault(struct InterruptFrame* frame);
-void isr_alignment_check(struct InterruptFrame* frame);
-void isr_machine_check(struct InterruptFrame* frame);
-void isr_simd_exception(struct InterruptFrame* frame);
-void isr_virtualization_exception(struct InterruptFrame* frame);
-
-/* IRQ handlers */
-void isr_timer(struct InterruptFrame* frame);
-void isr_keyboard(struct InterruptFrame* frame);
-void isr_cascade(struct InterruptFrame* frame);
-void isr_com2(struct InterruptFrame* frame);
-void isr_com1(struct InterruptFrame* frame);
-void isr_lpt2(struct InterruptFrame* frame);
-void isr_floppy(struct InterruptFrame* frame);
-void isr_lpt1(struct InterruptFrame* frame);
-void isr_rtc(struct InterruptFrame* frame);
-void isr_irq9(struct InterruptFrame* frame);
-void isr_irq10(struct InterruptFrame* frame);
-void isr_irq11(struct InterruptFrame* frame);
-void isr_mouse(struct InterruptFrame* frame);
-void isr_coproc(struct InterruptFrame* frame);
-void isr_primary_ata(struct InterruptFrame* frame);
-void isr_secondary_ata(struct InterruptFrame* frame); 
\ No newline at end of file
+/* Entry stubs from interrupts.asm, indexed by vector */
+extern const uint64_t isr_stub_table[IDT_ENTRIES];
@@ -0,0 +1,151 @@
+/**
+ * Interrupt Dispatch Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "irq.h"
+#include "isr.h"
+#include "klog.h"
+#include "kstat.h"
+#include "percpu.h"
+#include "softirq.h"
+#include "irqstat.h"
+#include "asm_utils.h"
+#include "../drivers/pic/pic.h"
+
+#define EXCEPTION_VECTORS   32
+
+struct IRQAction {
+    irq_handler_t handler;
+    void* ctx;
+};
+
+static struct IRQAction irq_actions[IDT_ENTRIES];
+static DEFINE_PER_CPU(struct InterruptFrame*, irq_regs);
+
+static const struct IRQChip* irq_chip = &pic_irq_chip;
+static uint16_t legacy_unmasked = 0;
+
+DEFINE_KSTAT_ARRAY(stat_irq, "irq", IDT_ENTRIES);
+DEFINE_KSTAT_COUNTER(stat_spurious, "irq.spurious");
+DEFINE_KSTAT_COUNTER(stat_unhandled, "irq.unhandled");
+
+int irq_register(uint8_t vector, irq_handler_t handler, void* ctx) {
+    struct IRQAction* action = &irq_actions[vector];
+    int ret = 0;
+
+    uint64_t flags = asm_irq_save();
+    if (action->handler && action->handler != handler) {
+        ret = -1;
+    } else {
+        action->handler = handler;
+        action->ctx = ctx;
+    }
+    asm_irq_restore(flags);
+    return ret;
+}
+
+void irq_unregister(uint8_t vector) {
+    uint64_t flags = asm_irq_save();
+    irq_actions[vector].handler = NULL;
+    irq_actions[vector].ctx = NULL;
+    asm_irq_restore(flags);
+}
+
+int irq_alloc_vector(uint8_t priority, irq_handler_t handler, void* ctx) {
+    if (priority < IRQ_PRIORITY_MIN || priority > IRQ_PRIORITY_MAX) {
+        return -1;
+    }
+
+    uint64_t flags = asm_irq_save();
+    int vector = -1;
+    for (int i = priority << 4; i < (priority + 1) << 4; i++) {
+        if (!irq_actions[i].handler) {
+            irq_actions[i].handler = handler;
+            irq_actions[i].ctx = ctx;
+            vector = i;
+            break;
+        }
+    }
+    asm_irq_restore(flags);
+    return vector;
+}
+
+void irq_mask(uint8_t irq) {
+    uint64_t flags = asm_irq_save();
+    legacy_unmasked &= ~(1u << irq);
+    irq_chip->mask(irq);
+    asm_irq_restore(flags);
+}
+
+void irq_unmask(uint8_t irq) {
+    uint64_t flags = asm_irq_save();
+    legacy_unmasked |= 1u << irq;
+    irq_chip->unmask(irq);
+    asm_irq_restore(flags);
+}
+
+void irq_set_chip(const struct IRQChip* chip) {
+    uint64_t flags = asm_irq_save();
+    for (uint8_t irq = 0; irq < IRQ_LEGACY_COUNT; irq++) {
+        if (legacy_unmasked & (1u << irq)) {
+            irq_chip->mask(irq);
+            chip->unmask(irq);
+        }
+    }
+    irq_chip = chip;
+    asm_irq_restore(flags);
+    klog_info("[IRQ] Interrupt controller: %s", chip->name);
+}
+
+const struct IRQChip* irq_get_chip(void) {
+    return irq_chip;
+}
+
+struct InterruptFrame* irq_get_regs(void) {
+    return this_cpu(irq_regs);
+}
+
+void irq_dispatch(struct InterruptFrame* frame) {
+    uint64_t start = asm_rdtsc();
+    uint64_t vector = frame->vector;
+    struct InterruptFrame* outer = this_cpu(irq_regs);
+    int irqs_were_on = (frame->rflags & RFLAGS_IF) != 0;
+
+    /* The CPU cleared IF on entry, so the interrupted code's span starts here */
+    if (irqs_were_on && static_key_false(&irqoff_trace_key)) {
+        irqoff_trace_begin_at(frame->rip);
+    }
+
+    this_cpu(irq_regs) = frame;
+    kstat_inc_at(stat_irq, vector);
+
+    if (irq_chip->spurious(vector)) {
+        kstat_inc(stat_spurious);
+    } else {
+        struct IRQAction* action = &irq_actions[vector];
+        if (action->handler) {
+            action->handler(frame, action->ctx);
+        } else if (vector < EXCEPTION_VECTORS) {
+            isr_exception(frame);
+        } else {
+            kstat_inc(stat_unhandled);
+            klog_warn_ratelimited("[IRQ] Unhandled interrupt vector %llu", (unsigned long long)vector);
+        }
+        irq_chip->eoi(vector);
+    }
+
+    this_cpu(irq_regs) = outer;
+    irqstat_record((uint8_t)vector, asm_rdtsc() - start);
+
+    /* Bottom halves run once, after the outermost handler, if the interrupted code allowed interrupts */
+    if (!outer && irqs_were_on && softirq_pending()) {
+        softirq_run();
+    }
+
+    /* iretq turns interrupts back on */
+    if (irqs_were_on && static_key_false(&irqoff_trace_key)) {
+        irqoff_trace_end();
+    }
+}
@@ -0,0 +1,67 @@
+/**
+ * Interrupt Dispatch
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+#include "idt.h"
+
+#define IRQ_BASE_VECTOR     0x20                        /* PIC remap offset, see pic_init */
+#define IRQ_LEGACY_COUNT    16
+#define IRQ_VECTOR(irq)     (IRQ_BASE_VECTOR + (irq))
+
+/*
+ * On the APIC a vector's priority class is vector >> 4; a pending
+ * interrupt only preempts handlers of a lower class. Class 2 holds the
+ * legacy IRQs, 15 the local APIC's own vectors.
+ */
+#define IRQ_PRIORITY(vector)    ((vector) >> 4)
+#define IRQ_PRIORITY_MIN        3
+#define IRQ_PRIORITY_MAX        14
+
+typedef void (*irq_handler_t)(struct InterruptFrame* frame, void* ctx);
+
+/*
+ * Interrupt controller behind the legacy IRQ lines. The 8259 PIC is the
+ * default; the APIC driver installs its own when it takes over.
+ */
+struct IRQChip {
+    const char* name;
+    void (*mask)(uint8_t irq);
+    void (*unmask)(uint8_t irq);
+    int (*spurious)(uint64_t vector);   /* Nonzero: no handler and no EOI */
+    void (*eoi)(uint64_t vector);       /* After the handler, for every vector */
+};
+
+/*
+ * Route `vector` to `handler`, which runs with interrupts off. The
+ * dispatcher acknowledges the interrupt at the chip once the handler
+ * returns, so handlers never send an EOI themselves. Registering the
+ * same handler again only updates `ctx`. Returns -1 if another handler
+ * owns the vector. Handlers should only service the device and leave the
+ * rest to a softirq or work item (softirq.h).
+ */
+int irq_register(uint8_t vector, irq_handler_t handler, void* ctx);
+void irq_unregister(uint8_t vector);
+
+/*
+ * Register `handler` on the lowest free vector of priority class
+ * `priority` (IRQ_PRIORITY_MIN..MAX). Returns the vector, or -1.
+ */
+int irq_alloc_vector(uint8_t priority, irq_handler_t handler, void* ctx);
+
+/* Mask or unmask a legacy IRQ line at the current chip */
+void irq_mask(uint8_t irq);
+void irq_unmask(uint8_t irq);
+
+/* Switch controllers; legacy lines unmasked on the old chip are unmasked on the new one */
+void irq_set_chip(const struct IRQChip* chip);
+const struct IRQChip* irq_get_chip(void);
+
+/* Frame of the interrupt being handled, or NULL outside interrupt context */
+struct InterruptFrame* irq_get_regs(void);
+
+/* Called by the entry stubs with the saved frame */
+void irq_dispatch(struct InterruptFrame* frame);
@@ -0,0 +1,213 @@
+/**
+ * Interrupt Duration and IRQ-Off Statistics Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "irqstat.h"
+#include "irq.h"
+#include "isr.h"
+#include "idt.h"
+#include "ktime.h"
+#include "percpu.h"
+#include "asm_utils.h"
+#include "static_key.h"
+#include <stdio.h>
+#include <string.h>
+#include "../drivers/serial/serial.h"
+#include "../drivers/video/console.h"
+
+#define IRQSTAT_LINE_MAX    160
+
+struct StaticKey irqoff_trace_key = STATIC_KEY_INIT_FALSE;
+
+static DEFINE_PER_CPU(struct IRQVectorStats, vector_stats)[IDT_ENTRIES];
+static DEFINE_PER_CPU(struct IRQOffStats, irqoff_stats);
+static DEFINE_PER_CPU(uint64_t, irqoff_start);     /* 0 while no span is open */
+static DEFINE_PER_CPU(uint64_t, irqoff_ip);
+
+static uint64_t reset_ns = 0;
+static int dump_requested = 0;
+
+void irqstat_record(uint8_t vector, uint64_t cycles) {
+    struct IRQVectorStats* stats = &this_cpu(vector_stats)[vector];
+
+    stats->count++;
+    stats->cycles += cycles;
+    if (cycles > stats->max_cycles) {
+        stats->max_cycles = cycles;
+    }
+    stats->hist[irqstat_bucket(cycles)]++;
+}
+
+void irqstat_get(uint8_t vector, struct IRQVectorStats* stats) {
+    uint64_t flags = asm_irq_save();
+    *stats = this_cpu(vector_stats)[vector];
+    asm_irq_restore(flags);
+}
+
+void irqoff_get_stats(struct IRQOffStats* stats) {
+    uint64_t flags = asm_irq_save();
+    *stats = this_cpu(irqoff_stats);
+    asm_irq_restore(flags);
+}
+
+/*
+ * Called with interrupts already off (or about to go back on), so neither
+ * hook may disable or enable them itself. Nested disables keep the
+ * outermost span.
+ */
+void irqoff_trace_begin_at(uint64_t ip) {
+    if (this_cpu(irqoff_start)) {
+        return;
+    }
+    this_cpu(irqoff_ip) = ip;
+    this_cpu(irqoff_start) = asm_rdtsc();
+}
+
+__attribute__((noinline)) void irqoff_trace_begin(void) {
+    irqoff_trace_begin_at((uint64_t)__builtin_return_address(0));
+}
+
+__attribute__((noinline)) void irqoff_trace_end(void) {
+    uint64_t start = this_cpu(irqoff_start);
+    struct IRQOffStats* stats = &this_cpu(irqoff_stats);
+
+    if (!start) {
+        return;
+    }
+    uint64_t cycles = asm_rdtsc() - start;
+    this_cpu(irqoff_start) = 0;
+
+    stats->spans++;
+    stats->hist[irqstat_bucket(cycles)]++;
+    if (cycles > stats->max_cycles) {
+        stats->max_cycles = cycles;
+        stats->max_begin_ip = this_cpu(irqoff_ip);
+        stats->max_end_ip = (uint64_t)__builtin_return_address(0);
+    }
+}
+
+void irqoff_trace_enable(int enable) {
+    uint64_t flags = asm_irq_save();
+
+    if (enable) {
+        static_key_enable(&irqoff_trace_key);
+    } else {
+        static_key_disable(&irqoff_trace_key);
+    }
+    /* The asm_irq_save() above ran unhooked, so no span is open */
+    this_cpu(irqoff_start) = 0;
+    asm_irq_restore(flags);
+}
+
+int irqoff_trace_enabled(void) {
+    return static_key_enabled(&irqoff_trace_key);
+}
+
+void irqstat_reset(void) {
+    uint64_t flags = asm_irq_save();
+
+    memset(&this_cpu(vector_stats), 0, sizeof(this_cpu(vector_stats)));
+    memset(&this_cpu(irqoff_stats), 0, sizeof(this_cpu(irqoff_stats)));
+    asm_irq_restore(flags);
+    reset_ns = ktime_get_ns();
+}
+
+/* Same outputs as kstat_dump: the serial side waits rather than dropping */
+static void irqstat_emit(const char* line, int len) {
+    if (len > IRQSTAT_LINE_MAX - 1) {
+        len = IRQSTAT_LINE_MAX - 1;
+    }
+    serial_wait_room(COM1_PORT, (size_t)len);
+    serial_write_bytes(COM1_PORT, line, (size_t)len);
+    console_write_to(CONSOLE_DEBUG, line, (size_t)len);
+}
+
+/* "    2^k:n" for every non-empty bucket */
+static void irqstat_emit_hist(const uint32_t* hist) {
+    char line[IRQSTAT_LINE_MAX];
+    int len = snprintf(line, sizeof(line), "    cycles");
+
+    for (int b = 0; b < IRQSTAT_BUCKETS; b++) {
+        if (!hist[b]) {
+            continue;
+        }
+        if (len > IRQSTAT_LINE_MAX - 24) {
+            line[len++] = '\n';
+            irqstat_emit(line, len);
+            len = snprintf(line, sizeof(line), "          ");
+        }
+        len += snprintf(line + len, sizeof(line) - (size_t)len, " 2^%d:%u", b, hist[b]);
+    }
+    line[len++] = '\n';
+    irqstat_emit(line, len);
+}
+
+static void irqstat_vector_name(uint64_t vector, char* name, size_t size) {
+    if (vector < 32) {
+        snprintf(name, size, "%s", isr_exception_name(vector));
+    } else if (vector >= IRQ_BASE_VECTOR && vector < IRQ_VECTOR(IRQ_LEGACY_COUNT)) {
+        snprintf(name, size, "IRQ %llu", (unsigned long long)(vector - IRQ_BASE_VECTOR));
+    } else {
+        snprintf(name, size, "-");
+    }
+}
+
+void irqstat_dump(void) {
+    struct IRQVectorStats stats;
+    struct IRQOffStats off;
+    char line[IRQSTAT_LINE_MAX];
+    char name[32];
+    uint64_t elapsed = ktime_get_ns() - reset_ns;
+    int len;
+
+    len = snprintf(line, sizeof(line), "=== irqstat over %llu.%03llus ===\n",
+                   (unsigned long long)(elapsed / NSEC_PER_SEC),
+                   (unsigned long long)(elapsed % NSEC_PER_SEC / NSEC_PER_MSEC));
+    irqstat_emit(line, len);
+    len = snprintf(line, sizeof(line), "  %-4s %-24s %10s %10s %10s\n",
+                   "vec", "name", "count", "avg ns", "max ns");
+    irqstat_emit(line, len);
+
+    for (int v = 0; v < IDT_ENTRIES; v++) {
+        irqstat_get((uint8_t)v, &stats);
+        if (!stats.count) {
+            continue;
+        }
+        irqstat_vector_name((uint64_t)v, name, sizeof(name));
+        len = snprintf(line, sizeof(line), "  0x%02x %-24s %10llu %10llu %10llu\n", v, name,
+                       (unsigned long long)stats.count,
+                       (unsigned long long)ktime_cycles_to_ns(stats.cycles / stats.count),
+                       (unsigned long long)ktime_cycles_to_ns(stats.max_cycles));
+        irqstat_emit(line, len);
+        irqstat_emit_hist(stats.hist);
+    }
+
+    irqoff_get_stats(&off);
+    if (!irqoff_trace_enabled() && !off.spans) {
+        len = snprintf(line, sizeof(line), "  irqs-off: tracing disabled\n");
+        irqstat_emit(line, len);
+        return;
+    }
+    len = snprintf(line, sizeof(line), "  irqs-off: %llu spans, max %llu ns (0x%llx -> 0x%llx)\n",
+                   (unsigned long long)off.spans,
+                   (unsigned long long)ktime_cycles_to_ns(off.max_cycles),
+                   (unsigned long long)off.max_begin_ip,
+                   (unsigned long long)off.max_end_ip);
+    irqstat_emit(line, len);
+    if (off.spans) {
+        irqstat_emit_hist(off.hist);
+    }
+}
+
+void irqstat_request_dump(void) {
+    dump_requested = 1;
+}
+
+void irqstat_poll(void) {
+    if (dump_requested) {
+        dump_requested = 0;
+        irqstat_dump();
+    }
+}
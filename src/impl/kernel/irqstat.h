@@ -0,0 +1,62 @@
+/**
+ * Interrupt Duration and IRQ-Off Statistics
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+
+/* Bucket k counts durations of 2^k up to 2^(k+1) - 1 TSC cycles; the last is open-ended */
+#define IRQSTAT_BUCKETS     32
+
+struct IRQVectorStats {
+    uint64_t count;
+    uint64_t cycles;            /* Total handler time */
+    uint64_t max_cycles;
+    uint32_t hist[IRQSTAT_BUCKETS];
+};
+
+/*
+ * Spans with interrupts disabled, from the cli (or interrupt entry) to
+ * the matching sti (or return). Only measured while tracing is on.
+ */
+struct IRQOffStats {
+    uint64_t spans;
+    uint64_t max_cycles;
+    uint64_t max_begin_ip;      /* Where the longest span disabled interrupts */
+    uint64_t max_end_ip;        /* ...and where it enabled them again */
+    uint32_t hist[IRQSTAT_BUCKETS];
+};
+
+static inline int irqstat_bucket(uint64_t cycles) {
+    int bucket = 63 - __builtin_clzll(cycles | 1);
+    return bucket < IRQSTAT_BUCKETS ? bucket : IRQSTAT_BUCKETS - 1;
+}
+
+/* Account one handler run of `cycles`, from entry to EOI; interrupts are off */
+void irqstat_record(uint8_t vector, uint64_t cycles);
+
+void irqstat_get(uint8_t vector, struct IRQVectorStats* stats);
+void irqoff_get_stats(struct IRQOffStats* stats);
+
+/*
+ * Hook every interrupt disable/enable (asm_cli, asm_sti, asm_irq_save,
+ * interrupt entry) through a static key. Off by default; each hook then
+ * costs one NOP.
+ */
+void irqoff_trace_enable(int enable);
+int irqoff_trace_enabled(void);
+
+/* Open a span at `ip`; the dispatcher passes the interrupted RIP on entry */
+void irqoff_trace_begin_at(uint64_t ip);
+
+/* Zero every histogram and maximum */
+void irqstat_reset(void);
+
+/* Table of every vector taken, plus the IRQ-off summary, to COM1 and the debug console */
+void irqstat_dump(void);
+
+/* Ask the idle loop for a dump; safe from interrupt context */
+void irqstat_request_dump(void);
+void irqstat_poll(void);
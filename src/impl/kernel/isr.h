@@ -8,7 +8,12 @@
 
 #include "idt.h"
 
-/* Interrupt handlers */
-void isr_page_fault_handler(struct InterruptFrame* frame);
-void isr_timer_handler(struct InterruptFrame* frame);
-void isr_keyboard_handler(struct InterruptFrame* frame); 
\ No newline at end of file
+/* Mnemonic-style name of CPU exception `vector` ("Page fault", ...) */
+const char* isr_exception_name(uint64_t vector);
+
+/*
+ * Default handling for CPU exceptions without a registered handler:
+ * debug traps, breakpoints, overflow and NMIs are logged and resumed,
+ * every other exception dumps the frame over serial and halts.
+ */
+void isr_exception(struct InterruptFrame* frame);
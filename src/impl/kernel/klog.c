@@ -0,0 +1,272 @@
+/**
+ * Kernel Log Ring Buffer Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "klog.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "ktime.h"
+#include "../drivers/serial/serial.h"
+#include "../drivers/video/console.h"
+#include "asm_utils.h"
+
+#define KLOG_MASK           (KLOG_BUFFER_SIZE - 1)
+
+static uint8_t klog_buffer[KLOG_BUFFER_SIZE] __attribute__((aligned(KLOG_ALIGN)));
+
+/*
+ * Positions grow without wrapping; the ring offset is position & mask.
+ * Writers claim [head, head + size) with a compare-and-swap and may not
+ * pass tail + KLOG_BUFFER_SIZE, where tail is the slowest drain's cursor.
+ */
+static uint64_t klog_head = 0;
+static uint64_t klog_tail = 0;
+
+static struct ListNode drains = LIST_HEAD_INIT(drains);
+static int draining = 0;
+static int async_mode = 0;
+
+static struct KLogStats stats;
+static uint64_t reported_drops = 0;
+
+static const char* level_names[KLOG_LEVELS] = {
+    "CRIT", "ERROR", "WARN", "INFO", "DEBUG"
+};
+
+static inline struct KLogRecord* record_at(uint64_t pos) {
+    return (struct KLogRecord*)&klog_buffer[pos & KLOG_MASK];
+}
+
+static inline uint64_t klog_clock(void) {
+    return ktime_get_ns();
+}
+
+const char* klog_level_name(int level) {
+    return (level >= 0 && level < KLOG_LEVELS) ? level_names[level] : "?";
+}
+
+int klog_write(int level, const char* text, size_t length) {
+    /* One record per line: the drains add the newline */
+    if (length && text[length - 1] == '\n') {
+        length--;
+    }
+    if (length > KLOG_MAX_MESSAGE) {
+        length = KLOG_MAX_MESSAGE;
+        __atomic_fetch_add(&stats.truncated, 1, __ATOMIC_RELAXED);
+    }
+
+    uint64_t size = (sizeof(struct KLogRecord) + length + KLOG_ALIGN - 1) & ~(uint64_t)(KLOG_ALIGN - 1);
+    uint64_t head = __atomic_load_n(&klog_head, __ATOMIC_RELAXED);
+    uint64_t pad;
+    uint64_t next;
+
+    do {
+        /* Records never straddle the end; pad out to it instead */
+        uint64_t offset = head & KLOG_MASK;
+        pad = offset + size > KLOG_BUFFER_SIZE ? KLOG_BUFFER_SIZE - offset : 0;
+        next = head + pad + size;
+
+        if (next - __atomic_load_n(&klog_tail, __ATOMIC_ACQUIRE) > KLOG_BUFFER_SIZE) {
+            __atomic_fetch_add(&stats.dropped, 1, __ATOMIC_RELAXED);
+            return -1;
+        }
+    } while (!__atomic_compare_exchange_n(&klog_head, &head, next, 1,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    if (pad) {
+        struct KLogRecord* filler = record_at(head);
+        filler->size = (uint16_t)pad;
+        filler->length = 0;
+        filler->flags = KLOG_FLAG_PAD;
+        __atomic_store_n(&filler->commit, head + 1, __ATOMIC_RELEASE);
+        head += pad;
+    }
+
+    struct KLogRecord* record = record_at(head);
+    record->timestamp = klog_clock();
+    record->size = (uint16_t)size;
+    record->length = (uint16_t)length;
+    record->level = (uint8_t)level;
+    record->flags = 0;
+    memcpy(record + 1, text, length);
+    __atomic_store_n(&record->commit, head + 1, __ATOMIC_RELEASE);
+
+    __atomic_fetch_add(&stats.written, 1, __ATOMIC_RELAXED);
+
+    if (!__atomic_load_n(&async_mode, __ATOMIC_RELAXED)) {
+        klog_drain();
+    }
+    return 0;
+}
+
+int klog(int level, const char* format, ...) {
+    char message[KLOG_MAX_MESSAGE + 1];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+
+    if (length > KLOG_MAX_MESSAGE) {
+        length = KLOG_MAX_MESSAGE;
+    }
+    return klog_write(level, message, (size_t)length);
+}
+
+void klog_register_drain(struct KLogDrain* drain) {
+    drain->cursor = __atomic_load_n(&klog_tail, __ATOMIC_ACQUIRE);
+    drain->emitted = 0;
+    list_add_tail(&drain->link, &drains);
+}
+
+/* Must not race with klog_drain(); the slot it held is released on the next pass */
+void klog_unregister_drain(struct KLogDrain* drain) {
+    list_del(&drain->link);
+}
+
+int klog_drain(void) {
+    /* Single consumer context; a nested call just leaves the work to the outer one */
+    if (__atomic_exchange_n(&draining, 1, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+
+    uint64_t head = __atomic_load_n(&klog_head, __ATOMIC_ACQUIRE);
+    uint64_t tail = head;
+    int consumed = 0;
+    struct KLogDrain* drain;
+
+    list_for_each_entry(drain, &drains, link) {
+        while (drain->cursor != head) {
+            struct KLogRecord* record = record_at(drain->cursor);
+
+            /* Stop at a record whose writer has not finished yet */
+            if (__atomic_load_n(&record->commit, __ATOMIC_ACQUIRE) != drain->cursor + 1) {
+                break;
+            }
+            if (!(record->flags & KLOG_FLAG_PAD) && record->level <= drain->max_level) {
+                if (drain->emit(drain, record, (const char*)(record + 1)) != 0) {
+                    break;
+                }
+                drain->emitted++;
+            }
+            drain->cursor += record->size;
+            consumed++;
+        }
+        if (drain->cursor < tail) {
+            tail = drain->cursor;
+        }
+    }
+
+    __atomic_store_n(&klog_tail, tail, __ATOMIC_RELEASE);
+    __atomic_store_n(&draining, 0, __ATOMIC_RELEASE);
+
+    /* Report losses through the log itself once there is room again */
+    uint64_t dropped = __atomic_load_n(&stats.dropped, __ATOMIC_RELAXED);
+    if (dropped != reported_drops) {
+        uint64_t lost = dropped - reported_drops;
+        reported_drops = dropped;
+        klog(KLOG_WARN, "[KLOG] %llu records dropped (buffer full)", (unsigned long long)lost);
+    }
+
+    return consumed;
+}
+
+void klog_start_async(void) {
+    __atomic_store_n(&async_mode, 1, __ATOMIC_RELEASE);
+}
+
+void klog_flush(void) {
+    while (klog_drain() > 0) {
+    }
+}
+
+void klog_get_stats(struct KLogStats* out) {
+    out->written = __atomic_load_n(&stats.written, __ATOMIC_RELAXED);
+    out->dropped = __atomic_load_n(&stats.dropped, __ATOMIC_RELAXED);
+    out->truncated = __atomic_load_n(&stats.truncated, __ATOMIC_RELAXED);
+    out->pending = __atomic_load_n(&klog_head, __ATOMIC_ACQUIRE) -
+                   __atomic_load_n(&klog_tail, __ATOMIC_ACQUIRE);
+}
+
+int klog_ratelimit(struct KLogRateLimit* state, const char* site) {
+    uint64_t now = klog_clock();
+    uint32_t missed = 0;
+    int allowed;
+
+    uint64_t flags = asm_irq_save();
+    if (!state->begin || now - state->begin >= (uint64_t)state->interval_ms * 1000000) {
+        missed = state->missed;
+        state->begin = now ? now : 1;
+        state->printed = 0;
+        state->missed = 0;
+    }
+    allowed = state->printed < state->burst;
+    if (allowed) {
+        state->printed++;
+    } else {
+        state->missed++;
+    }
+    asm_irq_restore(flags);
+
+    if (missed) {
+        klog(KLOG_WARN, "%s: %u messages suppressed", site, missed);
+    }
+    return allowed;
+}
+
+/* Built-in drains */
+
+/* Longest line prefix the drains add: "[sssss.uuuuuu] LEVEL: " */
+#define KLOG_PREFIX_MAX     32
+
+static int serial_emit(struct KLogDrain* drain, const struct KLogRecord* record,
+                       const char* text) {
+    (void)drain;
+
+    /* Wait for the UART to catch up rather than lose the tail of a line */
+    if (serial_tx_room(COM1_PORT) < (size_t)record->length + KLOG_PREFIX_MAX) {
+        return -1;
+    }
+
+    uint64_t usec = record->timestamp / 1000;
+    serial_printf(COM1_PORT, "[%5llu.%06llu] %s: %.*s\n",
+                  (unsigned long long)(usec / 1000000), (unsigned long long)(usec % 1000000),
+                  klog_level_name(record->level), (int)record->length, text);
+    return 0;
+}
+
+/* Debug records go to the debug console, everything else to the boot log */
+static int console_emit(struct KLogDrain* drain, const struct KLogRecord* record,
+                        const char* text) {
+    (void)drain;
+    char line[KLOG_MAX_MESSAGE + KLOG_PREFIX_MAX];
+    uint64_t msec = record->timestamp / 1000000;
+    int length = snprintf(line, sizeof(line), "[%5llu.%03llu] %.*s\n",
+                          (unsigned long long)(msec / 1000), (unsigned long long)(msec % 1000),
+                          (int)record->length, text);
+    if (length > (int)sizeof(line) - 1) {
+        length = sizeof(line) - 1;
+    }
+    console_write_to(record->level == KLOG_DEBUG ? CONSOLE_DEBUG : CONSOLE_BOOT_LOG, line, (size_t)length);
+    return 0;
+}
+
+static struct KLogDrain serial_drain = {
+    .name = "serial",
+    .max_level = KLOG_DEBUG,
+    .emit = serial_emit
+};
+
+static struct KLogDrain console_drain = {
+    .name = "console",
+    .max_level = KLOG_DEBUG,
+    .emit = console_emit
+};
+
+void klog_init(void) {
+    list_init(&drains);
+    klog_register_drain(&serial_drain);
+    klog_register_drain(&console_drain);
+}
@@ -0,0 +1,150 @@
+/**
+ * Kernel Log Ring Buffer
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "list.h"
+
+/* Severity levels, most severe first */
+#define KLOG_CRIT           0
+#define KLOG_ERROR          1
+#define KLOG_WARN           2
+#define KLOG_INFO           3
+#define KLOG_DEBUG          4
+#define KLOG_LEVELS         5
+
+/* Ring size in bytes; power of two */
+#define KLOG_BUFFER_SIZE    (64 * 1024)
+
+/* Longest formatted message; longer ones are truncated */
+#define KLOG_MAX_MESSAGE    256
+
+/*
+ * Record layout in the ring. `commit` is written last, holding the
+ * record's own ring position plus one, so a reader can tell a finished
+ * record from a slot still being filled or left over from an earlier lap.
+ */
+struct KLogRecord {
+    uint64_t commit;
+    uint64_t timestamp;     /* Nanoseconds since boot */
+    uint16_t size;          /* Whole record including header, KLOG_ALIGN multiple */
+    uint16_t length;        /* Message bytes following the header */
+    uint8_t level;
+    uint8_t flags;
+    uint16_t reserved;
+};
+
+#define KLOG_ALIGN          32      /* Any gap at the ring end can hold a header */
+#define KLOG_FLAG_PAD       0x01    /* Filler up to the end of the ring */
+
+/*
+ * A drain consumes records at its own pace. Each has a private cursor;
+ * writers only see the ring as full once the slowest drain falls a full
+ * buffer behind, and then new records are dropped and counted. emit()
+ * returns nonzero when its device has no room; the record is retried on
+ * the next pass.
+ */
+struct KLogDrain {
+    const char* name;
+    int max_level;          /* Skip records less severe than this */
+    int (*emit)(struct KLogDrain* drain, const struct KLogRecord* record,
+                const char* text);
+    uint64_t cursor;
+    uint64_t emitted;
+    struct ListNode link;
+};
+
+struct KLogStats {
+    uint64_t written;
+    uint64_t dropped;       /* Ring full at reservation */
+    uint64_t truncated;     /* Message longer than KLOG_MAX_MESSAGE */
+    uint64_t pending;       /* Bytes not yet consumed by every drain */
+};
+
+void klog_init(void);
+
+/* Append a message; safe from any context, never waits on a device */
+int klog_write(int level, const char* text, size_t length);
+int klog(int level, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+/* Attach a drain; it starts at the oldest record still buffered */
+void klog_register_drain(struct KLogDrain* drain);
+void klog_unregister_drain(struct KLogDrain* drain);
+
+/*
+ * Feed buffered records to every drain. Called from the idle loop;
+ * returns the number of records consumed.
+ */
+int klog_drain(void);
+
+/* Drain synchronously on every write until klog_start_async() */
+void klog_start_async(void);
+
+/* Push out everything buffered, e.g. before halting */
+void klog_flush(void);
+
+void klog_get_stats(struct KLogStats* stats);
+const char* klog_level_name(int level);
+
+/*
+ * Build-time filter: call sites less severe than this are dead code and
+ * the compiler drops them along with their format strings. Set from the
+ * Makefile (KLOG_LEVEL=4 for a debug build) or per file before including.
+ */
+#ifndef KLOG_COMPILE_LEVEL
+#define KLOG_COMPILE_LEVEL  KLOG_INFO
+#endif
+
+#define klog_at(level, format, ...) \
+    do { \
+        if ((level) <= KLOG_COMPILE_LEVEL) { \
+            klog((level), format, ##__VA_ARGS__); \
+        } \
+    } while (0)
+
+#define klog_crit(format, ...)      klog_at(KLOG_CRIT, format, ##__VA_ARGS__)
+#define klog_err(format, ...)       klog_at(KLOG_ERROR, format, ##__VA_ARGS__)
+#define klog_warn(format, ...)      klog_at(KLOG_WARN, format, ##__VA_ARGS__)
+#define klog_info(format, ...)      klog_at(KLOG_INFO, format, ##__VA_ARGS__)
+#define klog_debug(format, ...)     klog_at(KLOG_DEBUG, format, ##__VA_ARGS__)
+
+/* Rate limiting: at most `burst` messages per `interval_ms` per call site */
+#define KLOG_RATELIMIT_INTERVAL_MS  5000
+#define KLOG_RATELIMIT_BURST        10
+
+struct KLogRateLimit {
+    uint64_t begin;         /* Start of the current interval, ns */
+    uint32_t interval_ms;
+    uint32_t burst;
+    uint32_t printed;
+    uint32_t missed;        /* Suppressed in the current interval */
+};
+
+#define KLOG_RATELIMIT_INIT(interval, limit) \
+    { .begin = 0, .interval_ms = (interval), .burst = (limit), .printed = 0, .missed = 0 }
+
+/*
+ * Returns nonzero if the caller may log. When a new interval starts after
+ * suppressions, reports how many messages `site` lost.
+ */
+int klog_ratelimit(struct KLogRateLimit* state, const char* site);
+
+#define klog_at_ratelimited(level, format, ...) \
+    do { \
+        if ((level) <= KLOG_COMPILE_LEVEL) { \
+            static struct KLogRateLimit klog_rs_ = \
+                KLOG_RATELIMIT_INIT(KLOG_RATELIMIT_INTERVAL_MS, KLOG_RATELIMIT_BURST); \
+            if (klog_ratelimit(&klog_rs_, __func__)) { \
+                klog((level), format, ##__VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+
+#define klog_err_ratelimited(format, ...)   klog_at_ratelimited(KLOG_ERROR, format, ##__VA_ARGS__)
+#define klog_warn_ratelimited(format, ...)  klog_at_ratelimited(KLOG_WARN, format, ##__VA_ARGS__)
+#define klog_info_ratelimited(format, ...)  klog_at_ratelimited(KLOG_INFO, format, ##__VA_ARGS__)
+#define klog_debug_ratelimited(format, ...) klog_at_ratelimited(KLOG_DEBUG, format, ##__VA_ARGS__)
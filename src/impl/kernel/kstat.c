@@ -0,0 +1,123 @@
+/**
+ * Kernel Statistics Registry Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "kstat.h"
+#include "ktime.h"
+#include <stdio.h>
+#include <string.h>
+#include "../drivers/serial/serial.h"
+#include "../drivers/video/console.h"
+
+#define KSTAT_LINE_MAX  96
+
+/* Provided by the linker script */
+extern struct KStat* const __kstat_start[];
+extern struct KStat* const __kstat_end[];
+
+static uint64_t last_dump_ns = 0;
+static int dump_requested = 0;
+
+uint64_t kstat_read(const struct KStat* stat, uint32_t index) {
+    uint64_t sum = 0;
+    if (index >= stat->count) {
+        return 0;
+    }
+    for (int cpu = 0; cpu < MAX_CPUS; cpu++) {
+        sum += stat->values[cpu * stat->count + index];
+    }
+    return sum;
+}
+
+size_t kstat_count(void) {
+    return (size_t)(__kstat_end - __kstat_start);
+}
+
+struct KStat* kstat_get(size_t id) {
+    return id < kstat_count() ? __kstat_start[id] : NULL;
+}
+
+struct KStat* kstat_find(const char* name) {
+    for (struct KStat* const* p = __kstat_start; p < __kstat_end; p++) {
+        if (strcmp((*p)->name, name) == 0) {
+            return *p;
+        }
+    }
+    return NULL;
+}
+
+/* One line to both outputs; the serial side waits rather than dropping */
+static void kstat_emit(const char* line, int len) {
+    if (len > KSTAT_LINE_MAX - 1) {
+        len = KSTAT_LINE_MAX - 1;
+    }
+    serial_wait_room(COM1_PORT, (size_t)len);
+    serial_write_bytes(COM1_PORT, line, (size_t)len);
+    console_write_to(CONSOLE_DEBUG, line, (size_t)len);
+}
+
+static void kstat_dump_entry(struct KStat* stat, uint32_t index, int delta, uint64_t elapsed_ns) {
+    char name[40];
+    char line[KSTAT_LINE_MAX];
+    uint64_t value = kstat_read(stat, index);
+    uint64_t change = value - stat->last[index];
+    int len;
+
+    if (stat->count > 1) {
+        if (value == 0) {
+            return;
+        }
+        snprintf(name, sizeof(name), "%s.%u", stat->name, index);
+    } else {
+        snprintf(name, sizeof(name), "%s", stat->name);
+    }
+
+    if (!delta || stat->type == KSTAT_GAUGE) {
+        len = snprintf(line, sizeof(line), "  %-24s %llu\n", name, (unsigned long long)value);
+    } else {
+        uint64_t elapsed_ms = elapsed_ns / NSEC_PER_MSEC;
+        uint64_t rate = elapsed_ms ? change * 1000 / elapsed_ms : 0;
+        len = snprintf(line, sizeof(line), "  %-24s +%llu (%llu/s)\n", name,
+                       (unsigned long long)change, (unsigned long long)rate);
+    }
+    if (delta) {
+        stat->last[index] = value;
+    }
+    kstat_emit(line, len);
+}
+
+void kstat_dump(int delta) {
+    char line[KSTAT_LINE_MAX];
+    uint64_t now = ktime_get_ns();
+    uint64_t elapsed = now - last_dump_ns;
+    int len;
+
+    if (delta) {
+        len = snprintf(line, sizeof(line), "=== kstat delta over %llu.%03llus ===\n",
+                       (unsigned long long)(elapsed / NSEC_PER_SEC),
+                       (unsigned long long)(elapsed % NSEC_PER_SEC / NSEC_PER_MSEC));
+        last_dump_ns = now;
+    } else {
+        len = snprintf(line, sizeof(line), "=== kstat ===\n");
+    }
+    kstat_emit(line, len);
+
+    for (struct KStat* const* p = __kstat_start; p < __kstat_end; p++) {
+        for (uint32_t i = 0; i < (*p)->count; i++) {
+            kstat_dump_entry(*p, i, delta, elapsed);
+        }
+    }
+}
+
+void kstat_request_dump(void) {
+    dump_requested = 1;
+}
+
+void kstat_poll(void) {
+    if (dump_requested) {
+        dump_requested = 0;
+        kstat_dump(1);
+    }
+}
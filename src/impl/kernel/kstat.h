@@ -0,0 +1,64 @@
+/**
+ * Kernel Statistics Registry
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "percpu.h"
+
+#define KSTAT_COUNTER   0       /* Only goes up; dumps can show rates */
+#define KSTAT_GAUGE     1       /* Current level, e.g. open files */
+
+/*
+ * A named 64-bit statistic, or an array of them (one per interrupt
+ * vector, say). Every CPU updates its own slots with plain adds, no locks
+ * or atomics; readers sum the slots. Dumps skip zero array entries.
+ */
+struct KStat {
+    const char* name;
+    uint32_t type;
+    uint32_t count;         /* Entries: 1, or the array length */
+    uint64_t* values;       /* [MAX_CPUS][count] */
+    uint64_t* last;         /* [count] totals at the last delta dump */
+};
+
+#define DEFINE_KSTAT_(var, statname, kind, n)                               \
+    static uint64_t __kstat_values_##var[MAX_CPUS][n];                      \
+    static uint64_t __kstat_last_##var[n];                                  \
+    static struct KStat var = {                                             \
+        statname, kind, n, &__kstat_values_##var[0][0], __kstat_last_##var  \
+    };                                                                      \
+    static struct KStat* const __kstat_ptr_##var                            \
+        __attribute__((section(".kstat"), used, aligned(8))) = &var
+
+#define DEFINE_KSTAT_COUNTER(var, statname)         DEFINE_KSTAT_(var, statname, KSTAT_COUNTER, 1)
+#define DEFINE_KSTAT_GAUGE(var, statname)           DEFINE_KSTAT_(var, statname, KSTAT_GAUGE, 1)
+#define DEFINE_KSTAT_ARRAY(var, statname, n)        DEFINE_KSTAT_(var, statname, KSTAT_COUNTER, n)
+
+/* This CPU's slot for entry `i`; only this CPU writes it */
+#define kstat_slot(var, i)          ((var).values[cpu_id() * (var).count + (i)])
+
+#define kstat_inc(var)              (kstat_slot(var, 0)++)
+#define kstat_add(var, n)           (kstat_slot(var, 0) += (uint64_t)(n))
+#define kstat_inc_at(var, i)        (kstat_slot(var, i)++)
+#define kstat_sub(var, n)           (kstat_slot(var, 0) -= (uint64_t)(n))
+
+/* Sum of entry `index` over all CPUs */
+uint64_t kstat_read(const struct KStat* stat, uint32_t index);
+
+size_t kstat_count(void);
+struct KStat* kstat_get(size_t id);
+struct KStat* kstat_find(const char* name);
+
+/*
+ * Print every statistic to COM1 and the debug console. With `delta`,
+ * counters show the change and rate since the previous delta dump.
+ */
+void kstat_dump(int delta);
+
+/* Ask the idle loop for a delta dump; safe from interrupt context */
+void kstat_request_dump(void);
+void kstat_poll(void);
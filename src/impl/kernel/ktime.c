@@ -0,0 +1,207 @@
+/**
+ * Monotonic Kernel Time Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "ktime.h"
+#include "seqlock.h"
+#include "asm_utils.h"
+#include "klog.h"
+#include "sysinfo.h"
+#include "../drivers/pit/pit.h"
+#include "../drivers/hpet/hpet.h"
+
+#define CALIBRATE_RUNS      5
+#define CALIBRATE_MS        10
+#define HPET_CALIBRATE_MS   20
+
+/*
+ * ns = base_ns + ((tsc - base_tsc) * mult) >> 32. The multiply is done in
+ * 128 bits so intervals never overflow and no periodic rebase is needed.
+ * The seqlock only guards the rare rate changes.
+ */
+static struct SeqLock clock_lock = SEQLOCK_INIT;
+static uint64_t base_tsc = 0;
+static uint64_t base_ns = 0;
+static uint64_t mult = 0;
+static uint64_t tsc_hz = 0;
+static int use_tsc = 0;
+
+/* HPET counter in place of a TSC that could not be calibrated */
+static uint64_t base_hpet = 0;
+static uint64_t hpet_mult = 0;
+static int use_hpet = 0;
+
+/* Wall clock minus monotonic time */
+static uint64_t real_offset = 0;
+
+static inline uint64_t scale(uint64_t cycles, uint64_t factor) {
+    return (uint64_t)(((unsigned __int128)cycles * factor) >> 32);
+}
+
+/* Median of several short runs; an SMI or emulator hiccup only skews one */
+static uint64_t calibrate_tsc(uint64_t (*measure)(uint32_t ms), uint32_t ms) {
+    uint64_t runs[CALIBRATE_RUNS];
+
+    for (int i = 0; i < CALIBRATE_RUNS; i++) {
+        runs[i] = measure(ms);
+        if (runs[i] == 0) {
+            return 0;
+        }
+        for (int j = i; j > 0 && runs[j] < runs[j - 1]; j--) {
+            uint64_t t = runs[j];
+            runs[j] = runs[j - 1];
+            runs[j - 1] = t;
+        }
+    }
+
+    if (runs[CALIBRATE_RUNS - 1] - runs[0] > runs[0] / 100) {
+        klog_warn("[TIME] TSC calibration spread %llu..%llu Hz",
+                  (unsigned long long)runs[0], (unsigned long long)runs[CALIBRATE_RUNS - 1]);
+    }
+    return runs[CALIBRATE_RUNS / 2];
+}
+
+void ktime_init(void) {
+    uint64_t hz = calibrate_tsc(pit_calibrate_tsc, CALIBRATE_MS);
+    if (hz == 0) {
+        klog_err("[TIME] PIT channel 2 calibration failed; using %d Hz ticks", PIT_DEFAULT_HZ);
+        return;
+    }
+
+    uint64_t flags = asm_irq_save();
+    seq_write_begin(&clock_lock);
+    base_tsc = asm_rdtsc();
+    base_ns = 0;
+    tsc_hz = hz;
+    mult = (NSEC_PER_SEC << 32) / hz;
+    use_tsc = 1;
+    seq_write_end(&clock_lock);
+    asm_irq_restore(flags);
+
+    klog_info("[TIME] TSC clocksource at %llu.%03llu MHz%s", (unsigned long long)(hz / 1000000),
+              (unsigned long long)(hz / 1000 % 1000),
+              sysinfo_has_feature(CPU_FEATURE_INVARIANT_TSC) ? "" : " (not invariant, may drift with CPU frequency)");
+}
+
+uint64_t ktime_get_ns(void) {
+    uint64_t ns;
+    uint32_t seq;
+
+    if (!use_tsc && !use_hpet) {
+        return pit_get_ticks() * (NSEC_PER_SEC / PIT_DEFAULT_HZ);
+    }
+    do {
+        seq = seq_read_begin(&clock_lock);
+        if (use_tsc) {
+            ns = base_ns + scale(asm_rdtsc() - base_tsc, mult);
+        } else {
+            ns = base_ns + scale(hpet_read_counter() - base_hpet, hpet_mult);
+        }
+    } while (seq_read_retry(&clock_lock, seq));
+    return ns;
+}
+
+uint64_t ktime_get_real(void) {
+    uint64_t offset;
+    uint32_t seq;
+
+    do {
+        seq = seq_read_begin(&clock_lock);
+        offset = real_offset;
+    } while (seq_read_retry(&clock_lock, seq));
+    return offset + ktime_get_ns();
+}
+
+void ktime_set_real(uint64_t epoch_ns) {
+    /* Read the clock before taking the write side; readers spin while it is held */
+    uint64_t flags = asm_irq_save();
+    uint64_t now = ktime_get_ns();
+    seq_write_begin(&clock_lock);
+    real_offset = epoch_ns - now;
+    seq_write_end(&clock_lock);
+    asm_irq_restore(flags);
+}
+
+uint64_t ktime_tsc_to_ns(uint64_t tsc) {
+    uint64_t ns;
+    uint32_t seq;
+
+    do {
+        seq = seq_read_begin(&clock_lock);
+        if (tsc >= base_tsc) {
+            ns = base_ns + scale(tsc - base_tsc, mult);
+        } else {
+            uint64_t back = scale(base_tsc - tsc, mult);
+            ns = back < base_ns ? base_ns - back : 0;
+        }
+    } while (seq_read_retry(&clock_lock, seq));
+    return ns;
+}
+
+uint64_t ktime_cycles_to_ns(uint64_t cycles) {
+    return scale(cycles, mult);
+}
+
+uint64_t ktime_tsc_hz(void) {
+    return tsc_hz;
+}
+
+void ktime_set_tsc_hz(uint64_t hz) {
+    if (!use_tsc || hz == 0) {
+        return;
+    }
+
+    /* Rebase at the current instant so time continues without a step */
+    uint64_t flags = asm_irq_save();
+    seq_write_begin(&clock_lock);
+    uint64_t now = asm_rdtsc();
+    base_ns += scale(now - base_tsc, mult);
+    base_tsc = now;
+    tsc_hz = hz;
+    mult = (NSEC_PER_SEC << 32) / hz;
+    seq_write_end(&clock_lock);
+    asm_irq_restore(flags);
+}
+
+void ktime_use_hpet(void) {
+    if (!hpet_available()) {
+        return;
+    }
+
+    if (use_tsc) {
+        /* Longer windows on a 10 MHz+ counter beat the PIT's 1.19 MHz */
+        uint64_t hz = calibrate_tsc(hpet_calibrate_tsc, HPET_CALIBRATE_MS);
+        if (hz) {
+            int64_t ppm = ((int64_t)hz - (int64_t)tsc_hz) * 1000000 / (int64_t)tsc_hz;
+            ktime_set_tsc_hz(hz);
+            klog_info("[TIME] TSC rate refined against the HPET: %llu Hz (%lld ppm)",
+                      (unsigned long long)hz, (long long)ppm);
+        }
+        return;
+    }
+
+    /* A 32-bit counter wraps within minutes; only a 64-bit one can stand in */
+    if (!hpet_counter_is_64bit()) {
+        return;
+    }
+    uint64_t flags = asm_irq_save();
+    uint64_t now = ktime_get_ns();
+    seq_write_begin(&clock_lock);
+    base_ns = now;
+    base_hpet = hpet_read_counter();
+    hpet_mult = (NSEC_PER_SEC << 32) / hpet_get_frequency();
+    use_hpet = 1;
+    seq_write_end(&clock_lock);
+    asm_irq_restore(flags);
+    klog_info("[TIME] HPET clocksource");
+}
+
+int ktime_high_res(void) {
+    return use_tsc || use_hpet;
+}
+
+const char* ktime_source_name(void) {
+    return use_tsc ? "tsc" : use_hpet ? "hpet" : "pit";
+}
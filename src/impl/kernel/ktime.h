@@ -0,0 +1,69 @@
+/**
+ * Monotonic Kernel Time
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+
+#define NSEC_PER_USEC   1000ull
+#define NSEC_PER_MSEC   1000000ull
+#define NSEC_PER_SEC    1000000000ull
+
+/*
+ * Calibrate the TSC against PIT channel 2 and make it the clocksource.
+ * Runs with interrupts off, before anything wants timestamps. If the
+ * calibration fails the clock falls back to PIT ticks. Call after
+ * sysinfo_init(), which detects whether the TSC is invariant.
+ */
+void ktime_init(void);
+
+/* Nanoseconds since ktime_init(); safe from any context, never goes back */
+uint64_t ktime_get_ns(void);
+
+static inline uint64_t ktime_get_us(void) {
+    return ktime_get_ns() / NSEC_PER_USEC;
+}
+
+static inline uint64_t ktime_get_ms(void) {
+    return ktime_get_ns() / NSEC_PER_MSEC;
+}
+
+/*
+ * Wall-clock time in nanoseconds since the Unix epoch (UTC), kept as an
+ * offset from ktime_get_ns(): no port I/O, safe from any context. Counts
+ * from 0 until the RTC driver sets it; it may step at RTC resyncs.
+ */
+uint64_t ktime_get_real(void);
+
+static inline uint64_t ktime_get_real_seconds(void) {
+    return ktime_get_real() / NSEC_PER_SEC;
+}
+
+/* Make the wall clock read `epoch_ns` now */
+void ktime_set_real(uint64_t epoch_ns);
+
+/* Convert a raw asm_rdtsc() value to the ktime_get_ns() timeline */
+uint64_t ktime_tsc_to_ns(uint64_t tsc);
+
+/* Length of a TSC interval in nanoseconds */
+uint64_t ktime_cycles_to_ns(uint64_t cycles);
+
+/* Calibrated TSC rate; 0 when the TSC is not the clocksource */
+uint64_t ktime_tsc_hz(void);
+
+/* Replace the TSC rate (e.g. from a better reference) without a time step */
+void ktime_set_tsc_hz(uint64_t hz);
+
+/*
+ * Once the HPET is up: recalibrate the TSC against it, or make its main
+ * counter the clocksource if the TSC could not be calibrated.
+ */
+void ktime_use_hpet(void);
+
+/* Time comes from a free-running counter rather than tick counting */
+int ktime_high_res(void);
+
+/* "tsc", "hpet" or "pit" */
+const char* ktime_source_name(void);
@@ -0,0 +1,97 @@
+/**
+ * Intrusive Doubly Linked List
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stddef.h>
+
+/*
+ * Circular list with a sentinel head. Objects embed a ListNode and are
+ * recovered with list_entry(), so linking never allocates.
+ */
+struct ListNode {
+    struct ListNode* next;
+    struct ListNode* prev;
+};
+
+#define LIST_HEAD_INIT(name) { &(name), &(name) }
+
+#define list_entry(ptr, type, member) container_of(ptr, type, member)
+
+static inline void list_init(struct ListNode* head) {
+    head->next = head;
+    head->prev = head;
+}
+
+static inline int list_empty(const struct ListNode* head) {
+    return head->next == head;
+}
+
+static inline void list_insert_between(struct ListNode* node,
+                                       struct ListNode* prev,
+                                       struct ListNode* next) {
+    next->prev = node;
+    node->next = next;
+    node->prev = prev;
+    prev->next = node;
+}
+
+/* Insert at the front */
+static inline void list_add(struct ListNode* node, struct ListNode* head) {
+    list_insert_between(node, head, head->next);
+}
+
+/* Insert at the back */
+static inline void list_add_tail(struct ListNode* node, struct ListNode* head) {
+    list_insert_between(node, head->prev, head);
+}
+
+/* Unlink; the node is left self-linked so a second delete is harmless */
+static inline void list_del(struct ListNode* node) {
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    list_init(node);
+}
+
+static inline void list_move_tail(struct ListNode* node, struct ListNode* head) {
+    list_del(node);
+    list_add_tail(node, head);
+}
+
+/* Move every entry of `list` to the back of `head`, leaving `list` empty */
+static inline void list_splice_tail_init(struct ListNode* list, struct ListNode* head) {
+    if (!list_empty(list)) {
+        list->next->prev = head->prev;
+        head->prev->next = list->next;
+        list->prev->next = head;
+        head->prev = list->prev;
+        list_init(list);
+    }
+}
+
+static inline struct ListNode* list_first(const struct ListNode* head) {
+    return list_empty(head) ? NULL : head->next;
+}
+
+static inline struct ListNode* list_last(const struct ListNode* head) {
+    return list_empty(head) ? NULL : head->prev;
+}
+
+#define list_for_each_entry(pos, head, member)                              \
+    for (pos = list_entry((head)->next, __typeof__(*pos), member);          \
+         &pos->member != (head);                                            \
+         pos = list_entry(pos->member.next, __typeof__(*pos), member))
+
+#define list_for_each_entry_reverse(pos, head, member)                      \
+    for (pos = list_entry((head)->prev, __typeof__(*pos), member);          \
+         &pos->member != (head);                                            \
+         pos = list_entry(pos->member.prev, __typeof__(*pos), member))
+
+/* Safe against removal of the current entry */
+#define list_for_each_entry_safe(pos, tmp, head, member)                    \
+    for (pos = list_entry((head)->next, __typeof__(*pos), member),          \
+         tmp = list_entry(pos->member.next, __typeof__(*pos), member);      \
+         &pos->member != (head);                                            \
+         pos = tmp, tmp = list_entry(tmp->member.next, __typeof__(*pos), member))
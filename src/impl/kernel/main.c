@@ -12,15 +12,33 @@
 #include "idt.h"
 #include "sysinfo.h"
 #include "mmu.h"
+#include "fpu.h"
+#include "crc32c.h"
+#include "alternative.h"
 #include "asm_utils.h"
+#include "klog.h"
+#include "trace.h"
+#include "profile.h"
+#include "monitor.h"
+#include "kstat.h"
+#include "irqstat.h"
+#include "ktime.h"
+#include "clockevent.h"
+#include "timer.h"
+#include "delay.h"
+#include "softirq.h"
+#include "acpi.h"
 #include "../drivers/pic/pic.h"
 #include "../drivers/pit/pit.h"
+#include "../drivers/hpet/hpet.h"
+#include "../drivers/apic/apic.h"
 #include "../drivers/keyboard/keyboard.h"
 #include "../drivers/mouse/mouse.h"
 #include "../drivers/serial/serial.h"
 #include "../drivers/rtc/rtc.h"
 #include "../../impl/drivers/video/vga.h"
 #include "../../impl/drivers/video/window.h"
+#include "../../impl/drivers/video/console.h"
 
 /* Global system information */
 static struct SystemInfo* system_info;
@@ -44,15 +62,10 @@ static int test_mode = 0;
 /* External test runner */
 extern void run_tests(void);
 
-/* Debug print function */
+/* Debug print function; the log drains send it to serial and the debug console */
 static void debug_print(const char* msg) {
     if (debug_mode) {
-        print_set_color(PRINT_COLOR_CYAN, PRINT_COLOR_BLACK);
-        print_str("[DEBUG] ");
-        print_str(msg);
-        print_set_color(PRINT_COLOR_WHITE, PRINT_COLOR_BLACK);
-        serial_write_string(COM1_PORT, "[DEBUG] ");
-        serial_write_string(COM1_PORT, msg);
+        klog_write(KLOG_DEBUG, msg, strlen(msg));
     }
 }
 
@@ -100,7 +113,8 @@ static void run_setup_wizard(void) {
         case SETUP_WELCOME:
             print_str("Welcome to NansOS!\n");
             print_str("This wizard will help you configure your system.\n");
-            print_str("Press ENTER to continue...\n");
+            print_str("Press ENTER to continue...\n\n");
+            print_str("Boot log: Alt+F2   Debug output: Alt+F3   Back: Alt+F1\n");
             break;
 
         case SETUP_LANGUAGE:
@@ -243,20 +257,17 @@ void keyboard_scancode(uint8_t scancode) {
     serial_write_string(COM1_PORT, str);
 }
 
-/* Modified keyboard character callback */
-void keyboard_char(char c) {
+/* Character input, in the main loop */
+static void handle_char(char c) {
     if (!setup_complete) {
         handle_setup_input(c);
         if (setup_complete) {
             /* Transition to graphical mode */
             print_str("\nInitializing graphical interface...\n");
             
-            /* Initialize window system first */
+            /* Initialize window system first; it is ready when this returns */
             window_init();
             
-            /* Small delay to ensure initialization is complete */
-            for (volatile int i = 0; i < 1000000; i++) {}
-            
             /* Now initialize GUI */
             window_init_gui();
             
@@ -269,8 +280,8 @@ void keyboard_char(char c) {
     }
 }
 
-/* Special key callback */
-void special_key(struct SpecialKeyEvent* event) {
+/* Special key input, in the main loop */
+static void handle_special(struct SpecialKeyEvent* event) {
     char str[64];
     const char* key_name = "Unknown";
     
@@ -308,6 +319,20 @@ void special_key(struct SpecialKeyEvent* event) {
         } else if (event->key_code == KEY_F2) {
             sysinfo_detect_memory(&system_info->memory);
             print_str("\nMemory information updated.\n");
+        } else if (event->key_code == KEY_F9) {
+            /* Toggle the sampling profiler; stopping dumps folded stacks to COM1 */
+            if (profile_running()) {
+                profile_stop();
+                profile_request_dump();
+            } else {
+                profile_start(PROFILE_DEFAULT_HZ);
+            }
+        } else if (event->key_code == KEY_F10) {
+            /* Statistics changed since the last dump, on COM1 and the debug console */
+            kstat_request_dump();
+        } else if (event->key_code == KEY_F11) {
+            /* Per-vector handler times and the longest interrupts-off span */
+            irqstat_request_dump();
         } else if (event->key_code == KEY_F3) {
             print_str("\nCPU Features:\n");
             if (system_info->cpu.features & CPU_FEATURE_FPU) print_str("FPU ");
@@ -334,6 +359,71 @@ void special_key(struct SpecialKeyEvent* event) {
     serial_write_string(COM1_PORT, str);
 }
 
+/*
+ * The keyboard callbacks run in softirq context. Key handling prints,
+ * drives the setup wizard and can bring up the whole GUI, so events are
+ * queued for a work item that runs them in the main loop. Keys beyond a
+ * full queue are dropped.
+ */
+#define INPUT_QUEUE_SIZE 64
+
+struct InputEvent {
+    uint8_t special;
+    char c;
+    struct SpecialKeyEvent key;
+};
+
+static struct InputEvent input_queue[INPUT_QUEUE_SIZE];
+static uint32_t input_head = 0;
+static uint32_t input_tail = 0;
+
+static void input_work_fn(void* data);
+static struct Work input_work = WORK_INIT(input_work, input_work_fn, NULL);
+
+static void input_queue_push(const struct InputEvent* event) {
+    uint64_t flags = asm_irq_save();
+    if (input_head - input_tail < INPUT_QUEUE_SIZE) {
+        input_queue[input_head & (INPUT_QUEUE_SIZE - 1)] = *event;
+        input_head++;
+    }
+    asm_irq_restore(flags);
+    schedule_work(&input_work);
+}
+
+static void input_work_fn(void* data) {
+    (void)data;
+
+    for (;;) {
+        struct InputEvent event;
+        uint64_t flags = asm_irq_save();
+        if (input_tail == input_head) {
+            asm_irq_restore(flags);
+            break;
+        }
+        event = input_queue[input_tail & (INPUT_QUEUE_SIZE - 1)];
+        input_tail++;
+        asm_irq_restore(flags);
+
+        if (event.special) {
+            handle_special(&event.key);
+        } else {
+            handle_char(event.c);
+        }
+    }
+}
+
+/* Keyboard character callback */
+void keyboard_char(char c) {
+    struct InputEvent event = { .special = 0, .c = c };
+    input_queue_push(&event);
+}
+
+/* Special key callback */
+void special_key(struct SpecialKeyEvent* event) {
+    struct InputEvent queued = { .special = 1, .key = *event };
+    input_queue_push(&queued);
+}
+
 /* Mouse event handler */
 void mouse_event(struct MouseState* state) {
     char debug_msg[64];
@@ -344,16 +434,17 @@ void mouse_event(struct MouseState* state) {
     /* TODO: Update cursor position in GUI when implemented */
 }
 
-/* Timer callback function */
-void timer_tick(void) {
-    static uint32_t ticks = 0;
-    ticks++;
-    
-    if (ticks % 100 == 0) {  /* Every second (assuming 100Hz PIT) */
-        char str[64];
-        sprintf(str, "Uptime: %d seconds\n", ticks / 100);
-        serial_write_string(COM1_PORT, str);
-    }
+/* Once-a-second uptime report, re-armed from its own callback */
+static struct Timer uptime_timer;
+
+static void uptime_tick(void* data) {
+    (void)data;
+    char str[64];
+    uint64_t second = tick_get_ticks() / tick_get_hz();
+
+    sprintf(str, "Uptime: %d seconds\n", (int)second);
+    serial_write_string(COM1_PORT, str);
+    timer_mod(&uptime_timer, (second + 1) * tick_get_hz());
 }
 
 /* Print boot header with system information */
@@ -381,6 +472,22 @@ static int init_system(void) {
     sysinfo_init();
     debug_print("System information initialized\n");
 
+    /* Patch CPU-specific code paths */
+    alternatives_apply();
+
+    /* Measure interrupts-off spans from here on, including driver init */
+    if (debug_mode) {
+        irqoff_trace_enable(1);
+    }
+
+    /* Enable FPU/SIMD state for kernel sections */
+    debug_print("Initializing FPU...\n");
+    fpu_init();
+    debug_print("FPU initialized\n");
+
+    /* Select checksum implementation */
+    crc32c_init();
+
     /* Initialize IDT */
     debug_print("Initializing IDT...\n");
     idt_init();
@@ -391,12 +498,26 @@ static int init_system(void) {
     pic_init();
     debug_print("PIC initialized\n");
 
+    /* The APIC takes over from the PIC when the firmware describes one */
+    int have_acpi = acpi_init() == 0;
+    if (have_acpi) {
+        debug_print("Initializing APIC...\n");
+        apic_init();
+    }
+
     /* Initialize PIT */
     debug_print("Initializing PIT...\n");
     pit_init(PIT_DEFAULT_HZ);
-    pit_set_callback(timer_tick);
+    timer_init(&uptime_timer, uptime_tick, NULL);
+    timer_set_slack(&uptime_timer, 0);
+    timer_mod(&uptime_timer, tick_get_hz());
     debug_print("PIT initialized\n");
 
+    /* Prefer the HPET for the tick and as a time reference; the PIT stays as fallback */
+    if (have_acpi && hpet_init() == 0) {
+        ktime_use_hpet();
+    }
+
     /* Initialize serial port */
     debug_print("Initializing serial port...\n");
     serial_init(COM1_PORT, SERIAL_BAUD_115200);
@@ -405,7 +526,6 @@ static int init_system(void) {
     /* Initialize RTC */
     debug_print("Initializing RTC...\n");
     rtc_init();
-    rtc_enable_interrupt();
     debug_print("RTC initialized\n");
 
     /* Initialize keyboard */
@@ -427,6 +547,15 @@ static int init_system(void) {
     idt_enable_interrupts();
     debug_print("Interrupts enabled\n");
 
+    /* Serial output queues from here; the UART interrupt drains it */
+    serial_enable_interrupts(COM1_PORT);
+    debug_print("Serial port interrupt-driven\n");
+
+    /* Binary event frames on COM1; decode with tools/trace_decode.py */
+    if (debug_mode) {
+        trace_enable();
+    }
+
     debug_print("System initialization complete!\n");
     serial_write_string(COM1_PORT, "NansOS initialized and ready!\n");
 
@@ -435,6 +564,10 @@ static int init_system(void) {
 
 /* Handle system errors */
 static void handle_system_error(const char* error_msg) {
+    /* Polled serial output from here, then get buffered log records out */
+    serial_force_sync();
+    klog_flush();
+
     print_set_color(PRINT_COLOR_RED, PRINT_COLOR_BLACK);
     print_str("\nFATAL ERROR: ");
     print_str(error_msg);
@@ -457,32 +590,47 @@ void kernel_main(void) {
     /* Initialize serial port first for debugging */
     serial_init(COM1_PORT, SERIAL_BAUD_115200);
     serial_write_string(COM1_PORT, "Serial port initialized\n");
+    klog_init();
+
+    /* Calibrate the TSC so every later timestamp has nanosecond resolution */
+    ktime_init();
+    delay_init();
     
     /* Clear screen and print header */
     print_clear();
     print_boot_header();
     serial_write_string(COM1_PORT, "Kernel started\n");
     
-    /* Initialize system components */
+    /* Subsystem messages during init go to the boot log console */
+    console_set_output(CONSOLE_BOOT_LOG);
+    print_boot_header();
     if (init_system() != 0) {
+        console_set_output(CONSOLE_MAIN);
         handle_system_error("System initialization failed");
         return;
     }
+    console_set_output(CONSOLE_MAIN);
+
+    /* From here on log records are written out from the idle loop */
+    klog_start_async();
 
     /* Main kernel loop */
     serial_write_string(COM1_PORT, "Entering main kernel loop\n");
     run_setup_wizard();  // Start the setup wizard
 
+    uint64_t clock_second = UINT64_MAX;
+
     while (1) {
+        uint64_t wake_ns = 0;
+
         if (setup_complete) {
             /* Process any pending tasks */
-            if (pit_get_ticks() % PIT_DEFAULT_HZ == 0) {
-                /* Update clock in taskbar */
+            if (ktime_get_real_seconds() != clock_second) {
+                /* Update clock in taskbar (UTC) */
                 char time_str[32];
-                uint32_t seconds = pit_get_ticks() / PIT_DEFAULT_HZ;
-                uint32_t minutes = seconds / 60;
-                uint32_t hours = minutes / 60;
-                sprintf(time_str, "%02d:%02d:%02d", hours % 24, minutes % 60, seconds % 60);
+                clock_second = ktime_get_real_seconds();
+                uint32_t seconds = (uint32_t)(clock_second % 86400);
+                sprintf(time_str, "%02d:%02d:%02d", seconds / 3600, seconds / 60 % 60, seconds % 60);
                 
                 /* Update window system */
                 window_update();
@@ -494,6 +642,9 @@ void kernel_main(void) {
                     vga_swap_buffers();
                 }
             }
+
+            /* Wake for the next taskbar clock update */
+            wake_ns = ktime_get_ns() + NSEC_PER_SEC - ktime_get_real() % NSEC_PER_SEC;
         }
         
         /* Process mouse events if in graphical mode */
@@ -502,7 +653,18 @@ void kernel_main(void) {
             vga_update_cursor(mouse_state.x_pos, mouse_state.y_pos);
         }
         
-        /* Halt CPU until next interrupt */
-        asm_hlt();
+        /* Bottom halves left over from interrupts, then deferred work */
+        softirq_run();
+        workqueue_run();
+
+        /* Write out log records queued by interrupt handlers */
+        klog_drain();
+        profile_poll();
+        kstat_poll();
+        irqstat_poll();
+        monitor_poll();
+
+        /* Halt until the next interrupt; the periodic tick stops while idle */
+        tick_idle(wake_ns);
     }
 }
@@ -112,6 +112,23 @@ int mmu_is_mapped(uint64_t virt_addr) {
     return (pt[pt_idx] & PAGE_PRESENT) != 0;
 }
 
+/* Map physical device memory at the same virtual address */
+void* mmu_map_mmio(uint64_t phys_addr, uint64_t size) {
+    uint64_t start = phys_addr & ~(uint64_t)(PAGE_SIZE - 1);
+    uint64_t end = (phys_addr + size + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1);
+
+    if (size == 0) {
+        return NULL;
+    }
+    for (uint64_t page = start; page < end; page += PAGE_SIZE) {
+        if (!mmu_is_mapped(page)) {
+            mmu_map_page(page, page, PAGE_PRESENT | PAGE_WRITABLE | PAGE_WRITETHROUGH | PAGE_NOCACHE);
+            asm_invlpg(page);
+        }
+    }
+    return (void*)phys_addr;
+}
+
 /* Unmap a virtual page */
 void mmu_unmap_page(uint64_t virt_addr) {
     uint64_t pml4_idx = (virt_addr >> 39) & 0x1FF;
@@ -55,6 +55,13 @@ void mmu_free_page(void* page);
 void mmu_map_page(uint64_t phys_addr, uint64_t virt_addr, uint64_t flags);
 void mmu_unmap_page(uint64_t virt_addr);
 int mmu_is_mapped(uint64_t virt_addr);
+
+/*
+ * Identity-map device registers or firmware tables with caching disabled
+ * and return a pointer to `phys_addr`. Ranges already covered, such as the
+ * boot loader's huge pages, are left alone.
+ */
+void* mmu_map_mmio(uint64_t phys_addr, uint64_t size);
 void mmu_load_cr3(uint64_t pml4_addr);
 void mmu_enable_paging(void);
 void mmu_set_kernel_stack(uint64_t stack);
@@ -0,0 +1,169 @@
+/**
+ * Serial Debug Monitor Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "monitor.h"
+#include "tracepoint.h"
+#include "kstat.h"
+#include "clockevent.h"
+#include "irqstat.h"
+#include <stdlib.h>
+#include <string.h>
+#include "../drivers/serial/serial.h"
+
+#define MONITOR_PROMPT  "nans> "
+
+static char line[MONITOR_LINE_MAX + 1];
+static int line_len = 0;
+static int last_cr = 0;
+
+static void cmd_help(int argc, char** argv);
+static void cmd_tp(int argc, char** argv);
+static void cmd_kstat(int argc, char** argv);
+static void cmd_tick(int argc, char** argv);
+static void cmd_irq(int argc, char** argv);
+
+static const struct MonitorCommand commands[] = {
+    { "help", "List commands", cmd_help },
+    { "tp",   "tp [list] | tp on|off <name|all> | tp dump | tp clear", cmd_tp },
+    { "kstat", "kstat [delta] - statistics, or changes since the last delta", cmd_kstat },
+    { "tick", "tick [nohz on|off] [sleep <ms>] - tick and tickless idle state", cmd_tick },
+    { "irq",  "irq [reset] | irq trace on|off - handler times per vector, irqs-off spans", cmd_irq },
+};
+
+#define NUM_COMMANDS (sizeof(commands) / sizeof(commands[0]))
+
+static void cmd_help(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    for (size_t i = 0; i < NUM_COMMANDS; i++) {
+        serial_printf(COM1_PORT, "  %-6s %s\n", commands[i].name, commands[i].help);
+    }
+}
+
+static void tp_list(void) {
+    struct TracepointStats stats;
+    tracepoint_get_stats(&stats);
+
+    for (size_t i = 0; i < tracepoint_count(); i++) {
+        const struct Tracepoint* tp = tracepoint_get(i);
+        serial_wait_room(COM1_PORT, 96);
+        serial_printf(COM1_PORT, "  %-3s %-20s %llu hits\n",
+                      static_key_enabled(&tp->key) ? "on" : "off", tp->name,
+                      (unsigned long long)tp->hits);
+    }
+    serial_printf(COM1_PORT, "%u tracepoints, %llu recorded, %llu overwritten\n",
+                  (unsigned)tracepoint_count(), (unsigned long long)stats.recorded,
+                  (unsigned long long)stats.overwritten);
+}
+
+static void cmd_tp(int argc, char** argv) {
+    if (argc < 2 || strcmp(argv[1], "list") == 0) {
+        tp_list();
+    } else if ((strcmp(argv[1], "on") == 0 || strcmp(argv[1], "off") == 0) && argc == 3) {
+        int enable = strcmp(argv[1], "on") == 0;
+        if (tracepoint_set(argv[2], enable) < 0) {
+            serial_printf(COM1_PORT, "tp: no tracepoint '%s'\n", argv[2]);
+        }
+    } else if (strcmp(argv[1], "dump") == 0) {
+        tracepoint_dump();
+    } else if (strcmp(argv[1], "clear") == 0) {
+        tracepoint_clear();
+    } else {
+        serial_printf(COM1_PORT, "usage: %s\n", commands[1].help);
+    }
+}
+
+static void cmd_kstat(int argc, char** argv) {
+    kstat_dump(argc > 1 && strcmp(argv[1], "delta") == 0);
+}
+
+static void cmd_tick(int argc, char** argv) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "nohz") == 0) {
+            tick_set_nohz(strcmp(argv[i + 1], "on") == 0);
+        } else if (strcmp(argv[i], "sleep") == 0) {
+            tick_set_max_sleep_ms((uint32_t)atoi(argv[i + 1]));
+        }
+    }
+
+    struct TickStats stats;
+    tick_get_stats(&stats);
+    serial_printf(COM1_PORT, "%llu ticks at %u Hz, %llu timer interrupts, %llu idle sleeps, %llu wakeups avoided\n",
+                  (unsigned long long)stats.ticks, tick_get_hz(), (unsigned long long)stats.events,
+                  (unsigned long long)stats.idle_sleeps, (unsigned long long)stats.wakeups_avoided);
+}
+
+static void cmd_irq(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "reset") == 0) {
+        irqstat_reset();
+        serial_printf(COM1_PORT, "Interrupt statistics cleared\n");
+    } else if (argc > 2 && strcmp(argv[1], "trace") == 0) {
+        irqoff_trace_enable(strcmp(argv[2], "on") == 0);
+        serial_printf(COM1_PORT, "irqs-off tracing %s\n", irqoff_trace_enabled() ? "on" : "off");
+    } else {
+        irqstat_dump();
+    }
+}
+
+/* Splits `text` in place on spaces */
+static int monitor_split(char* text, char** argv) {
+    int argc = 0;
+    while (*text && argc < MONITOR_MAX_ARGS) {
+        while (*text == ' ') {
+            *text++ = '\0';
+        }
+        if (!*text) {
+            break;
+        }
+        argv[argc++] = text;
+        while (*text && *text != ' ') {
+            text++;
+        }
+    }
+    return argc;
+}
+
+void monitor_execute(char* text) {
+    char* argv[MONITOR_MAX_ARGS];
+    int argc = monitor_split(text, argv);
+    if (argc == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < NUM_COMMANDS; i++) {
+        if (strcmp(commands[i].name, argv[0]) == 0) {
+            commands[i].run(argc, argv);
+            return;
+        }
+    }
+    serial_printf(COM1_PORT, "%s: unknown command (try 'help')\n", argv[0]);
+}
+
+void monitor_poll(void) {
+    int c;
+    while ((c = serial_try_read(COM1_PORT)) >= 0) {
+        /* Terminals send CR, LF or CRLF; treat each as one Enter */
+        int was_cr = last_cr;
+        last_cr = c == '\r';
+        if (c == '\n' && was_cr) {
+            continue;
+        }
+
+        if (c == '\r' || c == '\n') {
+            serial_write_string(COM1_PORT, "\n");
+            line[line_len] = '\0';
+            line_len = 0;
+            monitor_execute(line);
+            serial_write_string(COM1_PORT, MONITOR_PROMPT);
+        } else if ((c == '\b' || c == 0x7F) && line_len > 0) {
+            line_len--;
+            serial_write_string(COM1_PORT, "\b \b");
+        } else if (c >= ' ' && c < 0x7F && line_len < MONITOR_LINE_MAX) {
+            line[line_len++] = (char)c;
+            serial_write(COM1_PORT, (char)c);
+        }
+    }
+}
@@ -0,0 +1,27 @@
+/**
+ * Serial Debug Monitor
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+
+#define MONITOR_LINE_MAX    80
+#define MONITOR_MAX_ARGS    8
+
+/*
+ * Line-based command console on COM1. Type `help` in the serial terminal
+ * for the command list; commands print their output back to COM1.
+ */
+struct MonitorCommand {
+    const char* name;
+    const char* help;
+    void (*run)(int argc, char** argv);
+};
+
+/* Read pending COM1 input and run complete lines; called from the idle loop */
+void monitor_poll(void);
+
+/* Run one command line as if it had been typed */
+void monitor_execute(char* line);
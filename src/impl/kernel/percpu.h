@@ -0,0 +1,23 @@
+/**
+ * Per-CPU Data
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+
+/*
+ * The kernel runs on the boot CPU only. Per-CPU state is still laid out
+ * as arrays indexed by cpu_id() so that bringing up more CPUs only has to
+ * change these definitions, not every user.
+ */
+#define MAX_CPUS            1
+
+static inline int cpu_id(void) {
+    return 0;
+}
+
+#define DEFINE_PER_CPU(type, name)  type name[MAX_CPUS]
+#define this_cpu(name)              (name[cpu_id()])
+#define per_cpu(name, cpu)          (name[(cpu)])
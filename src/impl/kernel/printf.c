@@ -0,0 +1,360 @@
+/**
+ * Formatted Output Engine
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+/* Conversion flags */
+#define FMT_LEFT        0x01    /* '-' left-justify */
+#define FMT_ZERO        0x02    /* '0' zero padding */
+#define FMT_PLUS        0x04    /* '+' always print sign */
+#define FMT_SPACE       0x08    /* ' ' space for positive sign */
+#define FMT_ALT         0x10    /* '#' alternate form */
+
+/* Enough for a 64-bit value in octal */
+#define FMT_NUM_BUFFER  24
+#define FMT_PAD_CHUNK   16
+
+static const char digit_pairs[200] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const char hex_lower[] = "0123456789abcdef";
+static const char hex_upper[] = "0123456789ABCDEF";
+
+static const char pad_spaces[FMT_PAD_CHUNK] = "                ";
+static const char pad_zeros[FMT_PAD_CHUNK] = "0000000000000000";
+
+struct FormatState {
+    format_sink_t sink;
+    void* ctx;
+    size_t count;
+};
+
+static inline void emit(struct FormatState* st, const char* data, size_t len) {
+    if (len) {
+        st->sink(st->ctx, data, len);
+        st->count += len;
+    }
+}
+
+static void emit_pad(struct FormatState* st, const char* chunk, int count) {
+    while (count > 0) {
+        int n = count < FMT_PAD_CHUNK ? count : FMT_PAD_CHUNK;
+        emit(st, chunk, (size_t)n);
+        count -= n;
+    }
+}
+
+/* Writes digits backwards ending at `end`; returns the first digit */
+static char* format_decimal(char* end, uint64_t value) {
+    while (value >= 100) {
+        const char* pair = &digit_pairs[(value % 100) * 2];
+        value /= 100;
+        *--end = pair[1];
+        *--end = pair[0];
+    }
+    if (value >= 10) {
+        const char* pair = &digit_pairs[value * 2];
+        *--end = pair[1];
+        *--end = pair[0];
+    } else {
+        *--end = (char)('0' + value);
+    }
+    return end;
+}
+
+static char* format_hex(char* end, uint64_t value, const char* digits) {
+    do {
+        *--end = digits[value & 0xF];
+        value >>= 4;
+    } while (value);
+    return end;
+}
+
+static char* format_octal(char* end, uint64_t value) {
+    do {
+        *--end = (char)('0' + (value & 7));
+        value >>= 3;
+    } while (value);
+    return end;
+}
+
+/* Emits a converted number with sign/prefix, precision and width applied */
+static void emit_number(struct FormatState* st, const char* digits, int len,
+                        const char* prefix, int prefix_len,
+                        int flags, int width, int precision) {
+    int zeros = precision > len ? precision - len : 0;
+    int total = prefix_len + zeros + len;
+    int padding = width > total ? width - total : 0;
+
+    if (flags & FMT_LEFT) {
+        emit(st, prefix, (size_t)prefix_len);
+        emit_pad(st, pad_zeros, zeros);
+        emit(st, digits, (size_t)len);
+        emit_pad(st, pad_spaces, padding);
+    } else if ((flags & FMT_ZERO) && precision < 0) {
+        emit(st, prefix, (size_t)prefix_len);
+        emit_pad(st, pad_zeros, padding);
+        emit(st, digits, (size_t)len);
+    } else {
+        emit_pad(st, pad_spaces, padding);
+        emit(st, prefix, (size_t)prefix_len);
+        emit_pad(st, pad_zeros, zeros);
+        emit(st, digits, (size_t)len);
+    }
+}
+
+static void emit_string(struct FormatState* st, const char* s, int flags,
+                        int width, int precision) {
+    if (!s) {
+        s = "(null)";
+    }
+    size_t len = precision >= 0 ? strnlen(s, (size_t)precision) : strlen(s);
+    int padding = width > (int)len ? width - (int)len : 0;
+
+    if (!(flags & FMT_LEFT)) {
+        emit_pad(st, pad_spaces, padding);
+    }
+    emit(st, s, len);
+    if (flags & FMT_LEFT) {
+        emit_pad(st, pad_spaces, padding);
+    }
+}
+
+/* Parses a decimal field width or precision */
+static int parse_int(const char** format) {
+    int value = 0;
+    while (**format >= '0' && **format <= '9') {
+        value = value * 10 + (*(*format)++ - '0');
+    }
+    return value;
+}
+
+int format_vprint(format_sink_t sink, void* ctx, const char* format, va_list args) {
+    struct FormatState st = { sink, ctx, 0 };
+    char num[FMT_NUM_BUFFER];
+    char* num_end = num + FMT_NUM_BUFFER;
+
+    while (*format) {
+        /* Literal runs go to the sink in one call */
+        const char* run = format;
+        while (*format && *format != '%') {
+            format++;
+        }
+        emit(&st, run, (size_t)(format - run));
+        if (!*format) {
+            break;
+        }
+
+        const char* spec = format++;
+        int flags = 0;
+        int width = 0;
+        int precision = -1;
+        int length = 0;     /* -2 hh, -1 h, 0 int, 1 long, 2 long long */
+
+        for (;;) {
+            char f = *format;
+            if (f == '-') flags |= FMT_LEFT;
+            else if (f == '0') flags |= FMT_ZERO;
+            else if (f == '+') flags |= FMT_PLUS;
+            else if (f == ' ') flags |= FMT_SPACE;
+            else if (f == '#') flags |= FMT_ALT;
+            else break;
+            format++;
+        }
+
+        if (*format == '*') {
+            format++;
+            width = va_arg(args, int);
+            if (width < 0) {
+                flags |= FMT_LEFT;
+                width = -width;
+            }
+        } else {
+            width = parse_int(&format);
+        }
+
+        if (*format == '.') {
+            format++;
+            if (*format == '*') {
+                format++;
+                precision = va_arg(args, int);
+            } else {
+                precision = parse_int(&format);
+            }
+        }
+
+        switch (*format) {
+            case 'h':
+                length = -1;
+                if (*++format == 'h') {
+                    length = -2;
+                    format++;
+                }
+                break;
+            case 'l':
+                length = 1;
+                if (*++format == 'l') {
+                    length = 2;
+                    format++;
+                }
+                break;
+            case 'z':
+            case 'j':
+            case 't':
+                length = 2;
+                format++;
+                break;
+        }
+
+        char conv = *format;
+        if (conv) {
+            format++;
+        }
+
+        uint64_t value = 0;
+        char* digits;
+        char prefix[2];
+        int prefix_len = 0;
+
+        switch (conv) {
+            case 'd':
+            case 'i': {
+                int64_t v;
+                if (length >= 1) v = (length == 2) ? va_arg(args, long long) : va_arg(args, long);
+                else v = va_arg(args, int);
+                if (length == -1) v = (short)v;
+                else if (length == -2) v = (signed char)v;
+
+                value = v < 0 ? -(uint64_t)v : (uint64_t)v;
+                if (v < 0) prefix[prefix_len++] = '-';
+                else if (flags & FMT_PLUS) prefix[prefix_len++] = '+';
+                else if (flags & FMT_SPACE) prefix[prefix_len++] = ' ';
+
+                digits = (precision == 0 && value == 0) ? num_end : format_decimal(num_end, value);
+                emit_number(&st, digits, (int)(num_end - digits), prefix, prefix_len,
+                            flags, width, precision);
+                break;
+            }
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+                if (length >= 1) value = (length == 2) ? va_arg(args, unsigned long long) : va_arg(args, unsigned long);
+                else value = va_arg(args, unsigned int);
+                if (length == -1) value = (unsigned short)value;
+                else if (length == -2) value = (unsigned char)value;
+
+                if (precision == 0 && value == 0) {
+                    digits = num_end;
+                } else if (conv == 'u') {
+                    digits = format_decimal(num_end, value);
+                } else if (conv == 'o') {
+                    digits = format_octal(num_end, value);
+                } else {
+                    digits = format_hex(num_end, value, conv == 'X' ? hex_upper : hex_lower);
+                }
+
+                if ((flags & FMT_ALT) && conv == 'o' && (digits == num_end || *digits != '0')) {
+                    *--digits = '0';
+                } else if ((flags & FMT_ALT) && conv != 'u' && conv != 'o' && value) {
+                    prefix[prefix_len++] = '0';
+                    prefix[prefix_len++] = conv;
+                }
+                emit_number(&st, digits, (int)(num_end - digits), prefix, prefix_len,
+                            flags, width, precision);
+                break;
+            case 'p':
+                value = (uint64_t)(uintptr_t)va_arg(args, void*);
+                digits = format_hex(num_end, value, hex_lower);
+                prefix[prefix_len++] = '0';
+                prefix[prefix_len++] = 'x';
+                emit_number(&st, digits, (int)(num_end - digits), prefix, prefix_len,
+                            flags, width, precision);
+                break;
+            case 'c':
+                num[0] = (char)va_arg(args, int);
+                if (!(flags & FMT_LEFT)) emit_pad(&st, pad_spaces, width - 1);
+                emit(&st, num, 1);
+                if (flags & FMT_LEFT) emit_pad(&st, pad_spaces, width - 1);
+                break;
+            case 's':
+                emit_string(&st, va_arg(args, const char*), flags, width, precision);
+                break;
+            case '%':
+                emit(&st, "%", 1);
+                break;
+            default:
+                /* Unknown conversion: echo the specifier verbatim */
+                emit(&st, spec, (size_t)(format - spec));
+                break;
+        }
+    }
+
+    return (int)st.count;
+}
+
+int format_print(format_sink_t sink, void* ctx, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int ret = format_vprint(sink, ctx, format, args);
+    va_end(args);
+    return ret;
+}
+
+/* Bounded memory sink used by the sprintf family */
+struct FormatBuffer {
+    char* data;
+    size_t size;    /* Capacity excluding the terminator */
+    size_t pos;
+};
+
+static void buffer_sink(void* ctx, const char* data, size_t len) {
+    struct FormatBuffer* buf = (struct FormatBuffer*)ctx;
+    if (buf->pos < buf->size) {
+        size_t room = buf->size - buf->pos;
+        memcpy(buf->data + buf->pos, data, len < room ? len : room);
+    }
+    buf->pos += len;
+}
+
+int vsnprintf(char* str, size_t size, const char* format, va_list args) {
+    struct FormatBuffer buf = { str, size ? size - 1 : 0, 0 };
+    int ret = format_vprint(buffer_sink, &buf, format, args);
+    if (size) {
+        str[buf.pos < buf.size ? buf.pos : buf.size] = '\0';
+    }
+    return ret;
+}
+
+int vsprintf(char* str, const char* format, va_list args) {
+    return vsnprintf(str, (size_t)-1, format, args);
+}
+
+int snprintf(char* str, size_t size, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int ret = vsnprintf(str, size, format, args);
+    va_end(args);
+    return ret;
+}
+
+int sprintf(char* str, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int ret = vsprintf(str, format, args);
+    va_end(args);
+    return ret;
+}
@@ -0,0 +1,211 @@
+/**
+ * Sampling Profiler Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "profile.h"
+#include "percpu.h"
+#include "asm_utils.h"
+#include "klog.h"
+#include "clockevent.h"
+#include <string.h>
+#include "../drivers/pit/pit.h"
+#include "../drivers/serial/serial.h"
+
+/* Kernel code and stacks live in the identity-mapped low 2GB, above 1MB */
+#define PROFILE_ADDR_MIN    0x100000ull
+#define PROFILE_ADDR_MAX    0x80000000ull
+
+/* Largest plausible single stack frame */
+#define PROFILE_FRAME_MAX   0x10000ull
+
+/*
+ * Samples are aggregated as they arrive: each distinct stack gets one
+ * entry with a hit count, so memory does not grow with run time and the
+ * dump is already in folded form.
+ */
+struct ProfileCPU {
+    struct HashTable table;
+    struct HashSlot slots[PROFILE_MAX_STACKS * 2];
+    struct ProfileStack stacks[PROFILE_MAX_STACKS];
+    uint32_t used;
+    uint64_t samples;
+    uint64_t dropped;
+};
+
+static DEFINE_PER_CPU(struct ProfileCPU, profile_cpu);
+
+static int running = 0;
+static uint32_t sample_hz = 0;
+static int dump_requested = 0;
+
+struct ProfileKey {
+    uint32_t depth;
+    const uint64_t* pcs;
+};
+
+static int stack_match(const struct HashNode* node, const void* key) {
+    const struct ProfileStack* stack = hash_entry(node, struct ProfileStack, node);
+    const struct ProfileKey* k = key;
+    return stack->depth == k->depth && memcmp(stack->pcs, k->pcs, k->depth * sizeof(uint64_t)) == 0;
+}
+
+static uint32_t stack_hash(const uint64_t* pcs, uint32_t depth) {
+    uint64_t h = 0x9E3779B97F4A7C15ull;
+    for (uint32_t i = 0; i < depth; i++) {
+        h = (h ^ pcs[i]) * 0xFF51AFD7ED558CCDull;
+        h ^= h >> 32;
+    }
+    return (uint32_t)h;
+}
+
+static void profile_reset(struct ProfileCPU* cpu) {
+    hash_init(&cpu->table, cpu->slots, PROFILE_MAX_STACKS * 2, stack_match);
+    cpu->used = 0;
+    cpu->samples = 0;
+    cpu->dropped = 0;
+}
+
+void profile_start(uint32_t hz) {
+    uint32_t tick_hz = tick_get_hz() ? tick_get_hz() : PIT_DEFAULT_HZ;
+    uint32_t factor = hz / tick_hz;
+    if (factor == 0) {
+        factor = 1;
+    }
+
+    uint64_t flags = asm_irq_save();
+    for (int i = 0; i < MAX_CPUS; i++) {
+        profile_reset(&per_cpu(profile_cpu, i));
+    }
+    sample_hz = factor * tick_hz;
+    if (!running) {
+        /* Samples come from the periodic interrupt; keep it through idle */
+        tick_force_periodic(1);
+    }
+    running = 1;
+    tick_set_oversample(factor);
+    asm_irq_restore(flags);
+
+    klog_info("[PROF] Sampling at %u Hz", sample_hz);
+}
+
+void profile_stop(void) {
+    uint64_t flags = asm_irq_save();
+    if (running) {
+        tick_force_periodic(0);
+    }
+    running = 0;
+    tick_set_oversample(1);
+    asm_irq_restore(flags);
+}
+
+int profile_running(void) {
+    return running;
+}
+
+/* Interrupts are off: this runs inside the timer interrupt */
+void profile_sample(uint64_t rip, uint64_t rbp) {
+    if (!running) {
+        return;
+    }
+
+    struct ProfileCPU* cpu = &this_cpu(profile_cpu);
+    uint64_t pcs[PROFILE_MAX_DEPTH];
+    uint32_t depth = 0;
+
+    pcs[depth++] = rip;
+
+    /* Follow saved frame pointers while they look like a sane stack */
+    while (depth < PROFILE_MAX_DEPTH && rbp >= PROFILE_ADDR_MIN &&
+           rbp < PROFILE_ADDR_MAX && !(rbp & 7)) {
+        const uint64_t* frame = (const uint64_t*)rbp;
+        uint64_t next = frame[0];
+        uint64_t ret = frame[1];
+
+        if (ret < PROFILE_ADDR_MIN || ret >= PROFILE_ADDR_MAX) {
+            break;
+        }
+        pcs[depth++] = ret;
+        if (next <= rbp || next - rbp > PROFILE_FRAME_MAX) {
+            break;
+        }
+        rbp = next;
+    }
+
+    cpu->samples++;
+
+    struct ProfileKey key = { depth, pcs };
+    uint32_t hash = stack_hash(pcs, depth);
+    struct HashNode* node = hash_find(&cpu->table, hash, &key);
+    if (node) {
+        hash_entry(node, struct ProfileStack, node)->count++;
+        return;
+    }
+
+    if (cpu->used == PROFILE_MAX_STACKS) {
+        cpu->dropped++;
+        return;
+    }
+    struct ProfileStack* stack = &cpu->stacks[cpu->used];
+    stack->count = 1;
+    stack->depth = depth;
+    memcpy(stack->pcs, pcs, depth * sizeof(uint64_t));
+    if (hash_insert(&cpu->table, &stack->node, hash) != 0) {
+        cpu->dropped++;
+        return;
+    }
+    cpu->used++;
+}
+
+/* Sampling may continue meanwhile; entries are only ever appended */
+void profile_dump(void) {
+    serial_wait_room(COM1_PORT, 128);
+    serial_printf(COM1_PORT, "=== profile begin hz=%u ===\n", sample_hz);
+
+    for (int i = 0; i < MAX_CPUS; i++) {
+        struct ProfileCPU* cpu = &per_cpu(profile_cpu, i);
+
+        serial_wait_room(COM1_PORT, 128);
+        serial_printf(COM1_PORT, "# cpu %d: %llu samples, %u stacks, %llu dropped\n", i,
+                      (unsigned long long)cpu->samples, cpu->used,
+                      (unsigned long long)cpu->dropped);
+
+        for (uint32_t s = 0; s < cpu->used; s++) {
+            const struct ProfileStack* stack = &cpu->stacks[s];
+
+            /* Folded stack: outermost caller first, leaf last */
+            serial_wait_room(COM1_PORT, PROFILE_MAX_DEPTH * 19 + 16);
+            for (uint32_t d = stack->depth; d-- > 0;) {
+                serial_printf(COM1_PORT, d ? "0x%llx;" : "0x%llx", (unsigned long long)stack->pcs[d]);
+            }
+            serial_printf(COM1_PORT, " %u\n", stack->count);
+        }
+    }
+
+    serial_wait_room(COM1_PORT, 64);
+    serial_write_string(COM1_PORT, "=== profile end ===\n");
+}
+
+void profile_request_dump(void) {
+    dump_requested = 1;
+}
+
+void profile_poll(void) {
+    if (dump_requested) {
+        dump_requested = 0;
+        profile_dump();
+    }
+}
+
+void profile_get_stats(struct ProfileStats* stats) {
+    memset(stats, 0, sizeof(*stats));
+    for (int i = 0; i < MAX_CPUS; i++) {
+        struct ProfileCPU* cpu = &per_cpu(profile_cpu, i);
+        stats->samples += cpu->samples;
+        stats->dropped += cpu->dropped;
+        stats->stacks += cpu->used;
+    }
+    stats->hz = sample_hz;
+    stats->running = running;
+}
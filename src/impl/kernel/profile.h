@@ -0,0 +1,54 @@
+/**
+ * Sampling Profiler
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "hashtable.h"
+
+#define PROFILE_DEFAULT_HZ  1000
+#define PROFILE_MAX_DEPTH   16      /* Interrupted RIP plus return addresses */
+#define PROFILE_MAX_STACKS  1024    /* Distinct stacks kept per CPU */
+
+/* One distinct call stack and how often it was sampled; pcs[0] is the leaf */
+struct ProfileStack {
+    struct HashNode node;
+    uint32_t count;
+    uint32_t depth;
+    uint64_t pcs[PROFILE_MAX_DEPTH];
+};
+
+struct ProfileStats {
+    uint64_t samples;
+    uint64_t dropped;       /* Stack table full */
+    uint32_t stacks;
+    uint32_t hz;
+    int running;
+};
+
+/* Start sampling at roughly `hz` (a multiple of the timer tick rate) */
+void profile_start(uint32_t hz);
+void profile_stop(void);
+int profile_running(void);
+
+/*
+ * Record one sample. Called from the timer interrupt with the interrupted
+ * RIP and the interrupted code's frame pointer.
+ */
+void profile_sample(uint64_t rip, uint64_t rbp);
+
+/*
+ * Write the samples to COM1 as folded stacks (root first, one line per
+ * stack, addresses in hex) between begin/end marker lines. Symbolize on
+ * the host with tools/profile_symbolize.py.
+ */
+void profile_dump(void);
+
+/* Ask the idle loop to dump; safe from interrupt context */
+void profile_request_dump(void);
+void profile_poll(void);
+
+void profile_get_stats(struct ProfileStats* stats);
@@ -0,0 +1,196 @@
+/**
+ * Integer ID Radix Tree Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "radix_tree.h"
+#include <stddef.h>
+
+#define RADIX_MAX_HEIGHT    6
+
+struct RadixPath {
+    struct RadixNode* nodes[RADIX_MAX_HEIGHT];
+    uint32_t index[RADIX_MAX_HEIGHT];
+};
+
+static struct RadixNode* node_alloc(struct RadixTree* tree) {
+    struct RadixNode* node = tree->free_nodes;
+    if (!node) {
+        return NULL;
+    }
+    tree->free_nodes = (struct RadixNode*)node->slots[0];
+
+    node->full = 0;
+    node->count = 0;
+    for (int i = 0; i < RADIX_TREE_FANOUT; i++) {
+        node->slots[i] = NULL;
+    }
+    return node;
+}
+
+static void node_free(struct RadixTree* tree, struct RadixNode* node) {
+    node->slots[0] = tree->free_nodes;
+    tree->free_nodes = node;
+}
+
+static inline uint32_t level_index(const struct RadixTree* tree, uint32_t id, uint32_t level) {
+    return (id >> ((tree->height - 1 - level) * RADIX_TREE_SHIFT)) & RADIX_TREE_MASK;
+}
+
+/* Release empty nodes from `depth` upwards along a recorded path */
+static void prune(struct RadixTree* tree, struct RadixPath* path, int depth) {
+    for (int level = depth; level >= 0; level--) {
+        struct RadixNode* node = path->nodes[level];
+        if (node->count) {
+            return;
+        }
+        node_free(tree, node);
+        if (level == 0) {
+            tree->root = NULL;
+        } else {
+            struct RadixNode* parent = path->nodes[level - 1];
+            parent->slots[path->index[level - 1]] = NULL;
+            parent->count--;
+        }
+    }
+}
+
+void radix_tree_init(struct RadixTree* tree, struct RadixNode* pool,
+                     uint32_t pool_nodes, uint32_t max_id) {
+    tree->root = NULL;
+    tree->free_nodes = NULL;
+    tree->max_id = max_id;
+
+    tree->height = 1;
+    uint64_t span = RADIX_TREE_FANOUT;
+    while (span < max_id && tree->height < RADIX_MAX_HEIGHT) {
+        span <<= RADIX_TREE_SHIFT;
+        tree->height++;
+    }
+
+    for (uint32_t i = 0; i < pool_nodes; i++) {
+        node_free(tree, &pool[i]);
+    }
+}
+
+int radix_tree_insert(struct RadixTree* tree, uint32_t id, void* item) {
+    if (id >= tree->max_id || !item) {
+        return -1;
+    }
+    if (!tree->root && !(tree->root = node_alloc(tree))) {
+        return -1;
+    }
+
+    struct RadixPath path;
+    struct RadixNode* node = tree->root;
+    uint32_t leaf = tree->height - 1;
+
+    for (uint32_t level = 0; level < leaf; level++) {
+        uint32_t idx = level_index(tree, id, level);
+        path.nodes[level] = node;
+        path.index[level] = idx;
+
+        struct RadixNode* child = node->slots[idx];
+        if (!child) {
+            child = node_alloc(tree);
+            if (!child) {
+                prune(tree, &path, (int)level);
+                return -1;
+            }
+            node->slots[idx] = child;
+            node->count++;
+        }
+        node = child;
+    }
+
+    uint32_t idx = level_index(tree, id, leaf);
+    if (node->slots[idx]) {
+        return -1;
+    }
+    node->slots[idx] = item;
+    node->count++;
+    node->full |= 1ull << idx;
+
+    /* A node that just filled up marks its slot full in the parent */
+    for (int level = (int)leaf - 1; level >= 0 && node->full == ~0ull; level--) {
+        node = path.nodes[level];
+        node->full |= 1ull << path.index[level];
+    }
+    return 0;
+}
+
+int radix_tree_alloc(struct RadixTree* tree, void* item) {
+    uint32_t id = 0;
+    struct RadixNode* node = tree->root;
+
+    for (uint32_t level = 0; node && level < tree->height; level++) {
+        uint64_t free_slots = ~node->full;
+        if (!free_slots) {
+            return -1;
+        }
+        uint32_t idx = (uint32_t)__builtin_ctzll(free_slots);
+        id |= idx << ((tree->height - 1 - level) * RADIX_TREE_SHIFT);
+
+        /* An absent child means its whole range is free; stop there */
+        if (level + 1 < tree->height) {
+            node = node->slots[idx];
+        }
+    }
+
+    if (radix_tree_insert(tree, id, item) < 0) {
+        return -1;
+    }
+    return (int)id;
+}
+
+void* radix_tree_lookup(const struct RadixTree* tree, uint32_t id) {
+    if (id >= tree->max_id) {
+        return NULL;
+    }
+
+    struct RadixNode* node = tree->root;
+    for (uint32_t level = 0; node && level + 1 < tree->height; level++) {
+        node = node->slots[level_index(tree, id, level)];
+    }
+    return node ? node->slots[level_index(tree, id, tree->height - 1)] : NULL;
+}
+
+void* radix_tree_remove(struct RadixTree* tree, uint32_t id) {
+    if (id >= tree->max_id || !tree->root) {
+        return NULL;
+    }
+
+    struct RadixPath path;
+    struct RadixNode* node = tree->root;
+    uint32_t leaf = tree->height - 1;
+
+    for (uint32_t level = 0; level < leaf; level++) {
+        uint32_t idx = level_index(tree, id, level);
+        path.nodes[level] = node;
+        path.index[level] = idx;
+        node = node->slots[idx];
+        if (!node) {
+            return NULL;
+        }
+    }
+
+    uint32_t idx = level_index(tree, id, leaf);
+    void* item = node->slots[idx];
+    if (!item) {
+        return NULL;
+    }
+    node->slots[idx] = NULL;
+    node->count--;
+    node->full &= ~(1ull << idx);
+    path.nodes[leaf] = node;
+    path.index[leaf] = idx;
+
+    /* Nothing above can be full any more */
+    for (int level = (int)leaf - 1; level >= 0; level--) {
+        path.nodes[level]->full &= ~(1ull << path.index[level]);
+    }
+
+    prune(tree, &path, (int)leaf);
+    return item;
+}
@@ -0,0 +1,53 @@
+/**
+ * Integer ID Radix Tree
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+
+/*
+ * Maps small integers (file descriptors, handles) to pointers with 64-way
+ * nodes. Every node keeps a bitmap of slots whose subtree is completely
+ * full, so finding the lowest free ID is one bit scan per level instead
+ * of a walk over every entry. Nodes come from a pool supplied by the
+ * owner; the tree itself never allocates.
+ */
+#define RADIX_TREE_SHIFT    6
+#define RADIX_TREE_FANOUT   (1 << RADIX_TREE_SHIFT)
+#define RADIX_TREE_MASK     (RADIX_TREE_FANOUT - 1)
+
+struct RadixNode {
+    uint64_t full;              /* Slot is occupied (leaf) or subtree is full */
+    uint32_t count;             /* Non-NULL slots */
+    uint32_t reserved;
+    void* slots[RADIX_TREE_FANOUT];
+};
+
+struct RadixTree {
+    struct RadixNode* root;
+    struct RadixNode* free_nodes;   /* Pool free list, linked through slots[0] */
+    uint32_t height;
+    uint32_t max_id;                /* IDs are 0 .. max_id - 1 */
+};
+
+/* Worst-case pool size for up to 2^18 IDs: every node of every level live */
+#define RADIX_POOL_NODES(max_id) \
+    (((max_id) + (1u << 6) - 1) / (1u << 6) + \
+     ((max_id) + (1u << 12) - 1) / (1u << 12) + \
+     ((max_id) + (1u << 18) - 1) / (1u << 18))
+
+void radix_tree_init(struct RadixTree* tree, struct RadixNode* pool,
+                     uint32_t pool_nodes, uint32_t max_id);
+
+/* Returns -1 if the ID is out of range, taken, or the pool is empty */
+int radix_tree_insert(struct RadixTree* tree, uint32_t id, void* item);
+
+/* Stores `item` at the lowest free ID and returns it, or -1 */
+int radix_tree_alloc(struct RadixTree* tree, void* item);
+
+void* radix_tree_lookup(const struct RadixTree* tree, uint32_t id);
+
+/* Returns the removed item, or NULL if the ID was empty */
+void* radix_tree_remove(struct RadixTree* tree, uint32_t id);
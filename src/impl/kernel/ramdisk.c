@@ -5,6 +5,7 @@
  */
 
 #include "ramdisk.h"
+#include "ktime.h"
 #include <string.h>
 #include <stdlib.h>
 #include "../../intf/print.h"
@@ -28,6 +29,11 @@ static struct FSOperations ramdisk_ops = {
     .chown = NULL
 };
 
+static int file_name_match(const struct HashNode* node, const void* key) {
+    const struct RamDiskFile* file = hash_entry(node, struct RamDiskFile, name_node);
+    return strcmp(file->name, (const char*)key) == 0;
+}
+
 /* Create a new RAM disk filesystem */
 struct FileSystem* ramdisk_create(void) {
     struct FileSystem* fs = (struct FileSystem*)malloc(sizeof(struct FileSystem));
@@ -53,6 +59,11 @@ struct FileSystem* ramdisk_create(void) {
 
     memset(ramdisk->data, 0, RAMDISK_SIZE);
     memset(ramdisk->files, 0, sizeof(ramdisk->files));
+    hash_init(&ramdisk->names, ramdisk->name_slots, RAMDISK_HASH_SLOTS, file_name_match);
+    list_init(&ramdisk->free_files);
+    for (int i = 0; i < RAMDISK_MAX_FILES; i++) {
+        list_add_tail(&ramdisk->files[i].free_link, &ramdisk->free_files);
+    }
     
     ramdisk->total_blocks = RAMDISK_SIZE / RAMDISK_BLOCK_SIZE;
     ramdisk->free_blocks = ramdisk->total_blocks;
@@ -84,24 +95,20 @@ void ramdisk_destroy(struct FileSystem* fs) {
     print_str("[RAMDISK] Destroyed RAM disk filesystem\n");
 }
 
-/* Find a free file entry */
+/* Take a free file entry off the free list */
 static struct RamDiskFile* find_free_file(struct RamDisk* ramdisk) {
-    for (int i = 0; i < RAMDISK_MAX_FILES; i++) {
-        if (!ramdisk->files[i].in_use) {
-            return &ramdisk->files[i];
-        }
+    struct ListNode* link = list_first(&ramdisk->free_files);
+    if (!link) {
+        return NULL;
     }
-    return NULL;
+    list_del(link);
+    return list_entry(link, struct RamDiskFile, free_link);
 }
 
 /* Find a file by name */
 static struct RamDiskFile* find_file_by_name(struct RamDisk* ramdisk, const char* name) {
-    for (int i = 0; i < RAMDISK_MAX_FILES; i++) {
-        if (ramdisk->files[i].in_use && strcmp(ramdisk->files[i].name, name) == 0) {
-            return &ramdisk->files[i];
-        }
-    }
-    return NULL;
+    struct HashNode* node = hash_find(&ramdisk->names, hash_string(name), name);
+    return node ? hash_entry(node, struct RamDiskFile, name_node) : NULL;
 }
 
 /* Allocate blocks for a file */
@@ -142,10 +149,11 @@ int ramdisk_create_file(struct FSNode* parent, const char* name, uint32_t flags)
     file->size = 0;
     file->block_start = 0;
     file->block_count = 0;
-    file->create_time = 0; // TODO: Add system time
+    file->create_time = ktime_get_real_seconds();
     file->modify_time = file->create_time;
     file->access_time = file->create_time;
     file->in_use = 1;
+    hash_insert(&ramdisk->names, &file->name_node, hash_string(file->name));
 
     print_str("[RAMDISK] Created file: ");
     print_str(name);
@@ -168,8 +176,10 @@ int ramdisk_delete_file(struct FSNode* node) {
     // Mark blocks as free
     ramdisk->free_blocks += file->block_count;
     
-    // Clear file entry
+    // Clear file entry and return it to the free list
+    hash_remove(&ramdisk->names, &file->name_node);
     memset(file, 0, sizeof(struct RamDiskFile));
+    list_add_tail(&file->free_link, &ramdisk->free_files);
 
     print_str("[RAMDISK] Deleted file: ");
     print_str(node->name);
@@ -200,7 +210,7 @@ int ramdisk_read(struct FSNode* node, uint64_t offset, uint64_t size, void* buff
 
     uint8_t* src = ramdisk->data + (file->block_start * RAMDISK_BLOCK_SIZE) + offset;
     memcpy(buffer, src, read_size);
-    file->access_time = 0; // TODO: Add system time
+    file->access_time = ktime_get_real_seconds();
 
     return read_size;
 }
@@ -245,7 +255,7 @@ int ramdisk_write(struct FSNode* node, uint64_t offset, uint64_t size, const voi
         file->size = offset + size;
     }
 
-    file->modify_time = 0; // TODO: Add system time
+    file->modify_time = ktime_get_real_seconds();
     file->access_time = file->modify_time;
 
     return size;
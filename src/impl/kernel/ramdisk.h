@@ -6,12 +6,15 @@
 
 #pragma once
 #include "fs.h"
+#include "hashtable.h"
+#include "list.h"
 
 /* RAM disk configuration */
 #define RAMDISK_SIZE (1024 * 1024)  // 1MB RAM disk
 #define RAMDISK_BLOCK_SIZE 512
 #define RAMDISK_MAX_FILES 64
 #define RAMDISK_MAX_NAME_LEN 32
+#define RAMDISK_HASH_SLOTS 128      /* Power of two, keeps load at or below 1/2 */
 
 /* RAM disk file entry */
 struct RamDiskFile {
@@ -20,16 +23,21 @@ struct RamDiskFile {
     uint32_t size;
     uint32_t block_start;
     uint32_t block_count;
-    uint64_t create_time;
+    uint64_t create_time;           /* Seconds since the Unix epoch */
     uint64_t modify_time;
     uint64_t access_time;
     int in_use;
+    struct HashNode name_node;      /* Linked into the name table while in use */
+    struct ListNode free_link;      /* Linked into the free list otherwise */
 };
 
 /* RAM disk structure */
 struct RamDisk {
     uint8_t* data;
     struct RamDiskFile files[RAMDISK_MAX_FILES];
+    struct HashTable names;
+    struct HashSlot name_slots[RAMDISK_HASH_SLOTS];
+    struct ListNode free_files;
     uint32_t free_block_start;
     uint32_t total_blocks;
     uint32_t free_blocks;
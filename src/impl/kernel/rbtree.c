@@ -0,0 +1,263 @@
+/**
+ * Intrusive Red-Black Tree Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "rbtree.h"
+
+static inline int is_red(const struct RBNode* node) {
+    return node && node->color == RB_RED;
+}
+
+static inline int is_black(const struct RBNode* node) {
+    return !node || node->color == RB_BLACK;
+}
+
+/* Point whatever referenced `old` (parent link or root) at `new` */
+static void replace_child(struct RBNode* parent, struct RBNode* old,
+                          struct RBNode* new, struct RBRoot* root) {
+    if (!parent) {
+        root->node = new;
+    } else if (parent->left == old) {
+        parent->left = new;
+    } else {
+        parent->right = new;
+    }
+}
+
+static void rotate_left(struct RBNode* node, struct RBRoot* root) {
+    struct RBNode* right = node->right;
+    struct RBNode* parent = node->parent;
+
+    node->right = right->left;
+    if (right->left) {
+        right->left->parent = node;
+    }
+    right->left = node;
+    right->parent = parent;
+    replace_child(parent, node, right, root);
+    node->parent = right;
+}
+
+static void rotate_right(struct RBNode* node, struct RBRoot* root) {
+    struct RBNode* left = node->left;
+    struct RBNode* parent = node->parent;
+
+    node->left = left->right;
+    if (left->right) {
+        left->right->parent = node;
+    }
+    left->right = node;
+    left->parent = parent;
+    replace_child(parent, node, left, root);
+    node->parent = left;
+}
+
+void rb_insert_color(struct RBNode* node, struct RBRoot* root) {
+    struct RBNode* parent;
+
+    while ((parent = node->parent) && parent->color == RB_RED) {
+        /* A red parent is never the root, so the grandparent exists */
+        struct RBNode* gparent = parent->parent;
+
+        if (parent == gparent->left) {
+            struct RBNode* uncle = gparent->right;
+            if (is_red(uncle)) {
+                parent->color = RB_BLACK;
+                uncle->color = RB_BLACK;
+                gparent->color = RB_RED;
+                node = gparent;
+                continue;
+            }
+            if (node == parent->right) {
+                rotate_left(parent, root);
+                node = parent;
+                parent = node->parent;
+            }
+            parent->color = RB_BLACK;
+            gparent->color = RB_RED;
+            rotate_right(gparent, root);
+        } else {
+            struct RBNode* uncle = gparent->left;
+            if (is_red(uncle)) {
+                parent->color = RB_BLACK;
+                uncle->color = RB_BLACK;
+                gparent->color = RB_RED;
+                node = gparent;
+                continue;
+            }
+            if (node == parent->left) {
+                rotate_right(parent, root);
+                node = parent;
+                parent = node->parent;
+            }
+            parent->color = RB_BLACK;
+            gparent->color = RB_RED;
+            rotate_left(gparent, root);
+        }
+    }
+
+    root->node->color = RB_BLACK;
+}
+
+/* Restore black height after removing a black node above `node` */
+static void erase_fixup(struct RBNode* node, struct RBNode* parent, struct RBRoot* root) {
+    while (node != root->node && is_black(node)) {
+        if (node == parent->left) {
+            struct RBNode* sibling = parent->right;
+            if (is_red(sibling)) {
+                sibling->color = RB_BLACK;
+                parent->color = RB_RED;
+                rotate_left(parent, root);
+                sibling = parent->right;
+            }
+            if (is_black(sibling->left) && is_black(sibling->right)) {
+                sibling->color = RB_RED;
+                node = parent;
+                parent = node->parent;
+                continue;
+            }
+            if (is_black(sibling->right)) {
+                sibling->left->color = RB_BLACK;
+                sibling->color = RB_RED;
+                rotate_right(sibling, root);
+                sibling = parent->right;
+            }
+            sibling->color = parent->color;
+            parent->color = RB_BLACK;
+            sibling->right->color = RB_BLACK;
+            rotate_left(parent, root);
+            node = root->node;
+        } else {
+            struct RBNode* sibling = parent->left;
+            if (is_red(sibling)) {
+                sibling->color = RB_BLACK;
+                parent->color = RB_RED;
+                rotate_right(parent, root);
+                sibling = parent->left;
+            }
+            if (is_black(sibling->left) && is_black(sibling->right)) {
+                sibling->color = RB_RED;
+                node = parent;
+                parent = node->parent;
+                continue;
+            }
+            if (is_black(sibling->left)) {
+                sibling->right->color = RB_BLACK;
+                sibling->color = RB_RED;
+                rotate_left(sibling, root);
+                sibling = parent->left;
+            }
+            sibling->color = parent->color;
+            parent->color = RB_BLACK;
+            sibling->left->color = RB_BLACK;
+            rotate_right(parent, root);
+            node = root->node;
+        }
+    }
+
+    if (node) {
+        node->color = RB_BLACK;
+    }
+}
+
+void rb_erase(struct RBNode* node, struct RBRoot* root) {
+    struct RBNode* child;
+    struct RBNode* parent;
+    int color;
+
+    if (node->left && node->right) {
+        /* Splice out the in-order successor and put it where `node` was */
+        struct RBNode* succ = node->right;
+        while (succ->left) {
+            succ = succ->left;
+        }
+
+        child = succ->right;
+        parent = succ->parent;
+        color = succ->color;
+
+        if (parent == node) {
+            parent = succ;
+        } else {
+            if (child) {
+                child->parent = parent;
+            }
+            parent->left = child;
+            succ->right = node->right;
+            node->right->parent = succ;
+        }
+
+        succ->left = node->left;
+        node->left->parent = succ;
+        succ->parent = node->parent;
+        succ->color = node->color;
+        replace_child(node->parent, node, succ, root);
+    } else {
+        child = node->left ? node->left : node->right;
+        parent = node->parent;
+        color = node->color;
+
+        if (child) {
+            child->parent = parent;
+        }
+        replace_child(parent, node, child, root);
+    }
+
+    if (color == RB_BLACK) {
+        erase_fixup(child, parent, root);
+    }
+}
+
+struct RBNode* rb_first(const struct RBRoot* root) {
+    struct RBNode* node = root->node;
+    if (node) {
+        while (node->left) {
+            node = node->left;
+        }
+    }
+    return node;
+}
+
+struct RBNode* rb_last(const struct RBRoot* root) {
+    struct RBNode* node = root->node;
+    if (node) {
+        while (node->right) {
+            node = node->right;
+        }
+    }
+    return node;
+}
+
+struct RBNode* rb_next(const struct RBNode* node) {
+    if (node->right) {
+        node = node->right;
+        while (node->left) {
+            node = node->left;
+        }
+        return (struct RBNode*)node;
+    }
+
+    struct RBNode* parent;
+    while ((parent = node->parent) && node == parent->right) {
+        node = parent;
+    }
+    return parent;
+}
+
+struct RBNode* rb_prev(const struct RBNode* node) {
+    if (node->left) {
+        node = node->left;
+        while (node->right) {
+            node = node->right;
+        }
+        return (struct RBNode*)node;
+    }
+
+    struct RBNode* parent;
+    while ((parent = node->parent) && node == parent->left) {
+        node = parent;
+    }
+    return parent;
+}
@@ -0,0 +1,50 @@
+/**
+ * Intrusive Red-Black Tree
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stddef.h>
+
+/*
+ * The tree only rebalances; ordering belongs to the caller. To insert,
+ * walk down from root->node comparing keys, then hand the final parent
+ * and child link to rb_link_node() followed by rb_insert_color(). Search
+ * is the same walk without the link step.
+ */
+#define RB_RED      0
+#define RB_BLACK    1
+
+struct RBNode {
+    struct RBNode* parent;
+    struct RBNode* left;
+    struct RBNode* right;
+    int color;
+};
+
+struct RBRoot {
+    struct RBNode* node;
+};
+
+#define RB_ROOT_INIT { NULL }
+
+#define rb_entry(ptr, type, member) container_of(ptr, type, member)
+
+static inline void rb_link_node(struct RBNode* node, struct RBNode* parent,
+                                struct RBNode** link) {
+    node->parent = parent;
+    node->left = NULL;
+    node->right = NULL;
+    node->color = RB_RED;
+    *link = node;
+}
+
+void rb_insert_color(struct RBNode* node, struct RBRoot* root);
+void rb_erase(struct RBNode* node, struct RBRoot* root);
+
+/* In-order traversal */
+struct RBNode* rb_first(const struct RBRoot* root);
+struct RBNode* rb_last(const struct RBRoot* root);
+struct RBNode* rb_next(const struct RBNode* node);
+struct RBNode* rb_prev(const struct RBNode* node);
@@ -0,0 +1,47 @@
+/**
+ * Sequence Lock
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+
+/*
+ * Readers never block: they copy the data and retry if a writer was
+ * active meanwhile (odd sequence) or finished in between (sequence moved).
+ * Writers must not be interrupted by readers of the same lock on this
+ * CPU, so they run with interrupts off.
+ */
+struct SeqLock {
+    volatile uint32_t sequence;
+};
+
+#define SEQLOCK_INIT    { 0 }
+
+#define seq_barrier()   __asm__ volatile("" ::: "memory")
+
+static inline uint32_t seq_read_begin(const struct SeqLock* lock) {
+    uint32_t seq;
+    while ((seq = lock->sequence) & 1) {
+        __asm__ volatile("pause");
+    }
+    seq_barrier();
+    return seq;
+}
+
+/* True if the data read since seq_read_begin() may be torn */
+static inline int seq_read_retry(const struct SeqLock* lock, uint32_t seq) {
+    seq_barrier();
+    return lock->sequence != seq;
+}
+
+static inline void seq_write_begin(struct SeqLock* lock) {
+    lock->sequence++;
+    seq_barrier();
+}
+
+static inline void seq_write_end(struct SeqLock* lock) {
+    seq_barrier();
+    lock->sequence++;
+}
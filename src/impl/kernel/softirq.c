@@ -0,0 +1,125 @@
+/**
+ * Softirqs and the Kernel Workqueue Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "softirq.h"
+#include "asm_utils.h"
+#include "kstat.h"
+#include "percpu.h"
+
+static softirq_fn_t softirq_handlers[NR_SOFTIRQS];
+static DEFINE_PER_CPU(volatile uint32_t, softirq_mask);
+static DEFINE_PER_CPU(int, softirq_running);
+
+static struct ListNode work_list = LIST_HEAD_INIT(work_list);
+
+DEFINE_KSTAT_ARRAY(stat_softirq, "softirq", NR_SOFTIRQS);
+DEFINE_KSTAT_COUNTER(stat_deferred, "softirq.deferred");
+DEFINE_KSTAT_COUNTER(stat_work, "work.run");
+
+void softirq_register(enum SoftIRQ nr, softirq_fn_t handler) {
+    softirq_handlers[nr] = handler;
+}
+
+void softirq_raise(enum SoftIRQ nr) {
+    uint64_t flags = asm_irq_save();
+    this_cpu(softirq_mask) |= 1u << nr;
+    asm_irq_restore(flags);
+}
+
+int softirq_pending(void) {
+    return this_cpu(softirq_mask) != 0;
+}
+
+void softirq_run(void) {
+    uint64_t flags = asm_irq_save();
+    int restart = SOFTIRQ_MAX_RESTART;
+    uint32_t pending;
+
+    if (this_cpu(softirq_running)) {
+        asm_irq_restore(flags);
+        return;
+    }
+    this_cpu(softirq_running) = 1;
+
+    /* Take the mask with interrupts off, then run with them on */
+    while ((pending = this_cpu(softirq_mask)) != 0) {
+        if (restart-- == 0) {
+            kstat_inc(stat_deferred);
+            break;
+        }
+        this_cpu(softirq_mask) = 0;
+        asm_sti();
+
+        while (pending) {
+            int nr = __builtin_ctz(pending);
+            pending &= pending - 1;
+            kstat_inc_at(stat_softirq, nr);
+            if (softirq_handlers[nr]) {
+                softirq_handlers[nr]();
+            }
+        }
+        asm_cli();
+    }
+
+    this_cpu(softirq_running) = 0;
+    asm_irq_restore(flags);
+}
+
+void work_init(struct Work* work, work_fn_t function, void* data) {
+    list_init(&work->entry);
+    work->function = function;
+    work->data = data;
+    work->pending = 0;
+}
+
+int schedule_work(struct Work* work) {
+    uint64_t flags = asm_irq_save();
+    int queued = !work->pending;
+
+    if (queued) {
+        work->pending = 1;
+        list_add_tail(&work->entry, &work_list);
+    }
+    asm_irq_restore(flags);
+    return queued;
+}
+
+int cancel_work(struct Work* work) {
+    uint64_t flags = asm_irq_save();
+    int was_pending = work->pending;
+
+    if (was_pending) {
+        list_del(&work->entry);
+        work->pending = 0;
+    }
+    asm_irq_restore(flags);
+    return was_pending;
+}
+
+void workqueue_run(void) {
+    struct ListNode batch = LIST_HEAD_INIT(batch);
+    uint64_t flags = asm_irq_save();
+
+    list_splice_tail_init(&work_list, &batch);
+
+    /* Items may be cancelled from interrupts while they wait on the batch */
+    while (!list_empty(&batch)) {
+        struct Work* work = list_entry(batch.next, struct Work, entry);
+        list_del(&work->entry);
+        work->pending = 0;
+        asm_irq_restore(flags);
+
+        kstat_inc(stat_work);
+        work->function(work->data);
+
+        flags = asm_irq_save();
+    }
+    asm_irq_restore(flags);
+}
+
+int workqueue_pending(void) {
+    return !list_empty(&work_list);
+}
@@ -0,0 +1,76 @@
+/**
+ * Softirqs and the Kernel Workqueue
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+#include "list.h"
+
+/*
+ * Interrupt handling is split in two. The top half, the registered IRQ
+ * handler, runs with interrupts off: it acknowledges the device, moves
+ * data into a ring and raises a softirq. Softirqs run on the way out of
+ * the outermost interrupt with interrupts back on, or from the idle loop
+ * when they keep re-raising themselves. Anything long, or anything that
+ * touches state the main loop also uses (console, GUI), goes on the
+ * workqueue, which runs in the main loop.
+ */
+enum SoftIRQ {
+    SOFTIRQ_KEYBOARD,
+    SOFTIRQ_MOUSE,
+    NR_SOFTIRQS
+};
+
+/* Rounds of newly raised softirqs handled per interrupt exit before the idle loop takes over */
+#define SOFTIRQ_MAX_RESTART 8
+
+typedef void (*softirq_fn_t)(void);
+
+void softirq_register(enum SoftIRQ nr, softirq_fn_t handler);
+
+/* Mark `nr` pending; callable from any context */
+void softirq_raise(enum SoftIRQ nr);
+
+int softirq_pending(void);
+
+/*
+ * Run pending softirqs with interrupts enabled, unless they are already
+ * running further down the stack. Called by the interrupt dispatcher and
+ * the idle loop.
+ */
+void softirq_run(void);
+
+typedef void (*work_fn_t)(void* data);
+
+struct Work {
+    struct ListNode entry;
+    work_fn_t function;
+    void* data;
+    uint8_t pending;
+};
+
+#define WORK_INIT(name, fn, arg) \
+    { LIST_HEAD_INIT((name).entry), (fn), (arg), 0 }
+
+void work_init(struct Work* work, work_fn_t function, void* data);
+
+/*
+ * Queue `work` to run once in the main loop. Callable from any context.
+ * Returns 0 if it was already queued, which is not an error: it has not
+ * run yet, so it will see whatever prompted this call.
+ */
+int schedule_work(struct Work* work);
+
+/* Remove queued work; returns 1 if it was queued */
+int cancel_work(struct Work* work);
+
+/*
+ * Run the work queued so far, in order; work queued meanwhile waits for
+ * the next call. Main loop only; items run with interrupts enabled and
+ * may queue themselves again.
+ */
+void workqueue_run(void);
+
+int workqueue_pending(void);
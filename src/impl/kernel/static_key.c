@@ -0,0 +1,72 @@
+/**
+ * Static Keys Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "static_key.h"
+#include "alternative.h"
+#include "asm_utils.h"
+#include "klog.h"
+
+#define OPCODE_JMP      0xE9
+
+/* Provided by the linker script */
+extern const struct JumpEntry __jump_table_start[];
+extern const struct JumpEntry __jump_table_end[];
+
+static const uint8_t nop5[5] = { 0x0F, 0x1F, 0x44, 0x00, 0x00 };
+
+static int site_is_nop(const uint8_t* code) {
+    for (int i = 0; i < 5; i++) {
+        if (code[i] != nop5[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void static_key_patch(struct StaticKey* key, int enable) {
+    uint64_t flags = asm_irq_save();
+
+    if (key->enabled == enable) {
+        asm_irq_restore(flags);
+        return;
+    }
+
+    for (const struct JumpEntry* entry = __jump_table_start; entry < __jump_table_end; entry++) {
+        if (entry->key != (uint64_t)(uintptr_t)key) {
+            continue;
+        }
+
+        uint8_t* code = (uint8_t*)(uintptr_t)entry->code;
+        if (!site_is_nop(code) && code[0] != OPCODE_JMP) {
+            klog_err("[KEY] Bad static key site 0x%llx", (unsigned long long)entry->code);
+            continue;
+        }
+
+        if (enable) {
+            uint8_t jmp[5];
+            int32_t rel32 = (int32_t)(entry->target - (entry->code + 5));
+            jmp[0] = OPCODE_JMP;
+            jmp[1] = (uint8_t)rel32;
+            jmp[2] = (uint8_t)(rel32 >> 8);
+            jmp[3] = (uint8_t)(rel32 >> 16);
+            jmp[4] = (uint8_t)(rel32 >> 24);
+            text_poke(code, jmp, sizeof(jmp));
+        } else {
+            text_poke(code, nop5, sizeof(nop5));
+        }
+    }
+
+    key->enabled = enable;
+    asm_irq_restore(flags);
+}
+
+void static_key_enable(struct StaticKey* key) {
+    static_key_patch(key, 1);
+}
+
+void static_key_disable(struct StaticKey* key) {
+    static_key_patch(key, 0);
+}
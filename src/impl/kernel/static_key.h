@@ -0,0 +1,54 @@
+/**
+ * Static Keys
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * A static key is a boolean tested by patched code instead of a load and
+ * branch. Every test site starts as a 5-byte NOP; enabling the key
+ * rewrites each site into a `jmp rel32` to the code guarded by the test,
+ * and disabling it writes the NOP back.
+ */
+struct StaticKey {
+    int enabled;
+};
+
+#define STATIC_KEY_INIT_FALSE   { 0 }
+
+/* One test site, recorded in the .jump_table section (see linker.ld) */
+struct JumpEntry {
+    uint64_t code;          /* Address of the 5-byte NOP / jmp */
+    uint64_t target;        /* Where the jmp goes when the key is on */
+    uint64_t key;           /* struct StaticKey* controlling the site */
+};
+
+/*
+ * True when `key` is enabled; costs one NOP when it is not. `key` must be
+ * the address of an object with static storage. Named labels are used
+ * because `1b` reads as a binary literal under -masm=intel.
+ */
+static inline __attribute__((always_inline)) int static_key_false(struct StaticKey* key) {
+    __asm__ goto(".Lstatic_key_%=:\n"
+                 ".byte 0x0F, 0x1F, 0x44, 0x00, 0x00\n"
+                 ".pushsection .jump_table, \"a\"\n"
+                 ".balign 8\n"
+                 ".quad .Lstatic_key_%=, %l[enabled], %c0\n"
+                 ".popsection\n"
+                 : : "i"(key) : : enabled);
+    return 0;
+enabled:
+    return 1;
+}
+
+/* Patch every site of `key`; no-ops if it is already in that state */
+void static_key_enable(struct StaticKey* key);
+void static_key_disable(struct StaticKey* key);
+
+static inline int static_key_enabled(const struct StaticKey* key) {
+    return key->enabled;
+}
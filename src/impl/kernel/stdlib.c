@@ -7,6 +7,8 @@
 #include "../../intf/stdlib.h"
 #include "../../intf/string.h"
 #include "mmu.h"
+#include "tracepoint.h"
+#include "kstat.h"
 
 /* Memory block header */
 struct MemBlock {
@@ -19,6 +21,12 @@ struct MemBlock {
 static struct MemBlock* heap_start = NULL;
 static const size_t MIN_ALLOC = 4096;  /* Minimum allocation size (4KB) */
 
+DEFINE_TRACEPOINT(malloc, "size=%llu ptr=0x%llx");
+DEFINE_TRACEPOINT(free, "ptr=0x%llx");
+
+DEFINE_KSTAT_COUNTER(stat_mallocs, "heap.mallocs");
+DEFINE_KSTAT_COUNTER(stat_frees, "heap.frees");
+
 /* Initialize a new block of memory */
 static struct MemBlock* init_block(void* addr, size_t size) {
     struct MemBlock* block = (struct MemBlock*)addr;
@@ -96,6 +104,8 @@ void* malloc(size_t size) {
 
     /* Mark block as used */
     block->is_free = 0;
+    kstat_inc(stat_mallocs);
+    tracepoint(malloc, size, block + 1);
 
     /* Return pointer to usable memory */
     return (void*)(block + 1);
@@ -107,6 +117,8 @@ void free(void* ptr) {
     /* Get block header */
     struct MemBlock* block = (struct MemBlock*)ptr - 1;
     block->is_free = 1;
+    kstat_inc(stat_frees);
+    tracepoint(free, ptr, 0);
 
     /* Merge with next block if free */
     if (block->next && block->next->is_free) {
@@ -147,4 +159,29 @@ void* realloc(void* ptr, size_t size) {
     free(ptr);
 
     return new_ptr;
-} 
\ No newline at end of file
+}
+
+/* Conversion functions: optional whitespace and sign, then decimal digits */
+long long atoll(const char* nptr) {
+    long long value = 0;
+    int negative = 0;
+
+    while (*nptr == ' ' || *nptr == '\t' || *nptr == '\n') {
+        nptr++;
+    }
+    if (*nptr == '-' || *nptr == '+') {
+        negative = *nptr++ == '-';
+    }
+    while (*nptr >= '0' && *nptr <= '9') {
+        value = value * 10 + (*nptr++ - '0');
+    }
+    return negative ? -value : value;
+}
+
+long atol(const char* nptr) {
+    return (long)atoll(nptr);
+}
+
+int atoi(const char* nptr) {
+    return (int)atoll(nptr);
+}
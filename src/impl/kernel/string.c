@@ -6,25 +6,70 @@
 
 #include "../../intf/string.h"
 #include "../../intf/stdlib.h"
-#include <stdarg.h>
+#include "alternative.h"
+#include "asm_utils.h"
+#include "sysinfo.h"
 
-void* memcpy(void* dest, const void* src, size_t n) {
+/*
+ * memcpy/memset are patchable entry points: the generic word loops run
+ * until alternatives_apply() retargets them to `rep movsb/stosb` on CPUs
+ * with enhanced REP MOVSB/STOSB.
+ */
+void* memcpy_generic(void* dest, const void* src, size_t n);
+void* memcpy_erms(void* dest, const void* src, size_t n);
+void* memset_generic(void* s, int c, size_t n);
+void* memset_erms(void* s, int c, size_t n);
+
+ALTERNATIVE_ENTRY(memcpy, memcpy_generic);
+ALTERNATIVE_VARIANT(memcpy, memcpy_erms, CPU_FEATURE_ERMS, 1);
+ALTERNATIVE_ENTRY(memset, memset_generic);
+ALTERNATIVE_VARIANT(memset, memset_erms, CPU_FEATURE_ERMS, 1);
+
+/* Keep GCC from turning these loops back into calls to memcpy/memset */
+#define NO_LIBCALL __attribute__((optimize("no-tree-loop-distribute-patterns")))
+
+NO_LIBCALL void* memcpy_generic(void* dest, const void* src, size_t n) {
     uint8_t* d = (uint8_t*)dest;
     const uint8_t* s = (const uint8_t*)src;
-    for (size_t i = 0; i < n; i++) {
-        d[i] = s[i];
+    while (n >= sizeof(uint64_t)) {
+        *(uint64_t __attribute__((may_alias, aligned(1)))*)d =
+            *(const uint64_t __attribute__((may_alias, aligned(1)))*)s;
+        d += sizeof(uint64_t);
+        s += sizeof(uint64_t);
+        n -= sizeof(uint64_t);
+    }
+    while (n--) {
+        *d++ = *s++;
     }
     return dest;
 }
 
-void* memset(void* s, int c, size_t n) {
+void* memcpy_erms(void* dest, const void* src, size_t n) {
+    void* ret = dest;
+    ASM_INLINE ("rep movsb" : "+D" (dest), "+S" (src), "+c" (n) :: "memory");
+    return ret;
+}
+
+NO_LIBCALL void* memset_generic(void* s, int c, size_t n) {
     uint8_t* p = (uint8_t*)s;
-    for (size_t i = 0; i < n; i++) {
-        p[i] = (uint8_t)c;
+    uint64_t fill = 0x0101010101010101ULL * (uint8_t)c;
+    while (n >= sizeof(uint64_t)) {
+        *(uint64_t __attribute__((may_alias, aligned(1)))*)p = fill;
+        p += sizeof(uint64_t);
+        n -= sizeof(uint64_t);
+    }
+    while (n--) {
+        *p++ = (uint8_t)c;
     }
     return s;
 }
 
+void* memset_erms(void* s, int c, size_t n) {
+    void* ret = s;
+    ASM_INLINE ("rep stosb" : "+D" (s), "+c" (n) : "a" (c) : "memory");
+    return ret;
+}
+
 void* memmove(void* dest, const void* src, size_t n) {
     uint8_t* d = (uint8_t*)dest;
     const uint8_t* s = (const uint8_t*)src;
@@ -51,12 +96,88 @@ int memcmp(const void* s1, const void* s2, size_t n) {
     return 0;
 }
 
+/*
+ * Word-at-a-time helpers. Every load below is an aligned 8-byte word, so a
+ * scan never touches a page the byte loop would not have touched; bytes in
+ * the first word that sit before the string are forced non-zero.
+ */
+typedef uint64_t __attribute__((may_alias)) word_t;
+typedef uint64_t __attribute__((may_alias, aligned(1))) uword_t;
+
+#define WORD_SIZE       sizeof(word_t)
+#define WORD_ONES       0x0101010101010101ULL
+#define WORD_HIGHS      0x8080808080808080ULL
+#define WORD_LOWS       0x7F7F7F7F7F7F7F7FULL
+#define PAGE_BYTES      4096
+
+/* High bit set in the lowest zero byte (bits above it may be false hits) */
+static inline uint64_t word_has_zero(uint64_t v) {
+    return (v - WORD_ONES) & ~v & WORD_HIGHS;
+}
+
+/* High bit set in exactly the zero bytes */
+static inline uint64_t word_zero_bytes(uint64_t v) {
+    return ~(((v & WORD_LOWS) + WORD_LOWS) | v | WORD_LOWS);
+}
+
+/* Mask covering the first `count` (0-7) bytes of a word */
+static inline uint64_t word_lead_mask(uintptr_t count) {
+    return (1ULL << (count * 8)) - 1;
+}
+
+static inline size_t word_first_byte(uint64_t mask) {
+    return (size_t)__builtin_ctzll(mask) >> 3;
+}
+
+static inline size_t word_last_byte(uint64_t mask) {
+    return (size_t)(63 - __builtin_clzll(mask)) >> 3;
+}
+
+/* True when an unaligned word load at p stays inside one page */
+static inline int word_load_safe(const void* p) {
+    return ((uintptr_t)p & (PAGE_BYTES - 1)) <= PAGE_BYTES - WORD_SIZE;
+}
+
 size_t strlen(const char* s) {
-    size_t len = 0;
-    while (s[len]) {
-        len++;
+    uintptr_t misalign = (uintptr_t)s & (WORD_SIZE - 1);
+    const word_t* w = (const word_t*)(s - misalign);
+    uint64_t mask = word_has_zero(*w | word_lead_mask(misalign));
+
+    while (!mask) {
+        mask = word_has_zero(*++w);
+    }
+    return (size_t)((const char*)w + word_first_byte(mask) - s);
+}
+
+size_t strnlen(const char* s, size_t maxlen) {
+    const char* end = memchr(s, '\0', maxlen);
+    return end ? (size_t)(end - s) : maxlen;
+}
+
+void* memchr(const void* s, int c, size_t n) {
+    if (n == 0) {
+        return NULL;
+    }
+
+    const uint8_t* p = (const uint8_t*)s;
+    uintptr_t misalign = (uintptr_t)p & (WORD_SIZE - 1);
+    const word_t* w = (const word_t*)(p - misalign);
+    uint64_t pattern = WORD_ONES * (uint8_t)c;
+    /* Bytes of the current word that are still inside [s, s + n) */
+    size_t remaining = n > (size_t)-1 - misalign ? (size_t)-1 : n + misalign;
+    uint64_t mask = word_has_zero((*w ^ pattern) | word_lead_mask(misalign));
+
+    for (;;) {
+        if (mask) {
+            size_t index = word_first_byte(mask);
+            return index < remaining ? (void*)((const uint8_t*)w + index) : NULL;
+        }
+        if (remaining <= WORD_SIZE) {
+            return NULL;
+        }
+        remaining -= WORD_SIZE;
+        mask = word_has_zero(*++w ^ pattern);
     }
-    return len;
 }
 
 char* strcpy(char* dest, const char* src) {
@@ -98,235 +219,125 @@ char* strncat(char* dest, const char* src, size_t n) {
 }
 
 int strcmp(const char* s1, const char* s2) {
-    while (*s1 && (*s1 == *s2)) {
+    /* Byte steps until s1 is aligned; s2 is then loaded unaligned */
+    while ((uintptr_t)s1 & (WORD_SIZE - 1)) {
+        if (*s1 != *s2 || !*s1) {
+            return *(const unsigned char*)s1 - *(const unsigned char*)s2;
+        }
         s1++;
         s2++;
     }
-    return *(const unsigned char*)s1 - *(const unsigned char*)s2;
+
+    for (;;) {
+        if (word_load_safe(s2)) {
+            uint64_t a = *(const word_t*)s1;
+            uint64_t b = *(const uword_t*)s2;
+            if (a == b && !word_has_zero(a)) {
+                s1 += WORD_SIZE;
+                s2 += WORD_SIZE;
+                continue;
+            }
+        }
+
+        /* Difference, terminator or page edge within the next word */
+        for (size_t i = 0; i < WORD_SIZE; i++) {
+            if (*s1 != *s2 || !*s1) {
+                return *(const unsigned char*)s1 - *(const unsigned char*)s2;
+            }
+            s1++;
+            s2++;
+        }
+    }
 }
 
 int strncmp(const char* s1, const char* s2, size_t n) {
-    while (n && *s1 && (*s1 == *s2)) {
+    while (n && ((uintptr_t)s1 & (WORD_SIZE - 1))) {
+        if (*s1 != *s2 || !*s1) {
+            return *(const unsigned char*)s1 - *(const unsigned char*)s2;
+        }
         s1++;
         s2++;
         n--;
     }
-    if (n == 0) {
-        return 0;
-    }
-    return *(const unsigned char*)s1 - *(const unsigned char*)s2;
-}
 
-char* strchr(const char* s, int c) {
-    while (*s != (char)c) {
-        if (!*s++) {
-            return 0;
+    while (n >= WORD_SIZE) {
+        if (word_load_safe(s2)) {
+            uint64_t a = *(const word_t*)s1;
+            uint64_t b = *(const uword_t*)s2;
+            if (a == b && !word_has_zero(a)) {
+                s1 += WORD_SIZE;
+                s2 += WORD_SIZE;
+                n -= WORD_SIZE;
+                continue;
+            }
         }
+        break;
     }
-    return (char*)s;
-}
 
-char* strrchr(const char* s, int c) {
-    const char* found = NULL;
-    while (*s) {
-        if (*s == (char)c) {
-            found = s;
+    while (n) {
+        if (*s1 != *s2 || !*s1) {
+            return *(const unsigned char*)s1 - *(const unsigned char*)s2;
         }
-        s++;
-    }
-    if (c == '\0') {
-        return (char*)s;
+        s1++;
+        s2++;
+        n--;
     }
-    return (char*)found;
+    return 0;
 }
 
-char* strdup(const char* s) {
-    size_t len = strlen(s) + 1;
-    char* new = (char*)malloc(len);
-    if (new) {
-        memcpy(new, s, len);
+char* strchr(const char* s, int c) {
+    uintptr_t misalign = (uintptr_t)s & (WORD_SIZE - 1);
+    const word_t* w = (const word_t*)(s - misalign);
+    uint64_t pattern = WORD_ONES * (uint8_t)c;
+    uint64_t lead = word_lead_mask(misalign);
+    uint64_t v = *w;
+    uint64_t mask = word_has_zero(v | lead) | word_has_zero((v ^ pattern) | lead);
+
+    while (!mask) {
+        v = *++w;
+        mask = word_has_zero(v) | word_has_zero(v ^ pattern);
     }
-    return new;
+
+    const char* p = (const char*)w + word_first_byte(mask);
+    return *p == (char)c ? (char*)p : NULL;
 }
 
-/* Simple printf-style formatting */
-static void print_num(char** str, uint64_t num, int base, int width, int pad_char) {
-    char tmp[65];
-    char* digits = "0123456789ABCDEF";
-    int i = 0;
-
-    /* Convert number to string */
-    do {
-        tmp[i++] = digits[num % base];
-        num /= base;
-    } while (num);
-
-    /* Pad if necessary */
-    while (i < width) {
-        tmp[i++] = pad_char;
+char* strrchr(const char* s, int c) {
+    if ((char)c == '\0') {
+        return (char*)s + strlen(s);
     }
 
-    /* Reverse the string */
-    while (i > 0) {
-        *(*str)++ = tmp[--i];
-    }
-}
+    uintptr_t misalign = (uintptr_t)s & (WORD_SIZE - 1);
+    const word_t* w = (const word_t*)(s - misalign);
+    uint64_t pattern = WORD_ONES * (uint8_t)c;
+    uint64_t lead = word_lead_mask(misalign);
+    const char* found = NULL;
 
-int vsprintf(char* str, const char* format, va_list args) {
-    char* str_start = str;
-    char c;
-    int width;
+    for (;;) {
+        uint64_t v = *w | lead;
+        uint64_t zero = word_has_zero(v);
+        uint64_t match = word_zero_bytes((*w ^ pattern) | lead);
 
-    while ((c = *format++) != 0) {
-        if (c != '%') {
-            *str++ = c;
-            continue;
+        if (zero) {
+            /* Keep only matches below the terminator */
+            match &= (zero & -zero) - 1;
         }
-
-        /* Get width specifier */
-        width = 0;
-        if (*format >= '0' && *format <= '9') {
-            width = *format++ - '0';
+        if (match) {
+            found = (const char*)w + word_last_byte(match);
         }
-
-        switch (*format++) {
-            case 'd':
-            case 'i':
-                print_num(&str, va_arg(args, int), 10, width, ' ');
-                break;
-            case 'x':
-            case 'X':
-                print_num(&str, va_arg(args, unsigned int), 16, width, '0');
-                break;
-            case 'u':
-                print_num(&str, va_arg(args, unsigned int), 10, width, ' ');
-                break;
-            case 's': {
-                const char* s = va_arg(args, const char*);
-                while (*s) {
-                    *str++ = *s++;
-                }
-                break;
-            }
-            case 'c':
-                *str++ = (char)va_arg(args, int);
-                break;
-            case '%':
-                *str++ = '%';
-                break;
-            default:
-                *str++ = '?';
-                break;
+        if (zero) {
+            return (char*)found;
         }
+        lead = 0;
+        w++;
     }
-
-    *str = '\0';
-    return str - str_start;
 }
 
-int sprintf(char* str, const char* format, ...) {
-    va_list args;
-    va_start(args, format);
-    int ret = vsprintf(str, format, args);
-    va_end(args);
-    return ret;
-}
-
-int snprintf(char* str, size_t size, const char* format, ...) {
-    if (size == 0) return 0;
-    
-    va_list args;
-    va_start(args, format);
-    
-    char* temp = (char*)malloc(size);
-    if (!temp) {
-        va_end(args);
-        return -1;
-    }
-    
-    int ret = vsprintf(temp, format, args);
-    va_end(args);
-    
-    if (ret >= 0) {
-        size_t copy_size = ret >= size ? size - 1 : ret;
-        memcpy(str, temp, copy_size);
-        str[copy_size] = '\0';
+char* strdup(const char* s) {
+    size_t len = strlen(s) + 1;
+    char* new = (char*)malloc(len);
+    if (new) {
+        memcpy(new, s, len);
     }
-    
-    free(temp);
-    return ret;
+    return new;
 }
-
-/* vsnprintf implementation */
-int vsnprintf(char* str, size_t size, const char* format, va_list args) {
-    if (size == 0) return 0;
-    
-    char* start = str;
-    char* end = str + size - 1;  /* Leave room for null terminator */
-    
-    while (*format && str < end) {
-        if (*format != '%') {
-            *str++ = *format++;
-            continue;
-        }
-        
-        format++;  /* Skip '%' */
-        
-        /* Handle format specifiers */
-        switch (*format) {
-            case 's': {
-                const char* s = va_arg(args, const char*);
-                while (*s && str < end) {
-                    *str++ = *s++;
-                }
-                break;
-            }
-            case 'd': {
-                int num = va_arg(args, int);
-                char num_buf[32];
-                int len = 0;
-                
-                /* Convert number to string */
-                if (num < 0) {
-                    if (str < end) *str++ = '-';
-                    num = -num;
-                }
-                do {
-                    num_buf[len++] = '0' + (num % 10);
-                    num /= 10;
-                } while (num && len < 31);
-                
-                /* Copy in reverse */
-                while (len > 0 && str < end) {
-                    *str++ = num_buf[--len];
-                }
-                break;
-            }
-            case 'x': {
-                unsigned int num = va_arg(args, unsigned int);
-                char num_buf[32];
-                int len = 0;
-                
-                /* Convert number to hex */
-                do {
-                    int digit = num & 0xF;
-                    num_buf[len++] = digit < 10 ? '0' + digit : 'a' + (digit - 10);
-                    num >>= 4;
-                } while (num && len < 31);
-                
-                /* Copy in reverse */
-                while (len > 0 && str < end) {
-                    *str++ = num_buf[--len];
-                }
-                break;
-            }
-            default:
-                if (str < end) *str++ = *format;
-                break;
-        }
-        format++;
-    }
-    
-    *str = '\0';  /* Null terminate */
-    return str - start;
-} 
\ No newline at end of file
@@ -0,0 +1,93 @@
+/**
+ * SIMD Memory Kernels Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ *
+ * Built with SSE2 enabled (see SIMD_CFLAGS in the Makefile); every vector
+ * instruction must stay between kernel_fpu_begin() and kernel_fpu_end().
+ */
+
+#include "string_simd.h"
+#include "fpu.h"
+#include <stdint.h>
+#include <string.h>
+
+typedef long long vec128_t __attribute__((vector_size(16)));
+typedef long long vec128u_t __attribute__((vector_size(16), aligned(1)));
+
+/* Below this the section overhead outweighs the wider stores */
+#define SIMD_MIN_BYTES  256
+
+void* memcpy_sse2(void* dest, const void* src, size_t n) {
+    if (n < SIMD_MIN_BYTES || !fpu_available()) {
+        return memcpy(dest, src, n);
+    }
+
+    uint8_t* d = (uint8_t*)dest;
+    const uint8_t* s = (const uint8_t*)src;
+
+    /* Align the destination so every vector store is a full aligned line */
+    size_t head = (size_t)(-(uintptr_t)d & 15);
+    memcpy(d, s, head);
+    d += head;
+    s += head;
+    n -= head;
+
+    kernel_fpu_begin();
+    while (n >= 64) {
+        vec128_t a = *(const vec128u_t*)(s + 0);
+        vec128_t b = *(const vec128u_t*)(s + 16);
+        vec128_t c = *(const vec128u_t*)(s + 32);
+        vec128_t e = *(const vec128u_t*)(s + 48);
+        *(vec128_t*)(d + 0) = a;
+        *(vec128_t*)(d + 16) = b;
+        *(vec128_t*)(d + 32) = c;
+        *(vec128_t*)(d + 48) = e;
+        d += 64;
+        s += 64;
+        n -= 64;
+    }
+    while (n >= 16) {
+        *(vec128_t*)d = *(const vec128u_t*)s;
+        d += 16;
+        s += 16;
+        n -= 16;
+    }
+    kernel_fpu_end();
+
+    memcpy(d, s, n);
+    return dest;
+}
+
+void* memset_sse2(void* s, int c, size_t n) {
+    if (n < SIMD_MIN_BYTES || !fpu_available()) {
+        return memset(s, c, n);
+    }
+
+    uint8_t* d = (uint8_t*)s;
+    size_t head = (size_t)(-(uintptr_t)d & 15);
+    memset(d, c, head);
+    d += head;
+    n -= head;
+
+    kernel_fpu_begin();
+    long long fill = (long long)(0x0101010101010101ULL * (uint8_t)c);
+    vec128_t v = { fill, fill };
+    while (n >= 64) {
+        *(vec128_t*)(d + 0) = v;
+        *(vec128_t*)(d + 16) = v;
+        *(vec128_t*)(d + 32) = v;
+        *(vec128_t*)(d + 48) = v;
+        d += 64;
+        n -= 64;
+    }
+    while (n >= 16) {
+        *(vec128_t*)d = v;
+        d += 16;
+        n -= 16;
+    }
+    kernel_fpu_end();
+
+    memset(d, c, n);
+    return s;
+}
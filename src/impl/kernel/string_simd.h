@@ -0,0 +1,15 @@
+/**
+ * SIMD Memory Kernels
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stddef.h>
+
+/*
+ * SSE2 bulk copy/fill. Both open their own FPU section and fall back to
+ * the scalar routines for short buffers or when SIMD is unavailable.
+ */
+void* memcpy_sse2(void* dest, const void* src, size_t n);
+void* memset_sse2(void* s, int c, size_t n);
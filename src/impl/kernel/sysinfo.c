@@ -6,6 +6,7 @@
 
 #include "sysinfo.h"
 #include "asm_utils.h"
+#include "ktime.h"
 #include "../../intf/print.h"
 #include "../drivers/serial/serial.h"
 #include <string.h>
@@ -31,8 +32,11 @@ void sysinfo_detect_cpu(struct CPUInfo* cpu) {
           (uint32_t*)&cpu->vendor[8], (uint32_t*)&cpu->vendor[4]);
     cpu->vendor[12] = '\0';
 
+    /* Highest extended leaf */
+    cpuid(0x80000000, &cpu->max_extended, &ebx, &ecx, &edx);
+
     /* Get brand string */
-    if (cpu->max_cpuid >= 0x80000004) {
+    if (cpu->max_extended >= 0x80000004) {
         for (int i = 0; i < 3; i++) {
             cpuid(0x80000002 + i, (uint32_t*)&cpu->brand[i * 16],
                   (uint32_t*)&cpu->brand[i * 16 + 4],
@@ -59,6 +63,17 @@ void sysinfo_detect_cpu(struct CPUInfo* cpu) {
     if (ecx & (1 << 0)) cpu->features |= CPU_FEATURE_SSE3;
     if (ecx & (1 << 28)) cpu->features |= CPU_FEATURE_AVX;
     if (ecx & (1 << 5)) cpu->features |= CPU_FEATURE_VMX;
+    if (edx & (1 << 24)) cpu->features |= CPU_FEATURE_FXSR;
+    if (ecx & (1 << 26)) cpu->features |= CPU_FEATURE_XSAVE;
+    if (ecx & (1 << 20)) cpu->features |= CPU_FEATURE_SSE42;
+    if (edx & (1 << 9)) cpu->features |= CPU_FEATURE_APIC;
+    if (ecx & (1 << 21)) cpu->features |= CPU_FEATURE_X2APIC;
+
+    /* Structured extended features */
+    if (cpu->max_cpuid >= 7) {
+        asm_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx);
+        if (ebx & (1 << 9)) cpu->features |= CPU_FEATURE_ERMS;
+    }
 
     /* Get core and thread count */
     cpuid(1, &eax, &ebx, &ecx, &edx);
@@ -69,8 +84,14 @@ void sysinfo_detect_cpu(struct CPUInfo* cpu) {
     cpuid(0x80000006, &eax, &ebx, &ecx, &edx);
     cpu->cache_size = (ecx >> 16) & 0xFFFF;  /* L2 cache size in KB */
 
-    /* Estimate clock speed (this is just a rough estimate) */
-    cpu->clock_speed = 1000;  /* Placeholder: 1GHz */
+    /* TSC keeps a constant rate through P/C-state changes */
+    if (cpu->max_extended >= 0x80000007) {
+        cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+        if (edx & (1 << 8)) cpu->features |= CPU_FEATURE_INVARIANT_TSC;
+    }
+
+    /* Nominal clock from the calibrated TSC (0 if calibration failed) */
+    cpu->clock_speed = (uint32_t)(ktime_tsc_hz() / 1000000);
 }
 
 void sysinfo_detect_memory(struct MemoryInfo* mem) {
@@ -183,4 +204,12 @@ void sysinfo_print_all(void) {
     print_str(str);
 
     print_str("\n=========================\n");
-} 
\ No newline at end of file
+}
+
+const struct SystemInfo* sysinfo_get(void) {
+    return &sys_info;
+}
+
+int sysinfo_has_feature(uint64_t feature) {
+    return (sys_info.cpu.features & feature) == feature;
+}
@@ -15,6 +15,13 @@
 #define CPU_FEATURE_SSE3   (1 << 4)
 #define CPU_FEATURE_AVX    (1 << 5)
 #define CPU_FEATURE_VMX    (1 << 6)
+#define CPU_FEATURE_FXSR   (1 << 7)
+#define CPU_FEATURE_XSAVE  (1 << 8)
+#define CPU_FEATURE_SSE42  (1 << 9)
+#define CPU_FEATURE_ERMS   (1 << 10)
+#define CPU_FEATURE_INVARIANT_TSC (1 << 11)
+#define CPU_FEATURE_APIC   (1 << 12)
+#define CPU_FEATURE_X2APIC (1 << 13)
 
 /* BIOS Information */
 struct BIOSInfo {
@@ -91,4 +98,6 @@ void sysinfo_detect_memory(struct MemoryInfo* mem); /* Detect memory information
 void sysinfo_detect_bios(struct BIOSInfo* bios);  /* Detect BIOS information */
 void sysinfo_detect_board(struct SystemBoardInfo* board); /* Detect system board info */
 void sysinfo_get_boot_config(struct BootConfig* config);  /* Get boot configuration */
-void sysinfo_print_all(void);                     /* Print all system information */ 
\ No newline at end of file
+void sysinfo_print_all(void);                     /* Print all system information */
+const struct SystemInfo* sysinfo_get(void);       /* Detected system information */
+int sysinfo_has_feature(uint64_t feature);        /* Test CPU_FEATURE_* bits */ 
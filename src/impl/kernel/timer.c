@@ -0,0 +1,293 @@
+/**
+ * Kernel Timers Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "timer.h"
+#include "clockevent.h"
+#include "kstat.h"
+#include "asm_utils.h"
+
+static struct ListNode wheel[TIMER_BUCKETS];
+static uint64_t occupied[TIMER_BUCKETS / 64];   /* One bit per non-empty bucket */
+static uint64_t wheel_tick;                     /* Next tick to expire */
+static uint64_t nr_pending = 0;
+static int wheel_ready = 0;
+
+DEFINE_KSTAT_GAUGE(stat_pending, "timer.pending");
+DEFINE_KSTAT_COUNTER(stat_fired, "timer.fired");
+DEFINE_KSTAT_COUNTER(stat_batches, "timer.batches");
+DEFINE_KSTAT_COUNTER(stat_cascaded, "timer.cascaded");
+
+static inline uint32_t level_first(int level) {
+    return level ? TIMER_ROOT_SIZE + (level - 1) * TIMER_LEVEL_SIZE : 0;
+}
+
+static inline int level_shift(int level) {
+    return level ? TIMER_ROOT_BITS + (level - 1) * TIMER_LEVEL_BITS : 0;
+}
+
+static void wheel_setup(void) {
+    for (int i = 0; i < TIMER_BUCKETS; i++) {
+        list_init(&wheel[i]);
+    }
+    wheel_tick = tick_get_ticks() + 1;
+    wheel_ready = 1;
+}
+
+/* First non-empty bucket in [from, to), or -1 */
+static int bucket_find(uint32_t from, uint32_t to) {
+    while (from < to) {
+        uint64_t word = occupied[from / 64] >> (from % 64);
+        if (word) {
+            uint32_t bucket = from + (uint32_t)__builtin_ctzll(word);
+            return bucket < to ? (int)bucket : -1;
+        }
+        from = (from | 63) + 1;
+    }
+    return -1;
+}
+
+/* Distance from `cur` to the first non-empty bucket of a level, wrapping */
+static int level_find(int level, uint32_t cur) {
+    uint32_t first = level_first(level);
+    uint32_t size = level ? TIMER_LEVEL_SIZE : TIMER_ROOT_SIZE;
+    int bucket = bucket_find(first + cur, first + size);
+
+    if (bucket >= 0) {
+        return bucket - (int)(first + cur);
+    }
+    bucket = bucket_find(first, first + cur);
+    return bucket >= 0 ? bucket - (int)first + (int)(size - cur) : -1;
+}
+
+static void enqueue(struct Timer* timer) {
+    uint64_t expires = timer->expires;
+    uint64_t delta = expires - wheel_tick;
+    uint32_t bucket;
+
+    if ((int64_t)delta < 0) {
+        /* Already due: expire on the next tick processed */
+        bucket = wheel_tick & (TIMER_ROOT_SIZE - 1);
+    } else if (delta < TIMER_ROOT_SIZE) {
+        bucket = expires & (TIMER_ROOT_SIZE - 1);
+    } else {
+        int level = 1;
+        while (level < TIMER_LEVELS - 1 &&
+               delta >= 1ull << (level_shift(level) + TIMER_LEVEL_BITS)) {
+            level++;
+        }
+        if (delta >= 1ull << (level_shift(level) + TIMER_LEVEL_BITS)) {
+            /* Beyond the wheel; it is re-queued each time the top level wraps */
+            expires = wheel_tick + (1ull << (level_shift(level) + TIMER_LEVEL_BITS)) - 1;
+        }
+        bucket = level_first(level) +
+                 ((expires >> level_shift(level)) & (TIMER_LEVEL_SIZE - 1));
+    }
+
+    timer->bucket = (uint16_t)bucket;
+    list_add_tail(&timer->entry, &wheel[bucket]);
+    occupied[bucket / 64] |= 1ull << (bucket % 64);
+}
+
+static void detach(struct Timer* timer) {
+    list_del(&timer->entry);
+    if (list_empty(&wheel[timer->bucket])) {
+        occupied[timer->bucket / 64] &= ~(1ull << (timer->bucket % 64));
+    }
+    timer->pending = 0;
+    nr_pending--;
+    kstat_sub(stat_pending, 1);
+}
+
+/* Empty a bucket into `out` */
+static void take_bucket(uint32_t bucket, struct ListNode* out) {
+    list_splice_tail_init(&wheel[bucket], out);
+    occupied[bucket / 64] &= ~(1ull << (bucket % 64));
+}
+
+static void cascade(int level) {
+    struct ListNode moving = LIST_HEAD_INIT(moving);
+    uint32_t index = (wheel_tick >> level_shift(level)) & (TIMER_LEVEL_SIZE - 1);
+
+    take_bucket(level_first(level) + index, &moving);
+    while (!list_empty(&moving)) {
+        struct Timer* timer = list_entry(moving.next, struct Timer, entry);
+        list_del(&timer->entry);
+        enqueue(timer);
+        kstat_inc(stat_cascaded);
+    }
+
+    /* A level wraps only when the one below it has wrapped as well */
+    if (index == 0 && level < TIMER_LEVELS - 1) {
+        cascade(level + 1);
+    }
+}
+
+/*
+ * Round up to the coarsest tick boundary within the slack, so timers
+ * armed for nearby ticks end up in one bucket and expire together.
+ */
+static uint64_t apply_slack(const struct Timer* timer, uint64_t expires) {
+    uint64_t slack;
+
+    if (timer->slack == TIMER_SLACK_AUTO) {
+        slack = (int64_t)(expires - wheel_tick) > 0 ? (expires - wheel_tick) / 256 : 0;
+    } else {
+        slack = (uint64_t)timer->slack;
+    }
+    if (slack == 0) {
+        return expires;
+    }
+
+    uint64_t limit = expires + slack;
+    uint64_t mask = (1ull << (63 - __builtin_clzll(expires ^ limit))) - 1;
+    return limit & ~mask;
+}
+
+void timer_init(struct Timer* timer, timer_fn_t function, void* data) {
+    list_init(&timer->entry);
+    timer->expires = 0;
+    timer->slack = TIMER_SLACK_AUTO;
+    timer->bucket = 0;
+    timer->pending = 0;
+    timer->function = function;
+    timer->data = data;
+}
+
+int timer_mod(struct Timer* timer, uint64_t expires) {
+    uint64_t flags = asm_irq_save();
+    int was_pending = timer->pending;
+
+    if (!wheel_ready) {
+        wheel_setup();
+    }
+    expires = apply_slack(timer, expires);
+
+    if (was_pending) {
+        if (timer->expires == expires) {
+            asm_irq_restore(flags);
+            return 1;
+        }
+        detach(timer);
+    }
+
+    timer->expires = expires;
+    timer->pending = 1;
+    nr_pending++;
+    kstat_add(stat_pending, 1);
+    enqueue(timer);
+
+    asm_irq_restore(flags);
+    return was_pending;
+}
+
+void timer_add(struct Timer* timer) {
+    timer_mod(timer, timer->expires);
+}
+
+int timer_del(struct Timer* timer) {
+    uint64_t flags = asm_irq_save();
+    int was_pending = timer->pending;
+
+    if (was_pending) {
+        detach(timer);
+    }
+    asm_irq_restore(flags);
+    return was_pending;
+}
+
+void timer_set_slack(struct Timer* timer, int32_t ticks) {
+    timer->slack = ticks < 0 ? TIMER_SLACK_AUTO : ticks;
+}
+
+uint64_t timer_ms_to_ticks(uint32_t ms) {
+    uint32_t hz = tick_get_hz();
+    return ((uint64_t)ms * hz + 999) / 1000;
+}
+
+uint64_t timer_next_expiry(void) {
+    uint64_t flags = asm_irq_save();
+    uint64_t next = TIMER_NEVER;
+
+    if (!wheel_ready || nr_pending == 0) {
+        asm_irq_restore(flags);
+        return next;
+    }
+
+    int distance = level_find(0, wheel_tick & (TIMER_ROOT_SIZE - 1));
+    if (distance >= 0) {
+        next = wheel_tick + (uint64_t)distance;
+    }
+
+    for (int level = 1; level < TIMER_LEVELS; level++) {
+        int shift = level_shift(level);
+        uint64_t block = wheel_tick >> shift;
+        uint32_t index = block & (TIMER_LEVEL_SIZE - 1);
+
+        if (wheel_tick & ((1ull << shift) - 1)) {
+            /* The current bucket was cascaded on entry to this block; it is a full turn away */
+            distance = level_find(level, (index + 1) & (TIMER_LEVEL_SIZE - 1));
+            distance = distance < 0 ? distance : distance + 1;
+        } else {
+            distance = level_find(level, index);
+        }
+        if (distance < 0) {
+            continue;
+        }
+        uint64_t cascade_at = (block + (uint64_t)distance) << shift;
+        if (cascade_at < next) {
+            next = cascade_at;
+        }
+    }
+
+    asm_irq_restore(flags);
+    return next;
+}
+
+/* Interrupts are off */
+void timer_run(uint64_t now) {
+    struct ListNode expired = LIST_HEAD_INIT(expired);
+
+    if (!wheel_ready) {
+        wheel_setup();
+    }
+
+    while (wheel_tick <= now) {
+        /* Nothing armed: skip the idle stretch in one step */
+        if (nr_pending == 0) {
+            wheel_tick = now + 1;
+            break;
+        }
+
+        uint32_t index = wheel_tick & (TIMER_ROOT_SIZE - 1);
+        if (index == 0) {
+            cascade(1);
+        }
+        wheel_tick++;
+
+        if (list_empty(&wheel[index])) {
+            continue;
+        }
+
+        /* The whole bucket expires as one batch */
+        take_bucket(index, &expired);
+        kstat_inc(stat_batches);
+
+        /* Callbacks may cancel timers still on the list, so take them one at a time */
+        while (!list_empty(&expired)) {
+            struct Timer* timer = list_entry(expired.next, struct Timer, entry);
+            detach(timer);
+            kstat_inc(stat_fired);
+            timer->function(timer->data);
+        }
+    }
+}
+
+void timer_get_stats(struct TimerStats* stats) {
+    stats->pending = nr_pending;
+    stats->fired = kstat_read(&stat_fired, 0);
+    stats->batches = kstat_read(&stat_batches, 0);
+    stats->cascaded = kstat_read(&stat_cascaded, 0);
+}
@@ -0,0 +1,89 @@
+/**
+ * Kernel Timers
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+#include "list.h"
+
+/*
+ * Hierarchical timing wheel: a 256-bucket root wheel indexed by the low
+ * tick bits, then four 64-bucket levels covering 2^32 ticks. Inserting
+ * and cancelling are O(1); a level's bucket is redistributed (cascaded)
+ * into the level below once the lower wheels have wrapped around to it.
+ */
+#define TIMER_ROOT_BITS     8
+#define TIMER_LEVEL_BITS    6
+#define TIMER_LEVELS        5       /* Root wheel plus cascading levels */
+#define TIMER_ROOT_SIZE     (1 << TIMER_ROOT_BITS)
+#define TIMER_LEVEL_SIZE    (1 << TIMER_LEVEL_BITS)
+#define TIMER_BUCKETS       (TIMER_ROOT_SIZE + (TIMER_LEVELS - 1) * TIMER_LEVEL_SIZE)
+
+#define TIMER_NEVER         UINT64_MAX
+
+/* Slack of a fresh timer: 1/256 of the delay, chosen when it is armed */
+#define TIMER_SLACK_AUTO    (-1)
+
+typedef void (*timer_fn_t)(void* data);
+
+/*
+ * Callbacks run from the tick interrupt with interrupts off and may re-arm
+ * or cancel any timer, including their own.
+ */
+struct Timer {
+    struct ListNode entry;
+    uint64_t expires;           /* Absolute tick, after slack is applied */
+    int32_t slack;              /* Ticks the expiry may be deferred, or TIMER_SLACK_AUTO */
+    uint16_t bucket;            /* Wheel bucket while pending */
+    uint8_t pending;
+    timer_fn_t function;
+    void* data;
+};
+
+#define TIMER_INIT(name, fn, arg) \
+    { LIST_HEAD_INIT((name).entry), 0, TIMER_SLACK_AUTO, 0, 0, (fn), (arg) }
+
+struct TimerStats {
+    uint64_t pending;           /* Timers currently armed */
+    uint64_t fired;
+    uint64_t batches;           /* Buckets expired; fired / batches is the coalescing */
+    uint64_t cascaded;          /* Timers moved down a level */
+};
+
+void timer_init(struct Timer* timer, timer_fn_t function, void* data);
+
+/*
+ * Arm to fire at the absolute tick `expires`, or up to `slack` ticks later
+ * when that lets it share a bucket with other timers. Returns 1 if the
+ * timer was already pending, 0 otherwise.
+ */
+int timer_mod(struct Timer* timer, uint64_t expires);
+
+/* Arm using timer->expires; the timer must not be pending */
+void timer_add(struct Timer* timer);
+
+/* Cancel; returns 1 if the timer was pending */
+int timer_del(struct Timer* timer);
+
+static inline int timer_pending(const struct Timer* timer) {
+    return timer->pending;
+}
+
+/* Takes effect the next time the timer is armed */
+void timer_set_slack(struct Timer* timer, int32_t ticks);
+
+/* Smallest number of ticks covering at least `ms` milliseconds */
+uint64_t timer_ms_to_ticks(uint32_t ms);
+
+/*
+ * Earliest tick at which the wheel has work, or TIMER_NEVER. A bucket on
+ * an upper level reports its cascade point, which may precede its timers.
+ */
+uint64_t timer_next_expiry(void);
+
+/* Expire every timer due by tick `now`; called from the tick layer */
+void timer_run(uint64_t now);
+
+void timer_get_stats(struct TimerStats* stats);
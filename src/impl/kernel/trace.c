@@ -0,0 +1,89 @@
+/**
+ * Binary Event Trace Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "trace.h"
+#include "asm_utils.h"
+#include "ktime.h"
+#include "../drivers/serial/serial.h"
+
+/* Marker, id, count, then up to 10 bytes per LEB128 value */
+#define TRACE_FRAME_MAX     (4 + 10 * (TRACE_MAX_ARGS + 1))
+
+/* Bounds of the interned format strings (see linker.ld) */
+extern const char __trace_fmt_start[];
+extern const char __trace_fmt_end[];
+
+int trace_enabled = 0;
+
+static uint64_t last_tsc = 0;
+static struct TraceStats stats;
+
+static size_t put_uleb128(uint8_t* out, uint64_t value) {
+    size_t n = 0;
+    do {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        out[n++] = byte | (value ? 0x80 : 0);
+    } while (value);
+    return n;
+}
+
+/* Callers hold interrupts off so frames are never interleaved */
+static void trace_send(uint16_t id, const uint64_t* args, int nargs, uint64_t tsc) {
+    uint8_t frame[TRACE_FRAME_MAX];
+    size_t len = 0;
+
+    frame[len++] = TRACE_FRAME_MARKER;
+    frame[len++] = (uint8_t)id;
+    frame[len++] = (uint8_t)(id >> 8);
+    frame[len++] = (uint8_t)nargs;
+    len += put_uleb128(frame + len, tsc - last_tsc);
+    for (int i = 0; i < nargs; i++) {
+        len += put_uleb128(frame + len, args[i]);
+    }
+
+    /* A partial frame would desynchronise the decoder; drop it whole */
+    if (serial_tx_room(COM1_PORT) < len) {
+        stats.dropped++;
+        return;
+    }
+    serial_write_bytes(COM1_PORT, frame, len);
+    last_tsc = tsc;
+    stats.emitted++;
+}
+
+void trace_enable(void) {
+    uint64_t flags = asm_irq_save();
+    uint64_t tsc = asm_rdtsc();
+    uint64_t sync[2] = { tsc, ktime_tsc_hz() };
+
+    /* Deltas restart from the absolute timestamp in the sync frame */
+    last_tsc = tsc;
+    trace_send(TRACE_ID_SYNC, sync, 2, tsc);
+    trace_enabled = 1;
+    asm_irq_restore(flags);
+}
+
+void trace_disable(void) {
+    trace_enabled = 0;
+}
+
+void trace_emit(const char* format, const uint64_t* args, int nargs) {
+    if (!trace_enabled) {
+        return;
+    }
+
+    uint16_t id = (uint16_t)(format - __trace_fmt_start);
+    uint64_t flags = asm_irq_save();
+    trace_send(id, args, nargs, asm_rdtsc());
+    asm_irq_restore(flags);
+}
+
+void trace_get_stats(struct TraceStats* out) {
+    uint64_t flags = asm_irq_save();
+    *out = stats;
+    asm_irq_restore(flags);
+}
@@ -0,0 +1,56 @@
+/**
+ * Binary Event Trace
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Frame layout on COM1, interleaved with ordinary text output:
+ *
+ *   0xFF  id:u16le  nargs:u8  tsc_delta:uleb128  args:uleb128 * nargs
+ *
+ * `id` is the offset of the format string inside the kernel's .trace_fmt
+ * section; tools/trace_decode.py reads the strings back out of the ELF.
+ * Text output is ASCII, so 0xFF always starts a frame.
+ */
+#define TRACE_FRAME_MARKER  0xFF
+#define TRACE_MAX_ARGS      6
+
+/* Reserved id: args are the absolute TSC and the TSC rate in Hz (0 if unknown) */
+#define TRACE_ID_SYNC       0xFFFF
+
+struct TraceStats {
+    uint64_t emitted;
+    uint64_t dropped;       /* No room in the serial TX ring for the whole frame */
+};
+
+/* Start emitting frames, preceded by a sync frame */
+void trace_enable(void);
+void trace_disable(void);
+
+void trace_emit(const char* format, const uint64_t* args, int nargs);
+void trace_get_stats(struct TraceStats* stats);
+
+extern int trace_enabled;
+
+/*
+ * Records an event. The format string never leaves the image; only its
+ * id and the integer arguments go over the wire. Arguments are widened
+ * to 64 bits; %s is not supported.
+ */
+#define trace(format, ...) \
+    do { \
+        if (trace_enabled) { \
+            static const char trace_fmt_[] \
+                __attribute__((section(".trace_fmt"), used, aligned(1))) = format; \
+            const uint64_t trace_args_[] = { 0, ##__VA_ARGS__ }; \
+            _Static_assert(sizeof(trace_args_) / sizeof(uint64_t) <= TRACE_MAX_ARGS + 1, \
+                           "too many trace arguments"); \
+            trace_emit(trace_fmt_, trace_args_ + 1, \
+                       (int)(sizeof(trace_args_) / sizeof(uint64_t)) - 1); \
+        } \
+    } while (0)
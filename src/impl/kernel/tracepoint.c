@@ -0,0 +1,160 @@
+/**
+ * Static Tracepoints Implementation
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "tracepoint.h"
+#include "percpu.h"
+#include "asm_utils.h"
+#include "ktime.h"
+#include "klog.h"
+#include <string.h>
+#include "../drivers/serial/serial.h"
+
+/* Provided by the linker script */
+extern struct Tracepoint* const __tracepoints_start[];
+extern struct Tracepoint* const __tracepoints_end[];
+
+/* Flight recorder: a full ring overwrites its oldest record */
+struct TracepointRing {
+    struct TracepointRecord records[TRACEPOINT_RING_SIZE];
+    uint64_t head;          /* Records ever written */
+    uint64_t overwritten;
+};
+
+static DEFINE_PER_CPU(struct TracepointRing, tp_ring);
+
+/* Reached only through a patched jump, so it stays out of the hot path */
+__attribute__((noinline))
+void tracepoint_record(struct Tracepoint* tp, uint64_t a0, uint64_t a1) {
+    uint64_t flags = asm_irq_save();
+    struct TracepointRing* ring = &this_cpu(tp_ring);
+    struct TracepointRecord* rec = &ring->records[ring->head & (TRACEPOINT_RING_SIZE - 1)];
+
+    if (ring->head >= TRACEPOINT_RING_SIZE) {
+        ring->overwritten++;
+    }
+    ring->head++;
+
+    rec->tsc = asm_rdtsc();
+    rec->id = tp->id;
+    rec->cpu = (uint32_t)cpu_id();
+    rec->args[0] = a0;
+    rec->args[1] = a1;
+    tp->hits++;
+
+    asm_irq_restore(flags);
+}
+
+size_t tracepoint_count(void) {
+    return (size_t)(__tracepoints_end - __tracepoints_start);
+}
+
+struct Tracepoint* tracepoint_get(size_t id) {
+    return id < tracepoint_count() ? __tracepoints_start[id] : NULL;
+}
+
+struct Tracepoint* tracepoint_find(const char* name) {
+    for (struct Tracepoint* const* p = __tracepoints_start; p < __tracepoints_end; p++) {
+        if (strcmp((*p)->name, name) == 0) {
+            return *p;
+        }
+    }
+    return NULL;
+}
+
+int tracepoint_set(const char* name, int enable) {
+    int all = strcmp(name, "all") == 0;
+    int changed = 0;
+    int matched = 0;
+
+    for (struct Tracepoint* const* p = __tracepoints_start; p < __tracepoints_end; p++) {
+        struct Tracepoint* tp = *p;
+        if (!all && strcmp(tp->name, name) != 0) {
+            continue;
+        }
+        matched++;
+        if (static_key_enabled(&tp->key) != enable) {
+            if (enable) {
+                /* Looked up once here so recording needs no table scan */
+                tp->id = (uint32_t)(p - __tracepoints_start);
+                static_key_enable(&tp->key);
+            } else {
+                static_key_disable(&tp->key);
+            }
+            changed++;
+        }
+    }
+
+    if (!matched) {
+        return -1;
+    }
+    if (changed) {
+        klog_info("[TP] %s %s", enable ? "Enabled" : "Disabled", name);
+    }
+    return changed;
+}
+
+size_t tracepoint_snapshot(int cpu, struct TracepointRecord* out, size_t max) {
+    if (cpu < 0 || cpu >= MAX_CPUS) {
+        return 0;
+    }
+
+    uint64_t flags = asm_irq_save();
+    struct TracepointRing* ring = &per_cpu(tp_ring, cpu);
+    uint64_t count = ring->head < TRACEPOINT_RING_SIZE ? ring->head : TRACEPOINT_RING_SIZE;
+    if (count > max) {
+        count = max;
+    }
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t seq = ring->head - count + i;
+        out[i] = ring->records[seq & (TRACEPOINT_RING_SIZE - 1)];
+    }
+    asm_irq_restore(flags);
+    return (size_t)count;
+}
+
+void tracepoint_clear(void) {
+    uint64_t flags = asm_irq_save();
+    for (int i = 0; i < MAX_CPUS; i++) {
+        per_cpu(tp_ring, i).head = 0;
+        per_cpu(tp_ring, i).overwritten = 0;
+    }
+    asm_irq_restore(flags);
+}
+
+/* Records written meanwhile may overwrite the oldest lines; that is fine */
+void tracepoint_dump(void) {
+    for (int i = 0; i < MAX_CPUS; i++) {
+        struct TracepointRing* ring = &per_cpu(tp_ring, i);
+        uint64_t head = ring->head;
+        uint64_t first = head > TRACEPOINT_RING_SIZE ? head - TRACEPOINT_RING_SIZE : 0;
+
+        serial_wait_room(COM1_PORT, 128);
+        serial_printf(COM1_PORT, "# cpu %d: %llu records, %llu overwritten\n", i,
+                      (unsigned long long)head, (unsigned long long)ring->overwritten);
+
+        for (uint64_t seq = first; seq < head; seq++) {
+            const struct TracepointRecord* rec = &ring->records[seq & (TRACEPOINT_RING_SIZE - 1)];
+            const struct Tracepoint* tp = tracepoint_get(rec->id);
+
+            uint64_t ns = ktime_tsc_to_ns(rec->tsc);
+
+            serial_wait_room(COM1_PORT, 160);
+            serial_printf(COM1_PORT, "%6llu.%09llu %-16s ", (unsigned long long)(ns / NSEC_PER_SEC),
+                          (unsigned long long)(ns % NSEC_PER_SEC), tp ? tp->name : "?");
+            serial_printf(COM1_PORT, tp ? tp->format : "%llx %llx",
+                          (unsigned long long)rec->args[0], (unsigned long long)rec->args[1]);
+            serial_write_string(COM1_PORT, "\n");
+        }
+    }
+}
+
+void tracepoint_get_stats(struct TracepointStats* stats) {
+    memset(stats, 0, sizeof(*stats));
+    for (int i = 0; i < MAX_CPUS; i++) {
+        stats->recorded += per_cpu(tp_ring, i).head;
+        stats->overwritten += per_cpu(tp_ring, i).overwritten;
+    }
+}
@@ -0,0 +1,75 @@
+/**
+ * Static Tracepoints
+ * NansOS Kernel System
+ * Copyright (c) 2025 NansStudios
+ */
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "static_key.h"
+
+#define TRACEPOINT_RING_SIZE    1024    /* Records per CPU, power of two */
+
+/* A named instrumentation point; off until tracepoint_set() turns it on */
+struct Tracepoint {
+    const char* name;
+    const char* format;     /* printf format for the two arguments */
+    struct StaticKey key;
+    uint64_t hits;
+    uint32_t id;            /* Index in the tracepoint table, set when enabled */
+};
+
+/* Fixed-size record; the per-CPU ring keeps the most recent ones */
+struct TracepointRecord {
+    uint64_t tsc;
+    uint32_t id;            /* Index in the tracepoint table */
+    uint32_t cpu;
+    uint64_t args[2];
+};
+
+struct TracepointStats {
+    uint64_t recorded;
+    uint64_t overwritten;   /* Older records replaced by newer ones */
+};
+
+/*
+ * Defines tracepoint `name` and registers it in the .tracepoints section
+ * so the monitor can list it. `format` describes the two arguments.
+ */
+#define DEFINE_TRACEPOINT(name, fmt)                                        \
+    static struct Tracepoint __tp_##name = {                                \
+        #name, fmt, STATIC_KEY_INIT_FALSE, 0, UINT32_MAX                    \
+    };                                                                      \
+    static struct Tracepoint* const __tp_ptr_##name                         \
+        __attribute__((section(".tracepoints"), used, aligned(8))) = &__tp_##name
+
+/*
+ * Records (a0, a1) when `name` is enabled. Disabled, this is a single
+ * 5-byte NOP and the argument code sits out of line.
+ */
+#define tracepoint(name, a0, a1)                                            \
+    do {                                                                    \
+        if (__builtin_expect(static_key_false(&__tp_##name.key), 0)) {      \
+            tracepoint_record(&__tp_##name, (uint64_t)(a0), (uint64_t)(a1)); \
+        }                                                                   \
+    } while (0)
+
+void tracepoint_record(struct Tracepoint* tp, uint64_t a0, uint64_t a1);
+
+/* Registry */
+size_t tracepoint_count(void);
+struct Tracepoint* tracepoint_get(size_t id);
+struct Tracepoint* tracepoint_find(const char* name);
+
+/* Enable or disable by name ("all" matches every tracepoint); returns the number changed or -1 */
+int tracepoint_set(const char* name, int enable);
+
+/* Copy up to `max` of this CPU's most recent records, oldest first */
+size_t tracepoint_snapshot(int cpu, struct TracepointRecord* out, size_t max);
+void tracepoint_clear(void);
+
+/* Write the rings to COM1 as text, oldest record first */
+void tracepoint_dump(void);
+
+void tracepoint_get_stats(struct TracepointStats* stats);
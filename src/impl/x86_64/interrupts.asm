@@ -0,0 +1,78 @@
+;------------------------------------------------------------------------------
+; NansOS Interrupt Entry Stubs
+; Copyright (c) 2025 NansStudios
+;
+; One stub per IDT vector. Each pushes a zero where the CPU supplies no error
+; code, then its vector number, and joins the common path, which saves the
+; general purpose registers so every interrupt reaches irq_dispatch() with the
+; same struct InterruptFrame (see idt.h) and returns with iretq.
+;------------------------------------------------------------------------------
+
+global isr_stub_table
+extern irq_dispatch
+
+section .text
+bits 64
+
+; Only #DF, #TS, #NP, #SS, #GP, #PF, #AC, #CP, #VC and #SX push an error code
+%assign vector 0
+%rep 256
+align 16
+isr_stub_%[vector]:
+%if !(vector == 8 || (vector >= 10 && vector <= 14) || vector == 17 || vector == 21 || vector == 29 || vector == 30)
+    push qword 0
+%endif
+    push qword vector
+    jmp isr_common
+%assign vector vector + 1
+%endrep
+
+; The CPU aligned RSP to 16 before its 5-qword frame; error code, vector and
+; 15 registers bring it back to 16-byte alignment for the call.
+isr_common:
+    push r15
+    push r14
+    push r13
+    push r12
+    push r11
+    push r10
+    push r9
+    push r8
+    push rbp
+    push rdi
+    push rsi
+    push rdx
+    push rcx
+    push rbx
+    push rax
+
+    cld
+    mov rdi, rsp
+    call irq_dispatch
+
+    pop rax
+    pop rbx
+    pop rcx
+    pop rdx
+    pop rsi
+    pop rdi
+    pop rbp
+    pop r8
+    pop r9
+    pop r10
+    pop r11
+    pop r12
+    pop r13
+    pop r14
+    pop r15
+
+    add rsp, 16         ; Vector and error code
+    iretq
+
+section .rodata
+isr_stub_table:
+%assign vector 0
+%rep 256
+    dq isr_stub_%[vector]
+%assign vector vector + 1
+%endrep
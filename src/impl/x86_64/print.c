@@ -1,78 +1,36 @@
 #include "print.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "../drivers/video/console.h"
 
-/* Screen dimensions */
-static const size_t NUM_COLS = 80;
-static const size_t NUM_ROWS = 25;
-
-struct Char {
-    uint8_t character;
-    uint8_t color;
-};
-
-struct Char* buffer = (struct Char*)0xb8000;
-size_t col = 0;
-size_t row = 0;
-uint8_t color = PRINT_COLOR_WHITE | PRINT_COLOR_BLACK << 4;
-
-void clear_row(size_t row) {
-    struct Char empty = {
-        .character = ' ',
-        .color = color
-    };
-
-    for (size_t col = 0; col < NUM_COLS; col++) {
-        buffer[col + NUM_COLS * row] = empty;
-    }
-}
+/* Screen output goes through the text console in drivers/video/console.c */
 
 void print_clear() {
-    for (size_t i = 0; i < NUM_ROWS; i++) {
-        clear_row(i);
-    }
-}
-
-void print_newline() {
-    col = 0;
-
-    if (row < NUM_ROWS - 1) {
-        row++;
-        return;
-    }
-
-    for (size_t row = 1; row < NUM_ROWS; row++) {
-        for (size_t col = 0; col < NUM_COLS; col++) {
-            struct Char character = buffer[col + NUM_COLS * row];
-            buffer[col + NUM_COLS * (row - 1)] = character;
-        }
-    }
-
-    clear_row(NUM_ROWS - 1);
+    console_clear();
 }
 
 void print_char(char character) {
-    if (character == '\n') {
-        print_newline();
-        return;
-    }
-
-    if (col > NUM_COLS) {
-        print_newline();
-    }
-
-    buffer[col + NUM_COLS * row] = (struct Char) {
-        .character = (uint8_t) character,
-        .color = color
-    };
-
-    col++;
+    console_write(&character, 1);
 }
 
 void print_str(const char* str) {
-    for (size_t i = 0; str[i] != '\0'; i++) {
-        print_char(str[i]);
-    }
+    console_write(str, strlen(str));
 }
 
 void print_set_color(uint8_t foreground, uint8_t background) {
-    color = foreground + (background << 4);
+    console_set_color(foreground + (background << 4));
+}
+
+static void print_sink(void* ctx, const char* data, size_t len) {
+    (void)ctx;
+    console_write(data, len);
+}
+
+int print_printf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int ret = format_vprint(print_sink, NULL, format, args);
+    va_end(args);
+    return ret;
 }
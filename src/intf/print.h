@@ -32,4 +32,5 @@ void print_clear(void);
 void print_char(char character);
 void print_str(const char* string);
 void print_set_color(uint8_t foreground, uint8_t background);
+int print_printf(const char* format, ...);
 
@@ -24,5 +24,9 @@ typedef long long ptrdiff_t;
 /* Offset of member in structure */
 #define offsetof(type, member) __builtin_offsetof(type, member)
 
+/* Enclosing structure of an embedded member */
+#define container_of(ptr, type, member) \
+    ((type*)((char*)(ptr) - offsetof(type, member)))
+
 /* Wide character type */
 typedef int wchar_t; 
\ No newline at end of file
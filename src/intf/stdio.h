@@ -8,8 +8,15 @@
 #include <stdarg.h>
 #include <stddef.h>
 
+/* Output sink: receives each formatted chunk, never NUL-terminated */
+typedef void (*format_sink_t)(void* ctx, const char* data, size_t len);
+
+/* Formatting engine; returns the number of characters produced */
+int format_vprint(format_sink_t sink, void* ctx, const char* format, va_list args);
+int format_print(format_sink_t sink, void* ctx, const char* format, ...);
+
 /* Standard I/O functions */
 int sprintf(char* str, const char* format, ...);
 int snprintf(char* str, size_t size, const char* format, ...);
 int vsprintf(char* str, const char* format, va_list args);
-int vsnprintf(char* str, size_t size, const char* format, va_list args);
\ No newline at end of file
+int vsnprintf(char* str, size_t size, const char* format, va_list args);
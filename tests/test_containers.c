@@ -0,0 +1,182 @@
+/**
+ * Intrusive Container Tests
+ * NansOS Test Suite
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "test_framework.h"
+#include "../src/impl/kernel/hashtable.h"
+#include "../src/impl/kernel/rbtree.h"
+#include "../src/impl/kernel/radix_tree.h"
+#include "../src/impl/kernel/list.h"
+
+#define NUM_ITEMS   200
+
+struct Item {
+    uint32_t key;
+    struct HashNode hash_node;
+    struct RBNode rb_node;
+    struct ListNode link;
+};
+
+static struct Item items[NUM_ITEMS];
+
+static int item_match(const struct HashNode* node, const void* key) {
+    return hash_entry(node, struct Item, hash_node)->key == *(const uint32_t*)key;
+}
+
+/* Returns the black height, or -1 if a red-black property is broken */
+static int rb_check(const struct RBNode* node) {
+    if (!node) {
+        return 1;
+    }
+    if (node->color == RB_RED &&
+        ((node->left && node->left->color == RB_RED) ||
+         (node->right && node->right->color == RB_RED))) {
+        return -1;
+    }
+    int left = rb_check(node->left);
+    int right = rb_check(node->right);
+    if (left < 0 || left != right) {
+        return -1;
+    }
+    return left + (node->color == RB_BLACK);
+}
+
+static void rb_insert_item(struct RBRoot* root, struct Item* item) {
+    struct RBNode** link = &root->node;
+    struct RBNode* parent = NULL;
+    while (*link) {
+        parent = *link;
+        link = item->key < rb_entry(parent, struct Item, rb_node)->key ?
+               &parent->left : &parent->right;
+    }
+    rb_link_node(&item->rb_node, parent, link);
+    rb_insert_color(&item->rb_node, root);
+}
+
+/* Colliding hashes survive removal from the middle of a cluster */
+static struct TestResult test_hash_backward_shift(void) {
+    static struct HashSlot slots[512];
+    struct HashTable table;
+    hash_init(&table, slots, 512, item_match);
+
+    for (uint32_t i = 0; i < NUM_ITEMS; i++) {
+        items[i].key = i;
+        /* Every fourth key lands in the same bucket */
+        uint32_t hash = (i % 4 == 0) ? 7 : i * 2654435761u;
+        TEST_ASSERT_EQUAL(0, hash_insert(&table, &items[i].hash_node, hash), "Insert failed");
+    }
+
+    for (uint32_t i = 0; i < NUM_ITEMS; i += 3) {
+        hash_remove(&table, &items[i].hash_node);
+    }
+
+    for (uint32_t i = 0; i < NUM_ITEMS; i++) {
+        struct HashNode* found = hash_find(&table, items[i].hash_node.hash, &i);
+        if (i % 3 == 0) {
+            TEST_ASSERT(found == NULL, "Removed key still found");
+        } else {
+            TEST_ASSERT(found == &items[i].hash_node, "Live key lost after shift");
+        }
+    }
+
+    uint32_t cursor = 0;
+    uint32_t seen = 0;
+    while (hash_next(&table, &cursor)) {
+        seen++;
+    }
+    TEST_ASSERT_EQUAL(table.count, seen, "Iteration count mismatch");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+static struct TestResult test_rbtree_balance(void) {
+    struct RBRoot root = RB_ROOT_INIT;
+
+    /* Pseudo-random insertion order */
+    for (uint32_t i = 0; i < NUM_ITEMS; i++) {
+        items[i].key = (i * 37) % NUM_ITEMS;
+        rb_insert_item(&root, &items[i]);
+    }
+    TEST_ASSERT(rb_check(root.node) > 0, "Tree unbalanced after insert");
+
+    for (uint32_t i = 0; i < NUM_ITEMS; i += 2) {
+        rb_erase(&items[i].rb_node, &root);
+    }
+    TEST_ASSERT(rb_check(root.node) > 0, "Tree unbalanced after erase");
+
+    uint32_t count = 0;
+    int last = -1;
+    for (struct RBNode* node = rb_first(&root); node; node = rb_next(node)) {
+        int key = (int)rb_entry(node, struct Item, rb_node)->key;
+        TEST_ASSERT(key > last, "In-order walk not sorted");
+        last = key;
+        count++;
+    }
+    TEST_ASSERT_EQUAL(NUM_ITEMS / 2, count, "Wrong node count");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* IDs come back lowest-first, including across a full leaf */
+static struct TestResult test_radix_lowest_free(void) {
+    static struct RadixNode pool[RADIX_POOL_NODES(NUM_ITEMS)];
+    struct RadixTree tree;
+    radix_tree_init(&tree, pool, RADIX_POOL_NODES(NUM_ITEMS), NUM_ITEMS);
+
+    for (int i = 0; i < NUM_ITEMS; i++) {
+        TEST_ASSERT_EQUAL(i, radix_tree_alloc(&tree, &items[i]), "IDs not sequential");
+    }
+    TEST_ASSERT_EQUAL(-1, radix_tree_alloc(&tree, &items[0]), "Allocated past max ID");
+
+    TEST_ASSERT(radix_tree_remove(&tree, 70) == &items[70], "Wrong item removed");
+    TEST_ASSERT(radix_tree_remove(&tree, 5) == &items[5], "Wrong item removed");
+    TEST_ASSERT(radix_tree_lookup(&tree, 70) == NULL, "Removed ID still mapped");
+    TEST_ASSERT_EQUAL(5, radix_tree_alloc(&tree, &items[5]), "Lowest free ID not reused");
+    TEST_ASSERT_EQUAL(70, radix_tree_alloc(&tree, &items[70]), "Second hole not reused");
+    TEST_ASSERT(radix_tree_lookup(&tree, 199) == &items[199], "Lookup failed");
+
+    for (uint32_t i = 0; i < NUM_ITEMS; i++) {
+        radix_tree_remove(&tree, i);
+    }
+    TEST_ASSERT(tree.root == NULL, "Empty tree kept nodes");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+static struct TestResult test_list_order(void) {
+    struct ListNode head = LIST_HEAD_INIT(head);
+    struct Item* item;
+
+    for (uint32_t i = 0; i < 4; i++) {
+        items[i].key = i;
+        list_add_tail(&items[i].link, &head);
+    }
+    list_move_tail(&items[1].link, &head);
+    list_del(&items[2].link);
+
+    static const uint32_t expected[] = { 0, 3, 1 };
+    int n = 0;
+    list_for_each_entry(item, &head, link) {
+        TEST_ASSERT_EQUAL(expected[n], item->key, "Wrong list order");
+        n++;
+    }
+    TEST_ASSERT_EQUAL(3, n, "Wrong list length");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Test suite definition */
+static TestFunction container_tests[] = {
+    test_hash_backward_shift,
+    test_rbtree_balance,
+    test_radix_lowest_free,
+    test_list_order
+};
+
+struct TestSuite container_test_suite = {
+    .name = "Container Tests",
+    .tests = container_tests,
+    .test_count = sizeof(container_tests) / sizeof(TestFunction)
+};
@@ -0,0 +1,108 @@
+/**
+ * CRC32C Tests
+ * NansOS Test Suite
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "test_framework.h"
+#include "../src/impl/kernel/crc32c.h"
+#include "../src/impl/kernel/asm_utils.h"
+#include "../src/intf/string.h"
+
+#define BENCH_BUFFER_SIZE   (64 * 1024)
+#define BENCH_ROUNDS        8
+
+static uint8_t bench_buffer[BENCH_BUFFER_SIZE];
+
+/* Check value from the CRC catalogue and RFC 3720 (iSCSI) vectors */
+static struct TestResult test_crc32c_vectors(void) {
+    uint8_t data[32];
+
+    crc32c_init();
+
+    TEST_ASSERT_EQUAL(0xE3069283, crc32c_sw(0, "123456789", 9), "Software check value");
+
+    memset(data, 0, sizeof(data));
+    TEST_ASSERT_EQUAL(0x8A9136AA, crc32c_sw(0, data, sizeof(data)), "32 zero bytes");
+    memset(data, 0xFF, sizeof(data));
+    TEST_ASSERT_EQUAL(0x62A8AB43, crc32c_sw(0, data, sizeof(data)), "32 0xFF bytes");
+    for (int i = 0; i < 32; i++) {
+        data[i] = (uint8_t)i;
+    }
+    TEST_ASSERT_EQUAL(0x46DD794E, crc32c_sw(0, data, sizeof(data)), "Incrementing bytes");
+
+    if (crc32c_hw_available()) {
+        TEST_ASSERT_EQUAL(0xE3069283, crc32c_hw(0, "123456789", 9), "Hardware check value");
+    }
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Hardware and software paths agree across the interleave thresholds */
+static struct TestResult test_crc32c_paths_agree(void) {
+    static const size_t lengths[] = { 0, 1, 7, 8, 255, 768, 769, 4096, 24576, 24583, 40000 };
+    uint32_t x = 0x12345678;
+
+    for (size_t i = 0; i < BENCH_BUFFER_SIZE; i++) {
+        x = x * 1103515245 + 12345;
+        bench_buffer[i] = (uint8_t)(x >> 16);
+    }
+
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        for (size_t offset = 0; offset < 3; offset++) {
+            uint32_t sw = crc32c_sw(0xDEADBEEF, bench_buffer + offset, lengths[i]);
+            TEST_ASSERT_EQUAL(sw, crc32c(0xDEADBEEF, bench_buffer + offset, lengths[i]),
+                              "Dispatched result differs from software");
+            if (crc32c_hw_available()) {
+                TEST_ASSERT_EQUAL(sw, crc32c_hw(0xDEADBEEF, bench_buffer + offset, lengths[i]),
+                                  "Hardware result differs from software");
+            }
+        }
+    }
+
+    /* Chaining: CRC(a || b) == crc32c(crc32c(0, a), b) */
+    uint32_t whole = crc32c(0, bench_buffer, 1000);
+    uint32_t part = crc32c(crc32c(0, bench_buffer, 333), bench_buffer + 333, 667);
+    TEST_ASSERT_EQUAL(whole, part, "Chained CRC differs");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+static uint64_t bench_run(uint32_t (*fn)(uint32_t, const void*, size_t)) {
+    volatile uint32_t sink = 0;
+    uint64_t start = asm_rdtsc();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        sink = fn(sink, bench_buffer, BENCH_BUFFER_SIZE);
+    }
+    return asm_rdtsc() - start;
+}
+
+/* Throughput in bytes per 1000 cycles; results go to serial */
+static struct TestResult test_crc32c_benchmark(void) {
+    uint64_t bytes = (uint64_t)BENCH_BUFFER_SIZE * BENCH_ROUNDS;
+    uint64_t sw_cycles = bench_run(crc32c_sw);
+
+    serial_printf(COM1_PORT, "[BENCH] crc32c slice-by-8: %llu bytes/kcycle\n",
+                  bytes * 1000 / (sw_cycles ? sw_cycles : 1));
+
+    if (crc32c_hw_available()) {
+        uint64_t hw_cycles = bench_run(crc32c_hw);
+        serial_printf(COM1_PORT, "[BENCH] crc32c sse4.2: %llu bytes/kcycle\n",
+                      bytes * 1000 / (hw_cycles ? hw_cycles : 1));
+    }
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Test suite definition */
+static TestFunction crc32c_tests[] = {
+    test_crc32c_vectors,
+    test_crc32c_paths_agree,
+    test_crc32c_benchmark
+};
+
+struct TestSuite crc32c_test_suite = {
+    .name = "CRC32C Tests",
+    .tests = crc32c_tests,
+    .test_count = sizeof(crc32c_tests) / sizeof(TestFunction)
+};
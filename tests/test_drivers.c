@@ -8,9 +8,14 @@
 #include "../src/impl/drivers/keyboard/keyboard.h"
 #include "../src/impl/drivers/serial/serial.h"
 #include "../src/impl/drivers/pit/pit.h"
+#include "../src/impl/drivers/hpet/hpet.h"
 #include "../src/impl/drivers/rtc/rtc.h"
 #include "../src/impl/drivers/mouse/mouse.h"
 #include "../src/impl/drivers/port_io/port.h"
+#include "../src/impl/kernel/ktime.h"
+#include "../src/impl/kernel/clockevent.h"
+#include "../src/impl/kernel/asm_utils.h"
+#include "../src/impl/kernel/delay.h"
 
 /* Helper function to wait for keyboard controller */
 static bool wait_keyboard_controller(void) {
@@ -142,6 +147,45 @@ static struct TestResult test_serial_string(void) {
     return (struct TestResult){__func__, true, NULL};
 }
 
+/* Before interrupts are enabled writes poll, so nothing is ever queued */
+static struct TestResult test_serial_sync_fallback(void) {
+    struct SerialStats stats;
+    serial_init(COM1_PORT, SERIAL_BAUD_115200);
+    serial_write_string(COM1_PORT, "sync\n");
+    serial_get_stats(COM1_PORT, &stats);
+    TEST_ASSERT(stats.tx_pending == 0, "Synchronous write left bytes queued");
+    TEST_ASSERT(serial_tx_room(COM1_PORT) > SERIAL_TX_BUFFER, "Synchronous port reports limited room");
+    return (struct TestResult){__func__, true, NULL};
+}
+
+static uint32_t serial_tx_pending(void) {
+    struct SerialStats stats;
+    serial_get_stats(COM1_PORT, &stats);
+    return stats.tx_pending;
+}
+
+/* With interrupts on, more than a FIFO's worth is queued and drained by THRE refills */
+static struct TestResult test_serial_tx_ring(void) {
+    static const char burst[] = "interrupt-driven TX ring: several FIFO loads of text\n";
+    struct SerialStats before, after;
+    uint64_t flags = asm_irq_save();
+
+    serial_enable_interrupts(COM1_PORT);
+    serial_get_stats(COM1_PORT, &before);
+    asm_sti();
+    serial_write_bytes(COM1_PORT, burst, sizeof(burst) - 1);
+    int drained = poll_until(serial_tx_pending() == 0, 100000);
+    asm_cli();
+    asm_irq_restore(flags);
+    serial_get_stats(COM1_PORT, &after);
+
+    TEST_ASSERT(sizeof(burst) - 1 > SERIAL_FIFO_SIZE, "Burst fits in one FIFO load");
+    TEST_ASSERT_EQUAL(0, drained, "TX ring did not drain");
+    TEST_ASSERT_EQUAL(before.queued + sizeof(burst) - 1, after.queued, "Burst not queued");
+    TEST_ASSERT_EQUAL(before.tx_dropped, after.tx_dropped, "Burst dropped bytes");
+    return (struct TestResult){__func__, true, NULL};
+}
+
 /* PIT Tests */
 static struct TestResult test_pit_init(void) {
     pit_init(PIT_DEFAULT_HZ);
@@ -164,6 +208,122 @@ static struct TestResult test_pit_callback(void) {
     return (struct TestResult){__func__, true, NULL};
 }
 
+/* Clocksource Tests */
+static struct TestResult test_ktime_monotonic(void) {
+    uint64_t last = ktime_get_ns();
+    for (int i = 0; i < 1000; i++) {
+        uint64_t now = ktime_get_ns();
+        TEST_ASSERT(now >= last, "ktime went backwards");
+        last = now;
+    }
+    return (struct TestResult){__func__, true, NULL};
+}
+
+/* A 10 ms channel 2 countdown should read as 10 ms on the TSC clock */
+static struct TestResult test_ktime_calibration(void) {
+    if (!ktime_tsc_hz()) {
+        return (struct TestResult){__func__, true, NULL};
+    }
+    uint64_t start = ktime_get_ns();
+    TEST_ASSERT(pit_calibrate_tsc(10) != 0, "PIT channel 2 did not expire");
+    uint64_t elapsed = ktime_get_ns() - start;
+    TEST_ASSERT(elapsed > 9 * NSEC_PER_MSEC && elapsed < 12 * NSEC_PER_MSEC, "TSC rate off");
+    return (struct TestResult){__func__, true, NULL};
+}
+
+/* Ticks keep pace with ktime across tickless sleeps */
+static struct TestResult test_tick_idle_catch_up(void) {
+    if (!ktime_tsc_hz()) {
+        return (struct TestResult){__func__, true, NULL};
+    }
+    uint64_t target = ktime_get_ns() + 100 * NSEC_PER_MSEC;
+    uint64_t start = pit_get_ticks();
+    while (ktime_get_ns() < target) {
+        tick_idle(target);
+    }
+    uint64_t ticks = pit_get_ticks() - start;
+    TEST_ASSERT(ticks >= 9 && ticks <= 11, "Ticks lost or gained while idle");
+    return (struct TestResult){__func__, true, NULL};
+}
+
+/* HPET Tests */
+#define CLOCK_BENCH_READS   1000
+#define CLOCK_BENCH_WINDOWS 16
+
+struct ClockBench {
+    uint64_t min, max, total;
+};
+
+static void clock_bench_add(struct ClockBench* bench, uint64_t value) {
+    if (value < bench->min) bench->min = value;
+    if (value > bench->max) bench->max = value;
+    bench->total += value;
+}
+
+static void clock_bench_report(const char* name, const struct ClockBench* reads,
+                               const struct ClockBench* windows) {
+    uint64_t mean = windows->total / CLOCK_BENCH_WINDOWS;
+    serial_printf(COM1_PORT, "[BENCH] %s: read %llu/%llu/%llu ns min/avg/max, "
+                  "1 ms TSC rate spread %llu ppm\n", name,
+                  (unsigned long long)ktime_cycles_to_ns(reads->min),
+                  (unsigned long long)ktime_cycles_to_ns(reads->total / CLOCK_BENCH_READS),
+                  (unsigned long long)ktime_cycles_to_ns(reads->max),
+                  (unsigned long long)(mean ? (windows->max - windows->min) * 1000000 / mean : 0));
+}
+
+static struct TestResult test_hpet_counter(void) {
+    if (!hpet_available()) {
+        return (struct TestResult){__func__, true, NULL};
+    }
+    uint64_t hz = hpet_get_frequency();
+    TEST_ASSERT(hz >= 10000000, "HPET slower than the 10 MHz minimum");
+
+    uint64_t first = hpet_read_counter();
+    uint64_t start = ktime_get_ns();
+    while (ktime_get_ns() - start < NSEC_PER_MSEC) {}
+    uint64_t ticks = hpet_read_counter() - first;
+    if (!hpet_counter_is_64bit()) {
+        ticks = (uint32_t)ticks;
+    }
+    /* Generous upper bound: the host may preempt an emulated guest mid-wait */
+    TEST_ASSERT(ticks >= hz / 1000 && ticks < hz / 100, "HPET counter disagrees with ktime");
+    return (struct TestResult){__func__, true, NULL};
+}
+
+/*
+ * Cost of one counter read, and the spread of TSC rates measured over
+ * 1 ms windows, which is the reference's own jitter; results go to serial
+ */
+static struct TestResult test_hpet_benchmark(void) {
+    if (!hpet_available() || !ktime_tsc_hz()) {
+        return (struct TestResult){__func__, true, NULL};
+    }
+    struct ClockBench hpet_reads = { UINT64_MAX, 0, 0 }, pit_reads = { UINT64_MAX, 0, 0 };
+    struct ClockBench hpet_windows = { UINT64_MAX, 0, 0 }, pit_windows = { UINT64_MAX, 0, 0 };
+    volatile uint64_t sink;
+
+    for (int i = 0; i < CLOCK_BENCH_READS; i++) {
+        uint64_t start = asm_rdtsc();
+        sink = hpet_read_counter();
+        clock_bench_add(&hpet_reads, asm_rdtsc() - start);
+
+        start = asm_rdtsc();
+        sink = pit_read_counter();
+        clock_bench_add(&pit_reads, asm_rdtsc() - start);
+    }
+    (void)sink;
+
+    for (int i = 0; i < CLOCK_BENCH_WINDOWS; i++) {
+        clock_bench_add(&hpet_windows, hpet_calibrate_tsc(1));
+        clock_bench_add(&pit_windows, pit_calibrate_tsc(1));
+    }
+    TEST_ASSERT(pit_windows.min != 0, "PIT channel 2 did not expire");
+
+    clock_bench_report("hpet", &hpet_reads, &hpet_windows);
+    clock_bench_report("pit", &pit_reads, &pit_windows);
+    return (struct TestResult){__func__, true, NULL};
+}
+
 /* RTC Tests */
 static struct TestResult test_rtc_init(void) {
     rtc_init();
@@ -184,6 +344,31 @@ static struct TestResult test_rtc_time(void) {
     return (struct TestResult){__func__, true, NULL};
 }
 
+static struct TestResult test_rtc_epoch(void) {
+    struct RTCTime new_year = { .second = 0, .minute = 0, .hour = 0, .day = 1, .month = 1, .year = 2025 };
+    struct RTCTime leap_day = { .second = 56, .minute = 34, .hour = 12, .day = 29, .month = 2, .year = 2024 };
+
+    TEST_ASSERT(rtc_time_to_epoch(&new_year) == 1735689600ull, "Wrong epoch for 2025-01-01");
+    TEST_ASSERT(rtc_time_to_epoch(&leap_day) == 1709210096ull, "Wrong epoch for a leap day");
+    return (struct TestResult){__func__, true, NULL};
+}
+
+/* Wall time comes from the cached offset and follows the monotonic clock */
+static struct TestResult test_rtc_wall_clock(void) {
+    struct RTCTime now;
+    rtc_read_time(&now);
+    uint64_t rtc_seconds = rtc_time_to_epoch(&now);
+    uint64_t real_seconds = ktime_get_real_seconds();
+
+    TEST_ASSERT(real_seconds + 2 >= rtc_seconds && real_seconds <= rtc_seconds + 2,
+                "Wall clock drifted from the RTC");
+
+    uint64_t before = ktime_get_real();
+    udelay(1000);
+    TEST_ASSERT(ktime_get_real() - before >= NSEC_PER_MSEC, "Wall clock not advancing");
+    return (struct TestResult){__func__, true, NULL};
+}
+
 static struct TestResult test_rtc_interrupts(void) {
     rtc_enable_interrupt();
     uint8_t status = port_byte_in(RTC_STATUS_B);
@@ -257,15 +442,26 @@ static TestFunction driver_tests[] = {
     test_serial_init,
     test_serial_write_read,
     test_serial_string,
+    test_serial_sync_fallback,
+    test_serial_tx_ring,
     
     // PIT tests
     test_pit_init,
     test_pit_frequency,
     test_pit_callback,
+    test_ktime_monotonic,
+    test_ktime_calibration,
+    test_tick_idle_catch_up,
+    
+    // HPET tests
+    test_hpet_counter,
+    test_hpet_benchmark,
     
     // RTC tests
     test_rtc_init,
     test_rtc_time,
+    test_rtc_epoch,
+    test_rtc_wall_clock,
     test_rtc_interrupts,
     
     // Mouse tests
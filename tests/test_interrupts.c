@@ -7,7 +7,15 @@
 #include "test_framework.h"
 #include "../src/impl/kernel/idt.h"
 #include "../src/impl/kernel/isr.h"
+#include "../src/impl/kernel/irq.h"
+#include "../src/impl/kernel/softirq.h"
+#include "../src/impl/kernel/kstat.h"
+#include "../src/impl/kernel/irqstat.h"
+#include "../src/impl/kernel/delay.h"
+#include "../src/impl/kernel/asm_utils.h"
 #include "../src/impl/drivers/pic/pic.h"
+#include "../src/impl/drivers/port_io/port.h"
+#include "../src/impl/drivers/apic/apic.h"
 
 /* Test IDT initialization */
 static struct TestResult test_idt_initialization(void) {
@@ -53,21 +61,181 @@ static struct TestResult test_pic_initialization(void) {
     /* Verify timer, keyboard, and cascade are enabled */
     TEST_ASSERT((master_mask & 0x07) == 0, "Required interrupts not enabled");
     
+    /* Leave the 8259s masked again under the APIC */
+    if (apic_active()) {
+        pic_disable();
+    }
+    
     return (struct TestResult){__func__, 1, NULL};
 }
 
 /* Test interrupt handler registration */
+#define TEST_VECTOR 0x81
+
+static struct InterruptFrame test_frame;
+static int test_calls;
+
+static void test_vector_handler_other(struct InterruptFrame* frame, void* ctx) {
+    (void)frame;
+    (void)ctx;
+}
+
+static void test_vector_handler(struct InterruptFrame* frame, void* ctx) {
+    test_frame = *frame;
+    test_calls += *(int*)ctx;
+}
+
 static struct TestResult test_handler_registration(void) {
-    /* Set a test handler */
-    idt_set_entry(0x20, (uint64_t)isr_timer_handler, 0x8E);
+    static int increment = 1;
     
-    /* Verify entry is set */
-    struct IDTEntry* idt = (struct IDTEntry*)0;
-    asm volatile("sidt %0" : "=m"(*((struct IDTPointer*)&idt)));
+    /* Every gate points at its entry stub */
+    struct IDTPointer idt_ptr;
+    asm volatile("sidt %0" : "=m"(idt_ptr));
+    struct IDTEntry* idt = (struct IDTEntry*)idt_ptr.base;
+    uint64_t target = idt[0x20].isr_low | ((uint64_t)idt[0x20].isr_mid << 16) |
+                      ((uint64_t)idt[0x20].isr_high << 32);
     
-    TEST_ASSERT(idt[0x20].isr_low != 0, "Handler not registered");
+    TEST_ASSERT(target == isr_stub_table[0x20], "Gate does not point at its stub");
     TEST_ASSERT(idt[0x20].attributes == 0x8E, "Handler attributes incorrect");
     
+    /* A software interrupt reaches the registered handler with a full frame */
+    test_calls = 0;
+    TEST_ASSERT_EQUAL(0, irq_register(TEST_VECTOR, test_vector_handler, &increment), "Registration failed");
+    TEST_ASSERT_EQUAL(-1, irq_register(TEST_VECTOR, test_vector_handler_other, NULL), "Vector taken twice");
+    asm volatile("int %0" : : "i"(TEST_VECTOR) : "memory");
+    irq_unregister(TEST_VECTOR);
+    asm volatile("int %0" : : "i"(TEST_VECTOR) : "memory");
+    
+    TEST_ASSERT_EQUAL(1, test_calls, "Handler not called exactly once");
+    TEST_ASSERT(test_frame.vector == TEST_VECTOR, "Wrong vector in frame");
+    TEST_ASSERT(test_frame.error_code == 0, "Stub did not push a zero error code");
+    TEST_ASSERT(test_frame.cs == 0x08, "Wrong code segment in frame");
+    
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Test vector allocation and legacy IRQ routing at the active chip */
+static struct TestResult test_irq_chip(void) {
+    int vector = irq_alloc_vector(IRQ_PRIORITY_MIN, test_vector_handler_other, NULL);
+    TEST_ASSERT(vector >= 0 && IRQ_PRIORITY(vector) == IRQ_PRIORITY_MIN, "Vector outside its priority class");
+    TEST_ASSERT_EQUAL(-1, irq_register(vector, test_vector_handler, NULL), "Allocated vector not owned");
+    irq_unregister(vector);
+    TEST_ASSERT_EQUAL(-1, irq_alloc_vector(IRQ_PRIORITY(LAPIC_SPURIOUS_VECTOR), test_vector_handler_other, NULL),
+                      "Allocated from the reserved class");
+    
+    if (!apic_active()) {
+        TEST_ASSERT(irq_get_chip() == &pic_irq_chip, "PIC not the default chip");
+        return (struct TestResult){__func__, 1, NULL};
+    }
+    
+    TEST_ASSERT(lapic_read(LAPIC_REG_SVR) & LAPIC_SVR_ENABLE, "Local APIC not software enabled");
+    TEST_ASSERT_EQUAL(0xFF, port_byte_in(PIC1_DATA), "8259 not masked under the APIC");
+    
+    /* The keyboard line keeps its PIC-era vector; masking touches only its entry */
+    int gsi = ioapic_isa_to_gsi(1);
+    TEST_ASSERT(gsi >= 0, "Keyboard IRQ not routed");
+    uint64_t entry = ioapic_read_entry(gsi);
+    TEST_ASSERT_EQUAL(IRQ_VECTOR(1), entry & IOAPIC_REDIR_VECTOR, "Keyboard routed to the wrong vector");
+    TEST_ASSERT_EQUAL(lapic_id(), entry >> IOAPIC_REDIR_DEST_SHIFT, "Keyboard routed to another CPU");
+    
+    irq_mask(1);
+    TEST_ASSERT(ioapic_read_entry(gsi) & IOAPIC_REDIR_MASKED, "Mask did not reach the I/O APIC");
+    irq_unmask(1);
+    TEST_ASSERT(!(ioapic_read_entry(gsi) & IOAPIC_REDIR_MASKED), "Unmask did not reach the I/O APIC");
+    if (entry & IOAPIC_REDIR_MASKED) {
+        irq_mask(1);
+    }
+    
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Test that softirqs run on interrupt exit and work runs from the queue */
+#define TEST_SOFTIRQ_VECTOR 0x82
+
+static void test_raise_handler(struct InterruptFrame* frame, void* ctx) {
+    (void)frame;
+    (void)ctx;
+    softirq_raise(SOFTIRQ_KEYBOARD);
+}
+
+static void test_work_fn(void* data) {
+    (*(int*)data)++;
+}
+
+static struct TestResult test_bottom_halves(void) {
+    static int runs;
+    struct KStat* stat = kstat_find("softirq");
+    TEST_ASSERT(stat != NULL, "Softirq statistics not registered");
+    
+    /* Raised in the handler, run before the interrupted code resumes */
+    uint64_t before = kstat_read(stat, SOFTIRQ_KEYBOARD);
+    TEST_ASSERT_EQUAL(0, irq_register(TEST_SOFTIRQ_VECTOR, test_raise_handler, NULL), "Registration failed");
+    idt_enable_interrupts();
+    asm volatile("int %0" : : "i"(TEST_SOFTIRQ_VECTOR) : "memory");
+    idt_disable_interrupts();
+    irq_unregister(TEST_SOFTIRQ_VECTOR);
+    TEST_ASSERT(!softirq_pending(), "Softirq left pending after interrupt exit");
+    TEST_ASSERT_EQUAL(before + 1, kstat_read(stat, SOFTIRQ_KEYBOARD), "Softirq did not run once");
+    
+    /* Queueing twice runs once; cancelled work does not run */
+    struct Work work;
+    work_init(&work, test_work_fn, &runs);
+    runs = 0;
+    TEST_ASSERT_EQUAL(1, schedule_work(&work), "Work not queued");
+    TEST_ASSERT_EQUAL(0, schedule_work(&work), "Work queued twice");
+    TEST_ASSERT_EQUAL(1, cancel_work(&work), "Queued work not cancelled");
+    workqueue_run();
+    TEST_ASSERT_EQUAL(0, runs, "Cancelled work ran");
+    
+    schedule_work(&work);
+    schedule_work(&work);
+    workqueue_run();
+    TEST_ASSERT_EQUAL(1, runs, "Work did not run exactly once");
+    TEST_ASSERT(!work.pending, "Work still marked pending");
+    
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Test per-vector duration histograms and the interrupts-off span tracer */
+static struct TestResult test_irqstat(void) {
+    static int increment = 1;
+    struct IRQVectorStats stats;
+    struct IRQOffStats off;
+    int was_tracing = irqoff_trace_enabled();
+    uint32_t total = 0;
+    
+    irqstat_reset();
+    TEST_ASSERT_EQUAL(0, irq_register(TEST_VECTOR, test_vector_handler, &increment), "Registration failed");
+    asm volatile("int %0" : : "i"(TEST_VECTOR) : "memory");
+    irq_unregister(TEST_VECTOR);
+    
+    irqstat_get(TEST_VECTOR, &stats);
+    TEST_ASSERT_EQUAL(1, stats.count, "Vector not counted once");
+    TEST_ASSERT(stats.max_cycles > 0 && stats.max_cycles == stats.cycles, "Handler time not recorded");
+    for (int b = 0; b < IRQSTAT_BUCKETS; b++) {
+        total += stats.hist[b];
+    }
+    TEST_ASSERT_EQUAL(1, total, "Histogram does not hold one sample");
+    TEST_ASSERT_EQUAL(irqstat_bucket(1), 0, "Bucket 0 not the smallest");
+    TEST_ASSERT_EQUAL(irqstat_bucket(~0ull), IRQSTAT_BUCKETS - 1, "Long spans not clamped");
+    
+    /* A deliberate 50us window is caught as the longest span */
+    irqoff_trace_enable(1);
+    idt_enable_interrupts();
+    uint64_t flags = asm_irq_save();
+    udelay(50);
+    asm_irq_restore(flags);
+    idt_disable_interrupts();
+    irqoff_get_stats(&off);
+    irqoff_trace_enable(was_tracing);
+    
+    TEST_ASSERT(off.spans >= 1, "No interrupts-off span recorded");
+    TEST_ASSERT(off.max_cycles > 0 && off.max_begin_ip != 0, "Longest span not recorded");
+    
+    irqstat_reset();
+    irqoff_get_stats(&off);
+    TEST_ASSERT_EQUAL(0, off.spans, "Reset left spans behind");
+    
     return (struct TestResult){__func__, 1, NULL};
 }
 
@@ -76,7 +244,10 @@ static TestFunction interrupt_tests[] = {
     test_idt_initialization,
     test_interrupt_control,
     test_pic_initialization,
-    test_handler_registration
+    test_handler_registration,
+    test_irq_chip,
+    test_bottom_halves,
+    test_irqstat
 };
 
 struct TestSuite interrupt_test_suite = {
@@ -0,0 +1,156 @@
+/**
+ * Kernel Log Tests
+ * NansOS Test Suite
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "test_framework.h"
+#include "../src/impl/kernel/klog.h"
+#include <string.h>
+
+#define CAPTURE_MAX     8
+
+struct Capture {
+    struct KLogDrain drain;
+    int count;
+    int last_seq;
+    int out_of_order;
+    int levels[CAPTURE_MAX];
+    char text[CAPTURE_MAX][KLOG_MAX_MESSAGE + 1];
+};
+
+static struct Capture capture;
+
+static int capture_emit(struct KLogDrain* drain, const struct KLogRecord* record,
+                        const char* text) {
+    struct Capture* cap = container_of(drain, struct Capture, drain);
+
+    /* Sequence-numbered records must arrive in order */
+    if (record->length > 4 && memcmp(text, "seq ", 4) == 0) {
+        int seq = 0;
+        for (uint16_t i = 4; i < record->length; i++) {
+            seq = seq * 10 + (text[i] - '0');
+        }
+        if (seq != cap->last_seq + 1) {
+            cap->out_of_order++;
+        }
+        cap->last_seq = seq;
+    }
+
+    if (cap->count < CAPTURE_MAX) {
+        cap->levels[cap->count] = record->level;
+        memcpy(cap->text[cap->count], text, record->length);
+        cap->text[cap->count][record->length] = '\0';
+    }
+    cap->count++;
+    return 0;
+}
+
+static void capture_attach(int max_level) {
+    memset(&capture, 0, sizeof(capture));
+    capture.drain.name = "test";
+    capture.drain.max_level = max_level;
+    capture.drain.emit = capture_emit;
+    klog_flush();
+    klog_register_drain(&capture.drain);
+}
+
+static void capture_detach(void) {
+    klog_flush();
+    klog_unregister_drain(&capture.drain);
+}
+
+/* Records reach the drain in order, trimmed, filtered and truncated */
+static struct TestResult test_klog_records(void) {
+    static char long_message[KLOG_MAX_MESSAGE + 40];
+    struct KLogStats before;
+    struct KLogStats after;
+
+    capture_attach(KLOG_INFO);
+    klog_get_stats(&before);
+
+    klog(KLOG_WARN, "first %d\n", 1);
+    klog(KLOG_DEBUG, "filtered");
+    klog(KLOG_ERROR, "second");
+
+    memset(long_message, 'x', sizeof(long_message) - 1);
+    long_message[sizeof(long_message) - 1] = '\0';
+    klog_write(KLOG_INFO, long_message, strlen(long_message));
+
+    klog_flush();
+    klog_get_stats(&after);
+    capture_detach();
+
+    TEST_ASSERT_EQUAL(3, capture.count, "Level filter not applied");
+    TEST_ASSERT(strcmp(capture.text[0], "first 1") == 0, "Trailing newline kept");
+    TEST_ASSERT_EQUAL(KLOG_WARN, capture.levels[0], "Wrong level");
+    TEST_ASSERT(strcmp(capture.text[1], "second") == 0, "Records out of order");
+    TEST_ASSERT_EQUAL(KLOG_MAX_MESSAGE, strlen(capture.text[2]), "Long message not truncated");
+    TEST_ASSERT_EQUAL(before.truncated + 1, after.truncated, "Truncation not counted");
+    TEST_ASSERT_EQUAL(before.written + 4, after.written, "Write count mismatch");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Several laps around the ring lose nothing and never surface padding */
+static struct TestResult test_klog_wraparound(void) {
+    struct KLogStats before;
+    struct KLogStats after;
+    int total = (KLOG_BUFFER_SIZE / 64) * 3;
+
+    capture_attach(KLOG_DEBUG);
+    klog_get_stats(&before);
+
+    for (int i = 1; i <= total; i++) {
+        klog(KLOG_DEBUG, "seq %d", i);
+        if (i % 64 == 0) {
+            klog_drain();
+        }
+    }
+
+    klog_flush();
+    klog_get_stats(&after);
+    capture_detach();
+
+    TEST_ASSERT_EQUAL(total, capture.count, "Records lost across wrap");
+    TEST_ASSERT_EQUAL(0, capture.out_of_order, "Records reordered across wrap");
+    TEST_ASSERT_EQUAL(before.dropped, after.dropped, "Records dropped while draining");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* A call site gets its burst, then reports what it lost in the next interval */
+static struct TestResult test_klog_ratelimit(void) {
+    struct KLogRateLimit state = KLOG_RATELIMIT_INIT(60000, 3);
+    int allowed = 0;
+
+    capture_attach(KLOG_WARN);
+    for (int i = 0; i < 5; i++) {
+        allowed += klog_ratelimit(&state, "site");
+    }
+    TEST_ASSERT_EQUAL(3, allowed, "Burst not enforced");
+    TEST_ASSERT_EQUAL(2, state.missed, "Suppressions not counted");
+
+    /* Zero-length interval: the next call starts a fresh one */
+    state.interval_ms = 0;
+    TEST_ASSERT(klog_ratelimit(&state, "site"), "New interval still limited");
+    capture_detach();
+
+    TEST_ASSERT_EQUAL(1, capture.count, "Suppression not reported");
+    TEST_ASSERT(strcmp(capture.text[0], "site: 2 messages suppressed") == 0, "Wrong report");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Test suite definition */
+static TestFunction klog_tests[] = {
+    test_klog_records,
+    test_klog_wraparound,
+    test_klog_ratelimit
+};
+
+struct TestSuite klog_test_suite = {
+    .name = "Kernel Log Tests",
+    .tests = klog_tests,
+    .test_count = sizeof(klog_tests) / sizeof(TestFunction)
+};
@@ -0,0 +1,56 @@
+/**
+ * Kernel Statistics Tests
+ * NansOS Test Suite
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "test_framework.h"
+#include "../src/impl/kernel/kstat.h"
+
+DEFINE_KSTAT_COUNTER(test_counter, "test.counter");
+DEFINE_KSTAT_GAUGE(test_gauge, "test.gauge");
+DEFINE_KSTAT_ARRAY(test_array, "test.array", 4);
+
+/* Statistics register themselves and sum their per-CPU slots on read */
+static struct TestResult test_kstat_counters(void) {
+    TEST_ASSERT(kstat_find("test.counter") == &test_counter, "Counter not registered");
+    TEST_ASSERT(kstat_find("no.such.stat") == NULL, "Unknown name found");
+
+    uint64_t before = kstat_read(&test_counter, 0);
+    kstat_inc(test_counter);
+    kstat_add(test_counter, 41);
+    TEST_ASSERT(kstat_read(&test_counter, 0) - before == 42, "Counter did not advance by 42");
+
+    kstat_inc_at(test_array, 3);
+    kstat_inc_at(test_array, 3);
+    TEST_ASSERT_EQUAL(2, (int)kstat_read(&test_array, 3), "Array entry not counted");
+    TEST_ASSERT_EQUAL(0, (int)kstat_read(&test_array, 1), "Neighbouring entry touched");
+    TEST_ASSERT_EQUAL(0, (int)kstat_read(&test_array, 4), "Out-of-range entry readable");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Gauges go up and down and read back as the current level */
+static struct TestResult test_kstat_gauge(void) {
+    uint64_t before = kstat_read(&test_gauge, 0);
+
+    kstat_add(test_gauge, 5);
+    kstat_sub(test_gauge, 3);
+    TEST_ASSERT(kstat_read(&test_gauge, 0) == before + 2, "Gauge level wrong");
+    kstat_sub(test_gauge, 2);
+    TEST_ASSERT(kstat_read(&test_gauge, 0) == before, "Gauge did not return to its level");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Test suite definition */
+static TestFunction kstat_tests[] = {
+    test_kstat_counters,
+    test_kstat_gauge
+};
+
+struct TestSuite kstat_test_suite = {
+    .name = "Kernel Statistics Tests",
+    .tests = kstat_tests,
+    .test_count = sizeof(kstat_tests) / sizeof(TestFunction)
+};
@@ -13,10 +13,26 @@
 extern struct TestSuite interrupt_test_suite;
 extern struct TestSuite driver_test_suite;
 extern struct TestSuite memory_test_suite;
+extern struct TestSuite string_test_suite;
+extern struct TestSuite stdio_test_suite;
+extern struct TestSuite crc32c_test_suite;
+extern struct TestSuite container_test_suite;
+extern struct TestSuite klog_test_suite;
+extern struct TestSuite tracepoint_test_suite;
+extern struct TestSuite kstat_test_suite;
+extern struct TestSuite timer_test_suite;
 
 /* Test suites array */
 static struct TestSuite* test_suites[] = {
     &memory_test_suite,    /* Run memory tests first */
+    &string_test_suite,    /* Core library primitives */
+    &stdio_test_suite,
+    &crc32c_test_suite,
+    &container_test_suite,
+    &klog_test_suite,
+    &tracepoint_test_suite,
+    &kstat_test_suite,
+    &timer_test_suite,
     &interrupt_test_suite, /* Then interrupts */
     &driver_test_suite     /* Finally device drivers */
 };
@@ -65,7 +65,7 @@ static struct TestResult test_vsprintf(void) {
     char buffer[256];
     int result = test_vsprintf_helper(buffer, "Test %s %d", "string", 42);
     
-    TEST_ASSERT_EQUAL(15, result, "Incorrect return value from vsprintf");
+    TEST_ASSERT_EQUAL(14, result, "Incorrect return value from vsprintf");
     TEST_ASSERT(strcmp(buffer, "Test string 42") == 0, "Incorrect string output");
     
     return (struct TestResult){__func__, 1, NULL};
@@ -83,13 +83,66 @@ static struct TestResult test_vsnprintf(void) {
     return (struct TestResult){__func__, 1, NULL};
 }
 
+/* Test width, precision and flags */
+static struct TestResult test_sprintf_width_precision(void) {
+    char buffer[64];
+    int result = sprintf(buffer, "[%5d|%-5d|%05d|%.3d]", 42, 42, -42, 7);
+
+    TEST_ASSERT_EQUAL(23, result, "Incorrect return value from sprintf");
+    TEST_ASSERT(strcmp(buffer, "[   42|42   |-0042|007]") == 0, "Incorrect padding");
+
+    sprintf(buffer, "%#x %#o %.2s %*s", 255, 8, "abcdef", 4, "x");
+    TEST_ASSERT(strcmp(buffer, "0xff 010 ab    x") == 0, "Incorrect flag handling");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Test length modifiers */
+static struct TestResult test_sprintf_length_modifiers(void) {
+    char buffer[64];
+
+    sprintf(buffer, "%llu", 18446744073709551615ULL);
+    TEST_ASSERT(strcmp(buffer, "18446744073709551615") == 0, "Incorrect %llu output");
+
+    sprintf(buffer, "%lld", -9000000000LL);
+    TEST_ASSERT(strcmp(buffer, "-9000000000") == 0, "Incorrect %lld output");
+
+    sprintf(buffer, "%016llx", 0xFFFF800000001000ULL);
+    TEST_ASSERT(strcmp(buffer, "ffff800000001000") == 0, "Incorrect %llx output");
+
+    sprintf(buffer, "%hhu %u", 0x1FF, 4000000000U);
+    TEST_ASSERT(strcmp(buffer, "255 4000000000") == 0, "Incorrect %u output");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Test that bounded output never touches bytes past the limit */
+static struct TestResult test_snprintf_truncation(void) {
+    char buffer[8];
+    memset(buffer, 'Z', sizeof(buffer));
+
+    int result = snprintf(buffer, 4, "%d", 123456);
+    TEST_ASSERT_EQUAL(6, result, "Incorrect total length returned");
+    TEST_ASSERT(strcmp(buffer, "123") == 0, "Incorrect truncated output");
+    TEST_ASSERT(buffer[4] == 'Z', "Wrote past the buffer size");
+
+    result = snprintf(buffer, 0, "%s", "untouched");
+    TEST_ASSERT_EQUAL(9, result, "Size 0 must still report length");
+    TEST_ASSERT(buffer[4] == 'Z', "Size 0 wrote to the buffer");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
 /* StdIO test suite */
 static TestFunction stdio_tests[] = {
     test_sprintf_basic,
     test_sprintf_numbers,
     test_snprintf_bounds,
     test_vsprintf,
-    test_vsnprintf
+    test_vsnprintf,
+    test_sprintf_width_precision,
+    test_sprintf_length_modifiers,
+    test_snprintf_truncation
 };
 
 struct TestSuite stdio_test_suite = {
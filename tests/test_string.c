@@ -0,0 +1,171 @@
+/**
+ * String Primitive Tests
+ * NansOS Test Suite
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "test_framework.h"
+#include "../src/intf/string.h"
+#include "../src/impl/kernel/asm_utils.h"
+
+#define BENCH_ITERATIONS 2000
+
+/* Path and name lengths the VFS and ramdisk actually see */
+static const char* bench_paths[] = {
+    "/",
+    "/dev/ram0",
+    "/mnt/data/config.sys",
+    "/home/user/documents/projects/nansos/build/kernel.bin",
+    "/usr/share/fonts/truetype/dejavu/DejaVuSansMono-BoldOblique.ttf"
+};
+
+#define NUM_BENCH_PATHS (sizeof(bench_paths) / sizeof(bench_paths[0]))
+
+/* Byte-loop references the word-at-a-time versions replaced */
+static __attribute__((noinline)) size_t byte_strlen(const char* s) {
+    size_t len = 0;
+    while (s[len]) {
+        len++;
+    }
+    return len;
+}
+
+static __attribute__((noinline)) int byte_strcmp(const char* s1, const char* s2) {
+    while (*s1 && (*s1 == *s2)) {
+        s1++;
+        s2++;
+    }
+    return *(const unsigned char*)s1 - *(const unsigned char*)s2;
+}
+
+static __attribute__((noinline)) char* byte_strrchr(const char* s, int c) {
+    const char* found = NULL;
+    while (*s) {
+        if (*s == (char)c) {
+            found = s;
+        }
+        s++;
+    }
+    return (char*)found;
+}
+
+static volatile size_t bench_sink;
+
+static void bench_report(const char* name, uint64_t byte_cycles, uint64_t word_cycles) {
+    char buffer[96];
+    sprintf(buffer, "[BENCH] %s: byte %u cycles, word %u cycles\n", name,
+            (unsigned int)(byte_cycles / BENCH_ITERATIONS),
+            (unsigned int)(word_cycles / BENCH_ITERATIONS));
+    serial_write_string(COM1_PORT, buffer);
+}
+
+/* Correctness at every starting alignment */
+static struct TestResult test_strlen_alignment(void) {
+    char buffer[64];
+    for (int offset = 0; offset < 8; offset++) {
+        for (int len = 0; len < 40; len++) {
+            memset(buffer, 'a', sizeof(buffer));
+            buffer[offset + len] = '\0';
+            TEST_ASSERT_EQUAL((size_t)len, strlen(buffer + offset), "strlen wrong length");
+            TEST_ASSERT_EQUAL((size_t)len, strnlen(buffer + offset, 64), "strnlen wrong length");
+        }
+    }
+    TEST_ASSERT_EQUAL(3, strnlen("abcdef", 3), "strnlen ignored bound");
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+static struct TestResult test_strcmp_words(void) {
+    char a[48];
+    char b[48];
+    strcpy(a + 1, "/home/user/documents/report.txt");
+    strcpy(b + 3, "/home/user/documents/report.txt");
+
+    TEST_ASSERT(strcmp(a + 1, b + 3) == 0, "Equal strings compared unequal");
+    b[3 + 20] = 'X';
+    TEST_ASSERT(strcmp(a + 1, b + 3) < 0, "Wrong ordering after difference");
+    TEST_ASSERT(strncmp(a + 1, b + 3, 20) == 0, "strncmp read past bound");
+    TEST_ASSERT(strncmp(a + 1, b + 3, 21) < 0, "strncmp missed difference");
+    TEST_ASSERT(strcmp("/dev", "/dev/ram0") < 0, "Prefix should sort first");
+    TEST_ASSERT(strcmp("\xff", "a") > 0, "Comparison must be unsigned");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+static struct TestResult test_strchr_family(void) {
+    const char* path = "/mnt/data/config.sys";
+
+    TEST_ASSERT(strchr(path, 'd') == path + 5, "strchr wrong match");
+    TEST_ASSERT(strchr(path, 'z') == NULL, "strchr false match");
+    TEST_ASSERT(strchr(path, '\0') == path + 20, "strchr missed terminator");
+    TEST_ASSERT(strrchr(path, '/') == path + 9, "strrchr wrong match");
+    TEST_ASSERT(strrchr(path, '\0') == path + 20, "strrchr missed terminator");
+    TEST_ASSERT(memchr(path, '.', 20) == path + 16, "memchr wrong match");
+    TEST_ASSERT(memchr(path, '.', 16) == NULL, "memchr read past bound");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Microbenchmark against the old byte loops; results go to serial */
+static struct TestResult test_string_benchmark(void) {
+    uint64_t byte_cycles = 0;
+    uint64_t word_cycles = 0;
+
+    for (size_t p = 0; p < NUM_BENCH_PATHS; p++) {
+        uint64_t start = asm_rdtsc();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            bench_sink = byte_strlen(bench_paths[p]);
+        }
+        byte_cycles = asm_rdtsc() - start;
+
+        start = asm_rdtsc();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            bench_sink = strlen(bench_paths[p]);
+        }
+        word_cycles = asm_rdtsc() - start;
+        bench_report(bench_paths[p], byte_cycles, word_cycles);
+    }
+
+    const char* a = bench_paths[NUM_BENCH_PATHS - 1];
+    char b[80];
+    strcpy(b, a);
+
+    uint64_t start = asm_rdtsc();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        bench_sink = (size_t)byte_strcmp(a, b);
+    }
+    byte_cycles = asm_rdtsc() - start;
+    start = asm_rdtsc();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        bench_sink = (size_t)strcmp(a, b);
+    }
+    word_cycles = asm_rdtsc() - start;
+    bench_report("strcmp", byte_cycles, word_cycles);
+
+    start = asm_rdtsc();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        bench_sink = (size_t)byte_strrchr(a, '/');
+    }
+    byte_cycles = asm_rdtsc() - start;
+    start = asm_rdtsc();
+    for (int i = 0; i < BENCH_ITERATIONS; i++) {
+        bench_sink = (size_t)strrchr(a, '/');
+    }
+    word_cycles = asm_rdtsc() - start;
+    bench_report("strrchr", byte_cycles, word_cycles);
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Test suite definition */
+static TestFunction string_tests[] = {
+    test_strlen_alignment,
+    test_strcmp_words,
+    test_strchr_family,
+    test_string_benchmark
+};
+
+struct TestSuite string_test_suite = {
+    .name = "String Primitive Tests",
+    .tests = string_tests,
+    .test_count = sizeof(string_tests) / sizeof(TestFunction)
+};
@@ -0,0 +1,137 @@
+/**
+ * Kernel Timer Tests
+ * NansOS Test Suite
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "test_framework.h"
+#include "../src/impl/kernel/timer.h"
+#include "../src/impl/kernel/clockevent.h"
+#include "../src/impl/kernel/ktime.h"
+#include "../src/impl/kernel/delay.h"
+
+static int fire_count;
+static uint64_t fire_ticks[3];
+
+static void record_fire(void* data) {
+    uint64_t* slot = data;
+    *slot = tick_get_ticks();
+    fire_count++;
+}
+
+/* Arming, re-arming and cancelling report the previous pending state */
+static struct TestResult test_timer_mod_del(void) {
+    struct Timer timer;
+    uint64_t far = tick_get_ticks() + 100000;
+
+    timer_init(&timer, record_fire, &fire_ticks[0]);
+    timer_set_slack(&timer, 0);
+    TEST_ASSERT(!timer_pending(&timer), "Fresh timer pending");
+
+    TEST_ASSERT_EQUAL(0, timer_mod(&timer, far), "Idle timer reported pending");
+    TEST_ASSERT(timer_pending(&timer), "Armed timer not pending");
+    TEST_ASSERT(timer.expires == far, "Expiry moved without slack");
+    TEST_ASSERT(timer_next_expiry() <= far, "Next expiry after the armed timer");
+
+    TEST_ASSERT_EQUAL(1, timer_mod(&timer, far + 5000000), "Re-arm lost pending state");
+    TEST_ASSERT_EQUAL(1, timer_del(&timer), "Cancel lost pending state");
+    TEST_ASSERT_EQUAL(0, timer_del(&timer), "Second cancel found the timer");
+    TEST_ASSERT(!timer_pending(&timer), "Cancelled timer pending");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Slack defers the expiry to a coarser boundary, never past the limit */
+static struct TestResult test_timer_slack(void) {
+    struct Timer timer;
+    uint64_t want = tick_get_ticks() + 1000 + 37;
+
+    timer_init(&timer, record_fire, &fire_ticks[0]);
+    timer_set_slack(&timer, 64);
+    timer_mod(&timer, want);
+
+    TEST_ASSERT(timer.expires >= want && timer.expires <= want + 64, "Expiry outside the slack");
+    TEST_ASSERT((timer.expires & 31) == 0, "Expiry not rounded to a coarse boundary");
+    timer_del(&timer);
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Timers fire from the tick, in order, including across idle sleeps */
+static struct TestResult test_timer_fires(void) {
+    struct Timer timers[3];
+    uint64_t now = tick_get_ticks();
+    uint64_t deadline = ktime_get_ns() + 200 * NSEC_PER_MSEC;
+    static const uint64_t delays[3] = { 2, 2, 5 };
+
+    if (!tick_get_hz()) {
+        return (struct TestResult){__func__, 1, NULL};
+    }
+
+    fire_count = 0;
+    for (int i = 0; i < 3; i++) {
+        timer_init(&timers[i], record_fire, &fire_ticks[i]);
+        timer_set_slack(&timers[i], 0);
+        timer_mod(&timers[i], now + delays[i]);
+    }
+
+    while (fire_count < 3 && ktime_get_ns() < deadline) {
+        tick_idle(0);
+    }
+    for (int i = 0; i < 3; i++) {
+        timer_del(&timers[i]);
+    }
+
+    TEST_ASSERT_EQUAL(3, fire_count, "Not every timer fired");
+    TEST_ASSERT(fire_ticks[0] >= now + 2 && fire_ticks[1] >= now + 2, "Timer fired early");
+    TEST_ASSERT(fire_ticks[2] >= now + 5, "Later timer fired early");
+    TEST_ASSERT(fire_ticks[2] >= fire_ticks[0], "Timers fired out of order");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Delays wait at least as long as asked, and not wildly longer */
+static struct TestResult test_udelay(void) {
+    uint64_t start = ktime_get_ns();
+    udelay(2000);
+    uint64_t elapsed = ktime_get_ns() - start;
+
+    /* Tick-based time only moves in PIT steps, so bounds need a free-running counter */
+    if (ktime_high_res()) {
+        TEST_ASSERT(elapsed >= 2 * NSEC_PER_MSEC, "udelay returned early");
+        TEST_ASSERT(elapsed < 20 * NSEC_PER_MSEC, "udelay overslept");
+    }
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* poll_until succeeds at once on a true condition and gives up on a false one */
+static struct TestResult test_poll_until(void) {
+    int polls = 0;
+
+    TEST_ASSERT_EQUAL(0, poll_until(++polls > 3, 1000), "Condition never met");
+    TEST_ASSERT_EQUAL(4, polls, "Polled after the condition held");
+
+    uint64_t start = ktime_get_ns();
+    TEST_ASSERT_EQUAL(-1, poll_until(0, 1000), "False condition succeeded");
+    if (ktime_high_res()) {
+        TEST_ASSERT(ktime_get_ns() - start >= NSEC_PER_MSEC, "Timed out early");
+    }
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Test suite definition */
+static TestFunction timer_tests[] = {
+    test_timer_mod_del,
+    test_timer_slack,
+    test_timer_fires,
+    test_udelay,
+    test_poll_until
+};
+
+struct TestSuite timer_test_suite = {
+    .name = "Kernel Timer Tests",
+    .tests = timer_tests,
+    .test_count = sizeof(timer_tests) / sizeof(TestFunction)
+};
@@ -0,0 +1,82 @@
+/**
+ * Static Tracepoint Tests
+ * NansOS Test Suite
+ * Copyright (c) 2025 NansStudios
+ */
+
+#include "test_framework.h"
+#include "../src/impl/kernel/tracepoint.h"
+
+DEFINE_TRACEPOINT(test_probe, "value=%llu extra=%llu");
+
+static __attribute__((noinline)) void probe(uint64_t value) {
+    tracepoint(test_probe, value, value * 2);
+}
+
+/* Registered tracepoints can be found by name and start disabled */
+static struct TestResult test_tracepoint_registry(void) {
+    struct Tracepoint* tp = tracepoint_find("test_probe");
+
+    TEST_ASSERT_NOT_NULL(tp, "Tracepoint not registered");
+    TEST_ASSERT(!static_key_enabled(&tp->key), "Tracepoint enabled by default");
+    TEST_ASSERT_EQUAL(-1, tracepoint_set("no_such_tracepoint", 1), "Unknown name accepted");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Enabling patches the site in; disabling patches it back out */
+static struct TestResult test_tracepoint_toggle(void) {
+    struct TracepointRecord records[4];
+
+    tracepoint_clear();
+    probe(1);
+    TEST_ASSERT_EQUAL(0, (int)tracepoint_snapshot(0, records, 4), "Disabled tracepoint recorded");
+
+    TEST_ASSERT_EQUAL(1, tracepoint_set("test_probe", 1), "Enable did not change state");
+    probe(7);
+    TEST_ASSERT_EQUAL(0, tracepoint_set("test_probe", 1), "Second enable changed state");
+    TEST_ASSERT_EQUAL(1, tracepoint_set("test_probe", 0), "Disable did not change state");
+    probe(9);
+
+    TEST_ASSERT_EQUAL(1, (int)tracepoint_snapshot(0, records, 4), "Expected exactly one record");
+    TEST_ASSERT(records[0].args[0] == 7 && records[0].args[1] == 14, "Wrong record arguments");
+    TEST_ASSERT(tracepoint_get(records[0].id) == tracepoint_find("test_probe"), "Wrong record id");
+
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* A full ring keeps the newest records */
+static struct TestResult test_tracepoint_overwrite(void) {
+    struct TracepointRecord last;
+    struct TracepointStats stats;
+
+    tracepoint_clear();
+    tracepoint_set("test_probe", 1);
+    for (uint64_t i = 0; i < TRACEPOINT_RING_SIZE + 10; i++) {
+        probe(i);
+    }
+    tracepoint_set("test_probe", 0);
+
+    tracepoint_get_stats(&stats);
+    TEST_ASSERT_EQUAL(10, (int)stats.overwritten, "Overwrites not counted");
+
+    /* A short snapshot holds the most recent records */
+    TEST_ASSERT_EQUAL(1, (int)tracepoint_snapshot(0, &last, 1), "Snapshot empty");
+    TEST_ASSERT(last.args[0] == TRACEPOINT_RING_SIZE + 9, "Newest record not kept");
+
+    tracepoint_clear();
+    return (struct TestResult){__func__, 1, NULL};
+}
+
+/* Test suite definition */
+static TestFunction tracepoint_tests[] = {
+    test_tracepoint_registry,
+    test_tracepoint_toggle,
+    test_tracepoint_overwrite
+};
+
+struct TestSuite tracepoint_test_suite = {
+    .name = "Tracepoint Tests",
+    .tests = tracepoint_tests,
+    .test_count = sizeof(tracepoint_tests) / sizeof(TestFunction)
+};
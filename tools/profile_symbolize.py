@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+"""
+NansOS Profile Symbolizer
+Copyright (c) 2025 NansStudios
+
+Extracts the folded stacks written by profile_dump() from a serial
+capture and replaces addresses with function names using addr2line.
+The output is the folded format flamegraph.pl and speedscope accept.
+
+    tools/profile_symbolize.py dist/x86_64/kernel.bin test_output/serial.log > kernel.folded
+    flamegraph.pl kernel.folded > kernel.svg
+"""
+
+import argparse
+import re
+import shutil
+import subprocess
+import sys
+from collections import Counter
+
+BEGIN = re.compile(rb"=== profile begin hz=(\d+) ===")
+END = b"=== profile end ==="
+STACK = re.compile(rb"^((?:0x[0-9a-f]+;)*0x[0-9a-f]+) (\d+)$")
+
+
+def find_addr2line(preferred):
+    for tool in ([preferred] if preferred else []) + ["x86_64-elf-addr2line", "addr2line"]:
+        if shutil.which(tool):
+            return tool
+    sys.exit("addr2line not found; pass --addr2line")
+
+
+def read_profiles(path):
+    """Return the stacks of the last complete dump as [(addresses, count)]."""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    dumps = []
+    current = None
+    for line in data.split(b"\n"):
+        line = line.rstrip(b"\r")
+        if BEGIN.search(line):
+            current = []
+        elif line.startswith(END) and current is not None:
+            dumps.append(current)
+            current = None
+        elif current is not None:
+            m = STACK.match(line)
+            if m:
+                addrs = [int(a, 16) for a in m.group(1).split(b";")]
+                current.append((addrs, int(m.group(2))))
+    if not dumps:
+        sys.exit(f"{path}: no complete profile dump found")
+    return dumps[-1]
+
+
+def symbolize(tool, kernel, addresses):
+    """Map each address to a function name with one addr2line run."""
+    query = "\n".join("0x%x" % a for a in addresses) + "\n"
+    out = subprocess.run([tool, "-f", "-s", "-e", kernel], input=query,
+                         capture_output=True, text=True, check=True).stdout.splitlines()
+    names = {}
+    for i, addr in enumerate(addresses):
+        name = out[2 * i] if 2 * i < len(out) else "??"
+        names[addr] = name if name != "??" else "0x%x" % addr
+    return names
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Symbolize NansOS profiler output")
+    parser.add_argument("kernel", help="kernel ELF with symbols")
+    parser.add_argument("log", help="serial capture containing a profile dump")
+    parser.add_argument("--addr2line", help="addr2line binary to use")
+    opts = parser.parse_args()
+
+    stacks = read_profiles(opts.log)
+    tool = find_addr2line(opts.addr2line)
+
+    # Folded lines are root first; only the last address is an interrupted
+    # RIP, the rest are return addresses, so look those up one byte back to
+    # land inside the call instruction.
+    lookups = set()
+    for addrs, _ in stacks:
+        lookups.update(a - 1 for a in addrs[:-1])
+        lookups.add(addrs[-1])
+    names = symbolize(tool, opts.kernel, sorted(lookups))
+
+    folded = Counter()
+    for addrs, count in stacks:
+        frames = [names[a - 1] for a in addrs[:-1]] + [names[addrs[-1]]]
+        folded[";".join(frames)] += count
+
+    for stack, count in folded.most_common():
+        print(stack, count)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""
+NansOS Trace Decoder
+Copyright (c) 2025 NansStudios
+
+Turns a serial capture containing binary trace frames (see
+src/impl/kernel/trace.h) back into text or Chrome trace JSON. Format
+strings are read from the .trace_fmt section of the kernel ELF.
+
+    tools/trace_decode.py dist/x86_64/kernel.bin test_output/serial.log
+    tools/trace_decode.py --chrome dist/x86_64/kernel.bin test_output/serial.log > trace.json
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+FRAME_MARKER = 0xFF
+ID_SYNC = 0xFFFF
+
+SPEC = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?(hh|h|ll|l|z)?([diuxXpc%])")
+
+
+def read_section(path, name):
+    """Return the contents of an ELF64 section, or b"" if it is absent."""
+    with open(path, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF" or elf[4] != 2:
+        sys.exit(f"{path}: not an ELF64 file")
+
+    shoff, = struct.unpack_from("<Q", elf, 0x28)
+    shentsize, shnum, shstrndx = struct.unpack_from("<HHH", elf, 0x3A)
+
+    def header(i):
+        # name, type, flags, addr, offset, size
+        return struct.unpack_from("<IIQQQQ", elf, shoff + i * shentsize)
+
+    strtab = header(shstrndx)
+    for i in range(shnum):
+        sh_name, _, _, _, offset, size = header(i)
+        start = strtab[4] + sh_name
+        if elf[start:elf.index(b"\0", start)].decode() == name:
+            return elf[offset:offset + size]
+    return b""
+
+
+def format_string(strings, event_id):
+    end = strings.find(b"\0", event_id)
+    if event_id >= len(strings) or end < 0:
+        return None
+    return strings[event_id:end].decode("ascii", "replace")
+
+
+def render(fmt, args):
+    """Apply a kernel printf format to 64-bit raw arguments."""
+    values = iter(args)
+
+    def convert(m):
+        flags, width, precision, _, conv = m.groups()
+        if conv == "%":
+            return "%"
+        value = next(values, 0)
+        if conv in "di":
+            value = value - (1 << 64) if value >> 63 else value
+        elif conv == "p":
+            return "0x%x" % value
+        elif conv == "c":
+            return chr(value & 0xFF)
+        spec = "%" + flags + width + ("." + precision if precision else "") + ("d" if conv == "u" else conv)
+        return spec % value
+
+    return SPEC.sub(convert, fmt)
+
+
+def read_uleb128(data, pos):
+    value = 0
+    shift = 0
+    while True:
+        if pos >= len(data):
+            raise IndexError
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, pos
+
+
+def decode(log, strings, tsc_hz):
+    """Yield ("text", line) and ("event", tsc, hz, id, fmt, args) in stream order."""
+    tsc = 0
+    text = bytearray()
+    pos = 0
+
+    while pos < len(log):
+        byte = log[pos]
+        if byte != FRAME_MARKER:
+            pos += 1
+            if byte == 0x0A:
+                yield ("text", text.decode("ascii", "replace").rstrip("\r"))
+                text.clear()
+            else:
+                text.append(byte)
+            continue
+
+        try:
+            event_id = log[pos + 1] | (log[pos + 2] << 8)
+            nargs = log[pos + 3]
+            delta, p = read_uleb128(log, pos + 4)
+            args = []
+            for _ in range(nargs):
+                value, p = read_uleb128(log, p)
+                args.append(value)
+        except IndexError:
+            break  # capture ends mid-frame
+        pos = p
+
+        if event_id == ID_SYNC and len(args) >= 2:
+            tsc = args[0]
+            if args[1] and not tsc_hz:
+                tsc_hz = args[1]
+            continue
+
+        tsc += delta
+        yield ("event", tsc, tsc_hz, event_id, format_string(strings, event_id), args)
+
+    if text:
+        yield ("text", text.decode("ascii", "replace"))
+
+
+def timestamp_us(tsc, hz):
+    return tsc * 1e6 / hz if hz else tsc / 1000.0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode NansOS binary trace frames")
+    parser.add_argument("kernel", help="kernel ELF with a .trace_fmt section")
+    parser.add_argument("log", help="raw serial capture, e.g. test_output/serial.log")
+    parser.add_argument("--chrome", action="store_true", help="emit Chrome trace JSON")
+    parser.add_argument("--tsc-hz", type=float, default=0,
+                        help="TSC rate when the kernel did not report one")
+    parser.add_argument("--events-only", action="store_true", help="drop ordinary text lines")
+    opts = parser.parse_args()
+
+    strings = read_section(opts.kernel, ".trace_fmt")
+    if not strings:
+        sys.exit(f"{opts.kernel}: no .trace_fmt section")
+    with open(opts.log, "rb") as f:
+        log = f.read()
+
+    records = decode(log, strings, opts.tsc_hz)
+
+    if opts.chrome:
+        events = []
+        last_ts = 0.0
+        for record in records:
+            if record[0] == "text":
+                if not opts.events_only and record[1]:
+                    events.append({"name": record[1], "cat": "text", "ph": "i", "s": "g",
+                                   "ts": last_ts, "pid": 0, "tid": 0})
+                continue
+            _, tsc, hz, event_id, fmt, args = record
+            last_ts = timestamp_us(tsc, hz)
+            message = render(fmt, args) if fmt else "unknown event %d" % event_id
+            events.append({"name": message.split(" ", 1)[0], "cat": "trace", "ph": "i", "s": "t",
+                           "ts": last_ts, "pid": 0, "tid": 0, "args": {"msg": message}})
+        json.dump({"traceEvents": events, "displayTimeUnit": "ns"}, sys.stdout, indent=1)
+        print()
+        return
+
+    for record in records:
+        if record[0] == "text":
+            if not opts.events_only:
+                print(record[1])
+            continue
+        _, tsc, hz, event_id, fmt, args = record
+        message = render(fmt, args) if fmt else "unknown event %d %r" % (event_id, args)
+        if hz:
+            print("<%12.6f> %s" % (tsc / hz, message))
+        else:
+            print("<%16d> %s" % (tsc, message))
+
+
+if __name__ == "__main__":
+    main()